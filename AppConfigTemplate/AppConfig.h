@@ -89,6 +89,37 @@
 #define VF_USE_LEAKCHECKED 1
 #endif
 
+/** Collect CallQueueMetrics for every CallQueue.
+
+    This adds a timestamp to each functor and a few atomic operations
+    to each call, so it is off by default.
+*/
+#ifndef VF_USE_CALLQUEUE_METRICS
+#define VF_USE_CALLQUEUE_METRICS 0
+#endif
+
+/** Record a Trace of CallQueue, ThreadGroup, ParallelFor and Listeners
+    activity, along with any VF_TRACE macros in your own code.
+*/
+#ifndef VF_USE_TRACE
+#define VF_USE_TRACE 0
+#endif
+
+/** Count acquisitions, contention and time blocked for the synchronization
+    primitives, and report them at exit. See ContentionProfiler.
+*/
+#ifndef VF_USE_CONTENTION_PROFILER
+#define VF_USE_CONTENTION_PROFILER 0
+#endif
+
+/** Report memory allocation and blocking calls made on threads marked as
+    real-time. This replaces the global operator new and operator delete.
+    See RealtimeChecker.
+*/
+#ifndef VF_USE_REALTIME_CHECKER
+#define VF_USE_REALTIME_CHECKER 0
+#endif
+
 /*============================================================================*/
 
 // Ignore this
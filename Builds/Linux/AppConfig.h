@@ -0,0 +1,63 @@
+/*============================================================================*/
+/*
+  VFLib: https://github.com/vinniefalco/VFLib
+
+  Copyright (C) 2008 by Vinnie Falco <vinnie.falco@gmail.com>
+
+  This library contains portions of other open source products covered by
+  separate licenses. Please see the corresponding source files for specific
+  terms.
+  
+  VFLib is provided under the terms of The MIT License (MIT):
+
+  Permission is hereby granted, free of charge, to any person obtaining a copy
+  of this software and associated documentation files (the "Software"), to deal
+  in the Software without restriction, including without limitation the rights
+  to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+  copies of the Software, and to permit persons to whom the Software is
+  furnished to do so, subject to the following conditions:
+
+  The above copyright notice and this permission notice shall be included in
+  all copies or substantial portions of the Software.
+
+  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+  FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+  IN THE SOFTWARE.
+*/
+/*============================================================================*/
+
+#ifndef VF_BENCHMARK_APPCONFIG_VFHEADER
+#define VF_BENCHMARK_APPCONFIG_VFHEADER
+
+/*============================================================================*/
+/**
+  Configuration for the Linux benchmark build.
+
+  VF_USE_BOOST is set by the Makefile.
+*/
+
+#define JUCE_MODULE_AVAILABLE_juce_core             1
+#define JUCE_MODULE_AVAILABLE_juce_data_structures  1
+#define JUCE_MODULE_AVAILABLE_juce_events           1
+#define JUCE_MODULE_AVAILABLE_juce_graphics         1
+#define JUCE_MODULE_AVAILABLE_juce_gui_basics       1
+
+#define JUCE_STANDALONE_APPLICATION 1
+
+#ifndef VF_USE_BOOST
+#define VF_USE_BOOST 0
+#endif
+
+#define VF_USE_BZIP2            0
+#define VF_USE_FREETYPE         0
+#define VF_USE_NATIVE_SQLITE    1
+#define VF_USE_LEAKCHECKED      0
+
+// Ignore this
+#define JUCE_CHECK_MEMORY_LEAKS 0
+
+#endif
@@ -0,0 +1,83 @@
+/*============================================================================*/
+/*
+  VFLib: https://github.com/vinniefalco/VFLib
+
+  Copyright (C) 2008 by Vinnie Falco <vinnie.falco@gmail.com>
+
+  This library contains portions of other open source products covered by
+  separate licenses. Please see the corresponding source files for specific
+  terms.
+  
+  VFLib is provided under the terms of The MIT License (MIT):
+
+  Permission is hereby granted, free of charge, to any person obtaining a copy
+  of this software and associated documentation files (the "Software"), to deal
+  in the Software without restriction, including without limitation the rights
+  to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+  copies of the Software, and to permit persons to whom the Software is
+  furnished to do so, subject to the following conditions:
+
+  The above copyright notice and this permission notice shall be included in
+  all copies or substantial portions of the Software.
+
+  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+  FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+  IN THE SOFTWARE.
+*/
+/*============================================================================*/
+
+/** Runs the vf_concurrent benchmark and writes the results.
+
+    Usage: concurrent_benchmark [output-name] [operations-per-thread]
+
+    The results are written to output-name.json and output-name.csv, and
+    the CSV is printed as well. The default name is "concurrent_benchmark".
+*/
+
+#include "AppConfig.h"
+
+#include "modules/vf_core/vf_core.h"
+#include "modules/vf_concurrent/vf_concurrent.h"
+
+#include <iostream>
+
+using namespace vf;
+
+int main (int argc, char** argv)
+{
+  String const name (argc > 1 ? argv [1] : "concurrent_benchmark");
+
+  Benchmark benchmark;
+
+  Benchmark::Options options;
+  options.payloadSizes.clear ();
+  options.payloadSizes.push_back (8);
+  options.payloadSizes.push_back (64);
+  options.payloadSizes.push_back (256);
+  options.pinThreads = true;
+
+  if (argc > 2)
+    options.operationsPerThread = jmax (1, String (argv [2]).getIntValue ());
+
+  benchmark.setOptions (options);
+
+  ConcurrentBenchmark::addAllCases (benchmark);
+
+  std::vector <Benchmark::Result> const results = benchmark.run ();
+
+  String const csv = Benchmark::toCSV (results);
+
+  File::getCurrentWorkingDirectory ().getChildFile (name + ".json")
+    .replaceWithText (Benchmark::toJSON (results));
+
+  File::getCurrentWorkingDirectory ().getChildFile (name + ".csv")
+    .replaceWithText (csv);
+
+  std::cout << csv.toUTF8 ();
+
+  return 0;
+}
@@ -0,0 +1,480 @@
+/*============================================================================*/
+/*
+  VFLib: https://github.com/vinniefalco/VFLib
+
+  Copyright (C) 2008 by Vinnie Falco <vinnie.falco@gmail.com>
+
+  This library contains portions of other open source products covered by
+  separate licenses. Please see the corresponding source files for specific
+  terms.
+  
+  VFLib is provided under the terms of The MIT License (MIT):
+
+  Permission is hereby granted, free of charge, to any person obtaining a copy
+  of this software and associated documentation files (the "Software"), to deal
+  in the Software without restriction, including without limitation the rights
+  to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+  copies of the Software, and to permit persons to whom the Software is
+  furnished to do so, subject to the following conditions:
+
+  The above copyright notice and this permission notice shall be included in
+  all copies or substantial portions of the Software.
+
+  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+  FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+  IN THE SOFTWARE.
+*/
+/*============================================================================*/
+
+// A functor which occupies a given number of bytes in a queue.
+template <int Bytes>
+struct ConcurrentBenchmark::Payload
+{
+  void operator() () const
+  {
+  }
+
+  char data [Bytes];
+};
+
+// Per thread state, padded to avoid false sharing.
+struct ConcurrentBenchmark::PerThread
+{
+  PerThread () : count (0)
+  {
+  }
+
+  int count;
+  char pad [64 - sizeof (int)];
+};
+
+//------------------------------------------------------------------------------
+
+class ConcurrentBenchmark::CallQueueCase : public Benchmark::Case
+{
+public:
+  String getName () const
+  {
+    return "CallQueue";
+  }
+
+  void prepare (Benchmark::Parameters const& parameters)
+  {
+    m_payloadBytes = parameters.payloadBytes;
+
+    m_thread = new ThreadWithCallQueue ("CallQueueCase");
+    m_thread->start ();
+  }
+
+  void operation (int)
+  {
+    if (m_payloadBytes <= 8)
+      m_thread->queuef (Payload <8> ());
+    else if (m_payloadBytes <= 64)
+      m_thread->queuef (Payload <64> ());
+    else if (m_payloadBytes <= 256)
+      m_thread->queuef (Payload <256> ());
+    else
+      m_thread->queuef (Payload <1024> ());
+  }
+
+  void finish ()
+  {
+    m_thread = nullptr;
+  }
+
+private:
+  int m_payloadBytes;
+  ScopedPointer <ThreadWithCallQueue> m_thread;
+};
+
+//------------------------------------------------------------------------------
+
+class ConcurrentBenchmark::LockFreeQueueCase : public Benchmark::Case
+{
+public:
+  String getName () const
+  {
+    return "LockFreeQueue";
+  }
+
+  void prepare (Benchmark::Parameters const& parameters)
+  {
+    m_numberOfThreads = parameters.numberOfThreads;
+    m_elements.allocate (m_numberOfThreads * elementsPerThread);
+    m_next.allocate (m_numberOfThreads);
+
+    m_consumer = new Consumer (m_queue);
+    m_consumer->startThread ();
+  }
+
+  void operation (int threadIndex)
+  {
+    int const index = m_next [threadIndex].count++ & (elementsPerThread - 1);
+
+    Element& element = m_elements [threadIndex * elementsPerThread + index];
+
+    // Wait for the consumer if the producer got a whole ring ahead.
+    while (element.busy.isSignaled ())
+      Thread::yield ();
+
+    element.busy.signal ();
+
+    m_queue.push_back (&element);
+  }
+
+  void finish ()
+  {
+    m_consumer = nullptr;
+    m_elements.free ();
+    m_next.free ();
+  }
+
+private:
+  enum
+  {
+    elementsPerThread = 1024
+  };
+
+  struct Element : LockFreeQueue <Element>::Node
+  {
+    AtomicFlag busy;
+  };
+
+  typedef LockFreeQueue <Element> Queue;
+
+  class Consumer : public Thread
+  {
+  public:
+    explicit Consumer (Queue& queue) : Thread ("LockFreeQueueCase"), m_queue (queue)
+    {
+    }
+
+    ~Consumer ()
+    {
+      stopThread (-1);
+    }
+
+    void run ()
+    {
+      for (;;)
+      {
+        Element* const element = m_queue.pop_front ();
+
+        if (element != nullptr)
+          element->busy.reset ();
+        else if (threadShouldExit ())
+          break;
+        else
+          Thread::yield ();
+      }
+    }
+
+  private:
+    Queue& m_queue;
+  };
+
+  template <class T>
+  class Array
+  {
+  public:
+    Array () : m_data (nullptr)
+    {
+    }
+
+    ~Array ()
+    {
+      free ();
+    }
+
+    void allocate (int size)
+    {
+      free ();
+      m_data = new T [size];
+    }
+
+    void free ()
+    {
+      delete [] m_data;
+      m_data = nullptr;
+    }
+
+    T& operator[] (int index)
+    {
+      return m_data [index];
+    }
+
+  private:
+    T* m_data;
+  };
+
+  int m_numberOfThreads;
+  Queue m_queue;
+  Array <Element> m_elements;
+  Array <PerThread> m_next;
+  ScopedPointer <Consumer> m_consumer;
+};
+
+//------------------------------------------------------------------------------
+
+class ConcurrentBenchmark::PagedFreeStoreCase : public Benchmark::Case
+{
+public:
+  String getName () const
+  {
+    return "PagedFreeStore";
+  }
+
+  void prepare (Benchmark::Parameters const& parameters)
+  {
+    m_store = new PagedFreeStore (jmax (parameters.payloadBytes, 64) + 64);
+  }
+
+  void operation (int)
+  {
+    PagedFreeStore::deallocate (m_store->allocate ());
+  }
+
+  void finish ()
+  {
+    m_store = nullptr;
+  }
+
+private:
+  ScopedPointer <PagedFreeStore> m_store;
+};
+
+//------------------------------------------------------------------------------
+
+template <class StoreType>
+class ConcurrentBenchmark::FifoFreeStoreCase : public Benchmark::Case
+{
+public:
+  explicit FifoFreeStoreCase (String const& name)
+    : m_name (name)
+    , m_payloadBytes (0)
+  {
+  }
+
+  String getName () const
+  {
+    return m_name;
+  }
+
+  void prepare (Benchmark::Parameters const& parameters)
+  {
+    m_payloadBytes = parameters.payloadBytes;
+    m_store = new StoreType;
+  }
+
+  void operation (int)
+  {
+    StoreType::deallocate (m_store->allocate (m_payloadBytes));
+  }
+
+  void finish ()
+  {
+    m_store = nullptr;
+  }
+
+private:
+  String const m_name;
+  int m_payloadBytes;
+  ScopedPointer <StoreType> m_store;
+};
+
+//------------------------------------------------------------------------------
+
+class ConcurrentBenchmark::ReadWriteMutexCase : public Benchmark::Case
+{
+public:
+  ReadWriteMutexCase () : m_value (0)
+  {
+  }
+
+  String getName () const
+  {
+    return "ReadWriteMutex";
+  }
+
+  void operation (int threadIndex)
+  {
+    if (threadIndex == 0 && (++m_writes.count & 15) == 0)
+    {
+      m_mutex.enterWrite ();
+      ++m_value;
+      m_mutex.exitWrite ();
+    }
+    else
+    {
+      m_mutex.enterRead ();
+      m_mutex.exitRead ();
+    }
+  }
+
+private:
+  ReadWriteMutex m_mutex;
+  PerThread m_writes;
+  int m_value;
+};
+
+//------------------------------------------------------------------------------
+
+class ConcurrentBenchmark::SemaphoreCase : public Benchmark::Case
+{
+public:
+  SemaphoreCase () : m_semaphore (0)
+  {
+  }
+
+  String getName () const
+  {
+    return "Semaphore";
+  }
+
+  void operation (int)
+  {
+    m_semaphore.signal ();
+    m_semaphore.wait ();
+  }
+
+private:
+  Semaphore m_semaphore;
+};
+
+//------------------------------------------------------------------------------
+
+class ConcurrentBenchmark::ParallelForCase : public Benchmark::Case
+{
+public:
+  String getName () const
+  {
+    return "ParallelFor";
+  }
+
+  bool isConcurrent () const
+  {
+    return false;
+  }
+
+  void prepare (Benchmark::Parameters const& parameters)
+  {
+    m_numberOfThreads = parameters.numberOfThreads;
+    m_payloadBytes = parameters.payloadBytes;
+    m_data.calloc (m_numberOfThreads * m_payloadBytes);
+
+    m_group = new ThreadGroup (m_numberOfThreads);
+    m_loop = new ParallelFor (*m_group);
+  }
+
+  void operation (int)
+  {
+    m_loop->loop (m_numberOfThreads, &ParallelForCase::iteration, this);
+  }
+
+  void finish ()
+  {
+    m_loop = nullptr;
+    m_group = nullptr;
+    m_data.free ();
+  }
+
+private:
+  void iteration (int loopIndex)
+  {
+    char* const data = m_data + loopIndex * m_payloadBytes;
+
+    for (int i = 0; i < m_payloadBytes; ++i)
+      ++data [i];
+  }
+
+  int m_numberOfThreads;
+  int m_payloadBytes;
+  HeapBlock <char> m_data;
+  ScopedPointer <ThreadGroup> m_group;
+  ScopedPointer <ParallelFor> m_loop;
+};
+
+//------------------------------------------------------------------------------
+
+class ConcurrentBenchmark::ListenersCase : public Benchmark::Case
+{
+public:
+  String getName () const
+  {
+    return "Listeners";
+  }
+
+  bool isConcurrent () const
+  {
+    return false;
+  }
+
+  void prepare (Benchmark::Parameters const& parameters)
+  {
+    for (int i = 0; i < parameters.numberOfThreads; ++i)
+    {
+      ThreadWithCallQueue* const thread = new ThreadWithCallQueue ("ListenersCase");
+      thread->start ();
+      m_threads.add (thread);
+
+      Listener* const listener = new Listener;
+      m_listenerObjects.add (listener);
+      m_listeners.add (listener, *thread);
+    }
+  }
+
+  void operation (int)
+  {
+    m_listeners.call (&Listener::onEvent, 1);
+  }
+
+  void finish ()
+  {
+    for (int i = 0; i < m_listenerObjects.size (); ++i)
+      m_listeners.remove (m_listenerObjects [i]);
+
+    m_threads.clear ();
+    m_listenerObjects.clear ();
+  }
+
+private:
+  struct Listener
+  {
+    Listener () : m_total (0)
+    {
+    }
+
+    void onEvent (int value)
+    {
+      m_total += value;
+    }
+
+    int m_total;
+  };
+
+  Listeners <Listener> m_listeners;
+  OwnedArray <ThreadWithCallQueue> m_threads;
+  OwnedArray <Listener> m_listenerObjects;
+};
+
+//------------------------------------------------------------------------------
+
+void ConcurrentBenchmark::addAllCases (Benchmark& benchmark)
+{
+  benchmark.add (new CallQueueCase);
+  benchmark.add (new LockFreeQueueCase);
+  benchmark.add (new PagedFreeStoreCase);
+#if VF_USE_BOOST
+  benchmark.add (new FifoFreeStoreCase <FifoFreeStoreWithTLS> ("FifoFreeStoreWithTLS"));
+#endif
+  benchmark.add (new FifoFreeStoreCase <FifoFreeStoreWithoutTLS> ("FifoFreeStoreWithoutTLS"));
+  benchmark.add (new ReadWriteMutexCase);
+  benchmark.add (new SemaphoreCase);
+  benchmark.add (new ParallelForCase);
+  benchmark.add (new ListenersCase);
+}
@@ -0,0 +1,110 @@
+/*============================================================================*/
+/*
+  VFLib: https://github.com/vinniefalco/VFLib
+
+  Copyright (C) 2008 by Vinnie Falco <vinnie.falco@gmail.com>
+
+  This library contains portions of other open source products covered by
+  separate licenses. Please see the corresponding source files for specific
+  terms.
+  
+  VFLib is provided under the terms of The MIT License (MIT):
+
+  Permission is hereby granted, free of charge, to any person obtaining a copy
+  of this software and associated documentation files (the "Software"), to deal
+  in the Software without restriction, including without limitation the rights
+  to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+  copies of the Software, and to permit persons to whom the Software is
+  furnished to do so, subject to the following conditions:
+
+  The above copyright notice and this permission notice shall be included in
+  all copies or substantial portions of the Software.
+
+  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+  FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+  IN THE SOFTWARE.
+*/
+/*============================================================================*/
+
+#ifndef VF_CONCURRENTBENCHMARK_VFHEADER
+#define VF_CONCURRENTBENCHMARK_VFHEADER
+
+/*============================================================================*/
+/**
+  Benchmark cases for the concurrency primitives.
+
+  This adds a Benchmark::Case for each of the primitives in vf_concurrent,
+  so that changes to them can be measured and regressions caught. A host
+  program only needs to run the benchmark and save the results:
+
+  @code
+
+  int main (int argc, char** argv)
+  {
+    Benchmark benchmark;
+
+    Benchmark::Options options;
+    options.payloadSizes.push_back (64);
+    options.payloadSizes.push_back (256);
+    options.pinThreads = true;
+    benchmark.setOptions (options);
+
+    ConcurrentBenchmark::addAllCases (benchmark);
+
+    File ("results.json").replaceWithText (Benchmark::toJSON (benchmark.run ()));
+
+    return 0;
+  }
+
+  @endcode
+
+  The cases are:
+
+  - CallQueue: posting a functor of the payload size to a ThreadWithCallQueue.
+  - LockFreeQueue: pushing onto a queue drained by a separate consumer.
+  - PagedFreeStore: allocating and freeing a page. This exercises the
+    LockFreeStack in the way it is designed to be used, with the free
+    store protecting against the ABA problem.
+  - FifoFreeStoreWithTLS and FifoFreeStoreWithoutTLS: allocating and
+    freeing a block of the payload size. The version with thread local
+    storage is only measured when VF_USE_BOOST is set.
+  - ReadWriteMutex: shared locks, with one exclusive lock in sixteen on the
+    first thread.
+  - Semaphore: a signal followed by a wait.
+  - ParallelFor: a loop with one iteration per thread, each touching the
+    payload size in bytes.
+  - Listeners: a call fanned out to one listener per thread, each on its own
+    ThreadWithCallQueue.
+
+  Payload sizes for functors are rounded up to 8, 64, 256 or 1024 bytes.
+
+  @ingroup vf_concurrent
+*/
+class ConcurrentBenchmark
+{
+public:
+  /** Add every case to a benchmark.
+  */
+  static void addAllCases (Benchmark& benchmark);
+
+private:
+  template <int Bytes>
+  struct Payload;
+  struct PerThread;
+
+  class CallQueueCase;
+  class LockFreeQueueCase;
+  class PagedFreeStoreCase;
+  template <class StoreType>
+  class FifoFreeStoreCase;
+  class ReadWriteMutexCase;
+  class SemaphoreCase;
+  class ParallelForCase;
+  class ListenersCase;
+};
+
+#endif
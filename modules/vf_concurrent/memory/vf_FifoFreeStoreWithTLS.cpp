@@ -71,7 +71,7 @@ public:
 
   inline bool release ()
   {
-    jassert (! m_refs.isSignaled ());
+    jassert (m_refs.isSignaled ());
 
     return m_refs.release ();
   }
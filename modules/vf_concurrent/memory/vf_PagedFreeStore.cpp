@@ -103,12 +103,12 @@ PagedFreeStore::PagedFreeStore (const size_t pageBytes)
   m_hot  = m_pool1;
   m_cold = m_pool2;
 
-  startOncePerSecond ();
+  startPeriodicTimer (1000);
 }
 
 PagedFreeStore::~PagedFreeStore ()
 {
-  endOncePerSecond ();
+  stopTimer ();
 
 #if LOG_GC
   jassert (!m_used.isSignaled ());
@@ -171,7 +171,12 @@ void PagedFreeStore::deallocate (void* const p)
 //
 // Perform garbage collection.
 //
-void PagedFreeStore::doOncePerSecond ()
+void PagedFreeStore::setGarbageCollectionInterval (int milliseconds)
+{
+  startPeriodicTimer (milliseconds);
+}
+
+void PagedFreeStore::timerExpired ()
 {
   // Physically free one page.
   // This will reduce the working set over time after a spike.
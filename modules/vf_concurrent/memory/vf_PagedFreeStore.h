@@ -39,10 +39,11 @@
 
   The ABA problem (http://en.wikipedia.org/wiki/ABA_problem) is avoided by
   treating freed pages as garbage, and performing a collection every second.
+  Collections are driven by the TimerWheel.
 
   @ingroup vf_concurrent
 */
-class PagedFreeStore : private OncePerSecond
+class PagedFreeStore : private TimerWheel::Timer
 {
 public:
   explicit PagedFreeStore (const size_t pageBytes);
@@ -67,9 +68,17 @@ public:
   void* allocate ();
   static void deallocate (void* const p);
 
+  /** Change the time between garbage collections.
+
+      A page is only reused after two collections, so shorter intervals
+      return memory sooner but reduce the margin against the ABA problem.
+      The default is one second.
+  */
+  void setGarbageCollectionInterval (int milliseconds);
+
 private:
   void* newPage ();
-  void doOncePerSecond ();
+  void timerExpired ();
 
 private:
   struct Page;
@@ -32,6 +32,14 @@
 
 CallQueue::CallQueue (String name)
   : m_name (name)
+  , m_queueSite ("CallQueue (" + name + ")")
+  , m_queue (m_queueSite)
+#if VF_USE_CALLQUEUE_METRICS
+  , m_metrics (name)
+#endif
+#if VF_USE_TRACE
+  , m_traceName (Trace::intern (name))
+#endif
 {
 }
 
@@ -57,6 +65,20 @@ void CallQueue::queuep (Work* c)
   // process it.
   jassert (!m_closed.isSignaled ());
 
+  VF_TRACE_SCOPE ("CallQueue::queue");
+
+#if VF_USE_TRACE
+  c->m_flowId = Trace::createFlowId ();
+#endif
+
+  VF_TRACE_FLOW_START (m_traceName, c->m_flowId);
+
+#if VF_USE_CALLQUEUE_METRICS
+  c->m_queuedTicks = CpuTicks::getTicks ();
+
+  m_metrics.onQueued ();
+#endif
+
   if (m_queue.push_back (c))
     signal ();
 }
@@ -131,12 +153,19 @@ bool CallQueue::doSynchronize ()
 {
   bool did_something;
 
+  VF_TRACE_SCOPE ("CallQueue::synchronize");
+
   // Reset since we are emptying the queue. Since we loop
   // until the queue is empty, it is possible for us to exit
   // this function with an empty queue and signaled state.
   //
   reset ();
 
+#if VF_USE_CALLQUEUE_METRICS
+  int64 const startTicks = CpuTicks::getTicks ();
+  int numberOfCalls = 0;
+#endif
+
   Work* call = m_queue.pop_front ();
 
   if (call)
@@ -148,13 +177,28 @@ bool CallQueue::doSynchronize ()
     //
     for (;;)
     {
-      call->operator() ();
+#if VF_USE_CALLQUEUE_METRICS
+      m_metrics.onCalled (CpuTicks::getTicks () - call->m_queuedTicks);
+      ++numberOfCalls;
+#endif
+
+      {
+        VF_TRACE_SCOPE (m_traceName);
+        VF_TRACE_FLOW_END (m_traceName, call->m_flowId);
+
+        call->operator() ();
+      }
+
       delete call;
 
       call = m_queue.pop_front ();
       if (call == 0)
         break;
     }
+
+#if VF_USE_CALLQUEUE_METRICS
+    m_metrics.onSynchronized (numberOfCalls, CpuTicks::getTicks () - startTicks);
+#endif
   }
   else
   {
@@ -140,7 +140,8 @@
   producers and mostly wait-free for consumers. It also uses a lock-free
   and wait-free (in the fast path) custom memory allocator.
 
-  @see GuiCallQueue, ManualCallQueue, MessageThread, ThreadWithCallQueue
+  @see GuiCallQueue, ManualCallQueue, MessageThread, ThreadWithCallQueue,
+       CallQueueMetrics
 
   @ingroup vf_concurrent
 */
@@ -171,6 +172,19 @@ public:
         This executes during the queue's call to synchronize().
     */
     virtual void operator() () = 0;
+
+#if VF_USE_CALLQUEUE_METRICS || VF_USE_TRACE
+  private:
+    friend class CallQueue;
+#endif
+
+#if VF_USE_CALLQUEUE_METRICS
+    int64 m_queuedTicks;
+#endif
+
+#if VF_USE_TRACE
+    int64 m_flowId;
+#endif
   };
 
   //============================================================================
@@ -504,10 +518,17 @@ private:
 private:
   String const m_name;
   Thread::ThreadID m_id;
+  ContentionProfiler::Site m_queueSite;
   LockFreeQueue <Work> m_queue;
   AtomicFlag m_closed;
   AtomicFlag m_isBeingSynchronized;
   AllocatorType m_allocator;
+#if VF_USE_CALLQUEUE_METRICS
+  CallQueueMetrics m_metrics;
+#endif
+#if VF_USE_TRACE
+  char const* const m_traceName;
+#endif
 };
 
 #endif
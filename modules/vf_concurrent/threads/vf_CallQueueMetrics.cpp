@@ -0,0 +1,270 @@
+/*============================================================================*/
+/*
+  VFLib: https://github.com/vinniefalco/VFLib
+
+  Copyright (C) 2008 by Vinnie Falco <vinnie.falco@gmail.com>
+
+  This library contains portions of other open source products covered by
+  separate licenses. Please see the corresponding source files for specific
+  terms.
+  
+  VFLib is provided under the terms of The MIT License (MIT):
+
+  Permission is hereby granted, free of charge, to any person obtaining a copy
+  of this software and associated documentation files (the "Software"), to deal
+  in the Software without restriction, including without limitation the rights
+  to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+  copies of the Software, and to permit persons to whom the Software is
+  furnished to do so, subject to the following conditions:
+
+  The above copyright notice and this permission notice shall be included in
+  all copies or substantial portions of the Software.
+
+  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+  FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+  IN THE SOFTWARE.
+*/
+/*============================================================================*/
+
+// Holds every live CallQueueMetrics.
+//
+class CallQueueMetrics::Registry : public RefCountedSingleton <Registry>
+{
+public:
+  Registry ()
+    : RefCountedSingleton <Registry> (SingletonLifetime::persistAfterCreation)
+  {
+  }
+
+  ~Registry ()
+  {
+    jassert (m_metrics.size () == 0);
+  }
+
+  void add (CallQueueMetrics* metrics)
+  {
+    CriticalSection::ScopedLockType lock (m_mutex);
+
+    m_metrics.add (metrics);
+  }
+
+  void remove (CallQueueMetrics* metrics)
+  {
+    CriticalSection::ScopedLockType lock (m_mutex);
+
+    m_metrics.removeFirstMatchingValue (metrics);
+  }
+
+  void getSnapshots (std::vector <Snapshot>& snapshots)
+  {
+    typedef std::map <String, Snapshot> Map;
+
+    // The first use of CpuTicks calibrates the clock,
+    // which takes a while, so get it out of the way
+    // before taking the lock.
+    //
+    double const nanosecondsPerTick = CpuTicks::ticksToNanoseconds (1);
+
+    Map map;
+
+    {
+      CriticalSection::ScopedLockType lock (m_mutex);
+
+      for (int i = 0; i < m_metrics.size (); ++i)
+      {
+        CallQueueMetrics const* const metrics = m_metrics [i];
+
+        Snapshot& snapshot = map [metrics->m_name];
+
+        snapshot.name = metrics->m_name;
+
+        metrics->addTo (snapshot);
+      }
+    }
+
+    snapshots.clear ();
+    snapshots.reserve (map.size ());
+
+    for (Map::const_iterator iter = map.begin (); iter != map.end (); ++iter)
+    {
+      snapshots.push_back (iter->second);
+      snapshots.back ().nanosecondsPerTick = nanosecondsPerTick;
+    }
+  }
+
+  void resetAll ()
+  {
+    CriticalSection::ScopedLockType lock (m_mutex);
+
+    for (int i = 0; i < m_metrics.size (); ++i)
+      m_metrics [i]->reset ();
+  }
+
+  static Registry* createInstance ()
+  {
+    return new Registry;
+  }
+
+private:
+  CriticalSection m_mutex;
+  Array <CallQueueMetrics*> m_metrics;
+};
+
+//------------------------------------------------------------------------------
+
+CallQueueMetrics::Snapshot::Snapshot ()
+  : numberOfQueues (0)
+  , depth (0)
+  , highWaterDepth (0)
+  , numberOfCalls (0)
+  , numberOfSynchronizes (0)
+  , maxCallsPerSynchronize (0)
+  , secondsInSynchronize (0)
+  , nanosecondsPerTick (0)
+{
+  for (int i = 0; i < numberOfBuckets; ++i)
+    latency [i] = 0;
+}
+
+double CallQueueMetrics::Snapshot::getAverageCallsPerSynchronize () const
+{
+  return numberOfSynchronizes > 0 ? double (numberOfCalls) / numberOfSynchronizes : 0;
+}
+
+double CallQueueMetrics::Snapshot::getLatencyPercentile (double fraction) const
+{
+  int64 total = 0;
+
+  for (int i = 0; i < numberOfBuckets; ++i)
+    total += latency [i];
+
+  if (total == 0)
+    return 0;
+
+  int64 const target = jmax (int64 (1), int64 (fraction * total + 0.5));
+
+  int64 count = 0;
+  int bucket = 0;
+
+  for (; bucket < numberOfBuckets - 1; ++bucket)
+  {
+    count += latency [bucket];
+
+    if (count >= target)
+      break;
+  }
+
+  return double (int64 (2) << bucket) * nanosecondsPerTick;
+}
+
+//------------------------------------------------------------------------------
+
+CallQueueMetrics::CallQueueMetrics (String name)
+  : m_name (name)
+  , m_registry (Registry::getInstance ())
+{
+  m_registry->add (this);
+}
+
+CallQueueMetrics::~CallQueueMetrics ()
+{
+  m_registry->remove (this);
+}
+
+void CallQueueMetrics::onQueued ()
+{
+  int const depth = ++m_depth;
+
+  for (;;)
+  {
+    int const highWaterDepth = m_highWaterDepth.get ();
+
+    if (depth <= highWaterDepth ||
+        m_highWaterDepth.compareAndSetBool (depth, highWaterDepth))
+      break;
+  }
+}
+
+void CallQueueMetrics::onCalled (int64 latencyTicks)
+{
+  --m_depth;
+
+  ++m_numberOfCalls;
+
+  ++m_latency [getBucket (latencyTicks)];
+}
+
+void CallQueueMetrics::onSynchronized (int numberOfCalls, int64 elapsedTicks)
+{
+  ++m_numberOfSynchronizes;
+
+  // Only the synchronizing thread raises this,
+  // so there is no need for a compare and swap.
+  //
+  if (numberOfCalls > m_maxCallsPerSynchronize.get ())
+    m_maxCallsPerSynchronize.set (numberOfCalls);
+
+  m_ticksInSynchronize += elapsedTicks;
+}
+
+void CallQueueMetrics::reset ()
+{
+  m_highWaterDepth.set (m_depth.get ());
+  m_numberOfCalls.set (0);
+  m_numberOfSynchronizes.set (0);
+  m_maxCallsPerSynchronize.set (0);
+  m_ticksInSynchronize.set (0);
+
+  for (int i = 0; i < numberOfBuckets; ++i)
+    m_latency [i].set (0);
+}
+
+void CallQueueMetrics::getSnapshots (std::vector <Snapshot>& snapshots)
+{
+  Registry::getInstance ()->getSnapshots (snapshots);
+}
+
+void CallQueueMetrics::resetAll ()
+{
+  Registry::getInstance ()->resetAll ();
+}
+
+// Returns the index of the highest set bit, clamped to the histogram.
+//
+int CallQueueMetrics::getBucket (int64 ticks)
+{
+  // Ticks can appear to go backwards when the
+  // queueing thread ran on a different processor.
+  //
+  uint64 value = uint64 (jmax (int64 (1), ticks));
+
+  int bucket = 0;
+
+  if (value >= (uint64 (1) << 32)) { value >>= 32; bucket += 32; }
+  if (value >= (uint64 (1) << 16)) { value >>= 16; bucket += 16; }
+  if (value >= (uint64 (1) <<  8)) { value >>=  8; bucket +=  8; }
+  if (value >= (uint64 (1) <<  4)) { value >>=  4; bucket +=  4; }
+  if (value >= (uint64 (1) <<  2)) { value >>=  2; bucket +=  2; }
+  if (value >= (uint64 (1) <<  1)) {               bucket +=  1; }
+
+  return jmin (bucket, int (numberOfBuckets) - 1);
+}
+
+void CallQueueMetrics::addTo (Snapshot& snapshot) const
+{
+  ++snapshot.numberOfQueues;
+
+  snapshot.depth += m_depth.get ();
+  snapshot.highWaterDepth = jmax (snapshot.highWaterDepth, m_highWaterDepth.get ());
+  snapshot.numberOfCalls += m_numberOfCalls.get ();
+  snapshot.numberOfSynchronizes += m_numberOfSynchronizes.get ();
+  snapshot.maxCallsPerSynchronize = jmax (snapshot.maxCallsPerSynchronize, m_maxCallsPerSynchronize.get ());
+  snapshot.secondsInSynchronize += CpuTicks::ticksToSeconds (m_ticksInSynchronize.get ());
+
+  for (int i = 0; i < numberOfBuckets; ++i)
+    snapshot.latency [i] += m_latency [i].get ();
+}
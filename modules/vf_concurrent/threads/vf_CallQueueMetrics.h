@@ -0,0 +1,231 @@
+/*============================================================================*/
+/*
+  VFLib: https://github.com/vinniefalco/VFLib
+
+  Copyright (C) 2008 by Vinnie Falco <vinnie.falco@gmail.com>
+
+  This library contains portions of other open source products covered by
+  separate licenses. Please see the corresponding source files for specific
+  terms.
+  
+  VFLib is provided under the terms of The MIT License (MIT):
+
+  Permission is hereby granted, free of charge, to any person obtaining a copy
+  of this software and associated documentation files (the "Software"), to deal
+  in the Software without restriction, including without limitation the rights
+  to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+  copies of the Software, and to permit persons to whom the Software is
+  furnished to do so, subject to the following conditions:
+
+  The above copyright notice and this permission notice shall be included in
+  all copies or substantial portions of the Software.
+
+  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+  FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+  IN THE SOFTWARE.
+*/
+/*============================================================================*/
+
+#ifndef VF_CALLQUEUEMETRICS_VFHEADER
+#define VF_CALLQUEUEMETRICS_VFHEADER
+
+/*============================================================================*/
+/**
+  Latency and depth measurements for a CallQueue.
+
+  When VF_USE_CALLQUEUE_METRICS is set to 1 in AppConfig.h, every CallQueue
+  keeps one of these and records:
+
+  - The latency of each functor, from the time it was queued to the time it
+    started executing, as a histogram with power of two buckets.
+
+  - The depth of the queue, which is the number of functors queued but not
+    yet started, and the highest depth seen.
+
+  - The number of functors executed by each call to synchronize(), and the
+    total time spent in synchronize().
+
+  Timestamps come from CpuTicks, so recording costs a few atomic operations
+  per functor and no system calls.
+
+  Every CallQueueMetrics adds itself to a registry keyed by the name which
+  was passed to the CallQueue constructor. A monitoring thread enumerates
+  the registry by taking a snapshot:
+
+  @code
+
+  void MonitorThread::run ()
+  {
+    while (! threadShouldExit ())
+    {
+      std::vector <CallQueueMetrics::Snapshot> snapshots;
+
+      CallQueueMetrics::getSnapshots (snapshots);
+
+      for (std::size_t i = 0; i < snapshots.size (); ++i)
+      {
+        CallQueueMetrics::Snapshot const& s = snapshots [i];
+
+        Logger::outputDebugString (s.name +
+          " depth=" + String (s.highWaterDepth) +
+          " p99=" + String (s.getLatencyPercentile (0.99)) + "ns");
+      }
+
+      CallQueueMetrics::resetAll ();
+
+      wait (1000);
+    }
+  }
+
+  @endcode
+
+  Queues which share a name are combined into a single snapshot.
+
+  Counters are updated without a lock, so a snapshot taken while the queue is
+  busy is only approximately consistent. For example, the depth may briefly
+  disagree with the number of calls.
+
+  @ingroup vf_concurrent
+*/
+class CallQueueMetrics : Uncopyable
+{
+public:
+  enum
+  {
+    /** The number of latency histogram buckets.
+
+        Bucket zero holds latencies under two ticks, and bucket N holds
+        latencies from 2^N up to 2^(N+1) ticks.
+    */
+    numberOfBuckets = 48
+  };
+
+  //============================================================================
+  /**
+    A copy of the metrics for all queues with the same name.
+  */
+  struct Snapshot
+  {
+    Snapshot ();
+
+    /** The name of the queues. */
+    String name;
+
+    /** The number of queues with this name. */
+    int numberOfQueues;
+
+    /** The number of functors queued but not yet started. */
+    int depth;
+
+    /** The highest depth of any one queue since the last reset. */
+    int highWaterDepth;
+
+    /** The number of functors executed. */
+    int64 numberOfCalls;
+
+    /** The number of calls to synchronize() which executed functors. */
+    int64 numberOfSynchronizes;
+
+    /** The most functors executed by one call to synchronize(). */
+    int64 maxCallsPerSynchronize;
+
+    /** The total time spent in synchronize(). */
+    double secondsInSynchronize;
+
+    /** The latency histogram, in CpuTicks. */
+    int64 latency [numberOfBuckets];
+
+    /** The length of a tick. */
+    double nanosecondsPerTick;
+
+    /** Calculate the average number of functors per synchronize(). */
+    double getAverageCallsPerSynchronize () const;
+
+    /** Estimate a latency percentile from the histogram.
+
+        The result is the upper bound of the bucket containing the
+        percentile, so it errs on the high side by up to a factor of two.
+
+        @param fraction The percentile as a fraction, from zero to one.
+
+        @return The latency in nanoseconds, or zero if nothing was recorded.
+    */
+    double getLatencyPercentile (double fraction) const;
+  };
+
+  //============================================================================
+
+  /** Create metrics and add them to the registry.
+
+      @param name The name of the CallQueue.
+  */
+  explicit CallQueueMetrics (String name);
+
+  /** Destroy the metrics and remove them from the registry.
+  */
+  ~CallQueueMetrics ();
+
+  /** Called when a functor is queued.
+  */
+  void onQueued ();
+
+  /** Called when a functor starts executing.
+
+      This must only be called from the thread synchronizing the queue.
+
+      @param latencyTicks The time since the functor was queued.
+  */
+  void onCalled (int64 latencyTicks);
+
+  /** Called when synchronize() executed at least one functor.
+
+      This must only be called from the thread synchronizing the queue.
+
+      @param numberOfCalls The number of functors executed.
+      @param elapsedTicks  The time spent in synchronize().
+  */
+  void onSynchronized (int numberOfCalls, int64 elapsedTicks);
+
+  /** Reset the counters.
+
+      The depth is kept, and becomes the new high water mark.
+  */
+  void reset ();
+
+  /** Take a snapshot of every queue in the registry.
+
+      Snapshots are sorted by name. This may be called from any thread.
+
+      @param snapshots The vector to fill. Previous contents are discarded.
+  */
+  static void getSnapshots (std::vector <Snapshot>& snapshots);
+
+  /** Reset the counters of every queue in the registry.
+  */
+  static void resetAll ();
+
+private:
+  class Registry;
+
+  static int getBucket (int64 ticks);
+
+  void addTo (Snapshot& snapshot) const;
+
+private:
+  String const m_name;
+  ReferenceCountedObjectPtr <Registry> m_registry;
+
+  Atomic <int> m_depth;
+  Atomic <int> m_highWaterDepth;
+  Atomic <int64> m_numberOfCalls;
+  Atomic <int64> m_numberOfSynchronizes;
+  Atomic <int64> m_maxCallsPerSynchronize;
+  Atomic <int64> m_ticksInSynchronize;
+  Atomic <int64> m_latency [numberOfBuckets];
+};
+
+#endif
@@ -0,0 +1,156 @@
+/*============================================================================*/
+/*
+  VFLib: https://github.com/vinniefalco/VFLib
+
+  Copyright (C) 2008 by Vinnie Falco <vinnie.falco@gmail.com>
+
+  This library contains portions of other open source products covered by
+  separate licenses. Please see the corresponding source files for specific
+  terms.
+  
+  VFLib is provided under the terms of The MIT License (MIT):
+
+  Permission is hereby granted, free of charge, to any person obtaining a copy
+  of this software and associated documentation files (the "Software"), to deal
+  in the Software without restriction, including without limitation the rights
+  to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+  copies of the Software, and to permit persons to whom the Software is
+  furnished to do so, subject to the following conditions:
+
+  The above copyright notice and this permission notice shall be included in
+  all copies or substantial portions of the Software.
+
+  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+  FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+  IN THE SOFTWARE.
+*/
+/*============================================================================*/
+
+// Expirations hold a reference to the target, so the CallQueueTimer
+// can be destroyed while one of them is still in the queue.
+//
+class CallQueueTimer::Target
+  : public ReferenceCountedObject
+  , public TimerWheel::Timer
+{
+public:
+  typedef ReferenceCountedObjectPtr <Target> Ptr;
+
+  explicit Target (CallQueue& queue)
+    : m_queue (queue)
+    , m_generation (0)
+    , m_periodic (false)
+    , m_active (false)
+  {
+  }
+
+  ~Target ()
+  {
+    stopTimer ();
+  }
+
+  void start (int milliseconds, Function <void (void)> const& f, bool periodic)
+  {
+    CriticalSection::ScopedLockType lock (m_mutex);
+
+    ++m_generation;
+    m_f = f;
+    m_periodic = periodic;
+    m_active = true;
+
+    if (periodic)
+      startPeriodicTimer (milliseconds);
+    else
+      startOneShotTimer (milliseconds);
+  }
+
+  void stop ()
+  {
+    CriticalSection::ScopedLockType lock (m_mutex);
+
+    ++m_generation;
+    m_f = Function <void (void)> ();
+    m_active = false;
+
+    stopTimer ();
+  }
+
+  bool isActive () const
+  {
+    CriticalSection::ScopedLockType lock (m_mutex);
+
+    return m_active;
+  }
+
+private:
+  void timerExpired ()
+  {
+    // This runs with the wheel locked, and start() locks the wheel
+    // while holding m_mutex, so the generation is read atomically.
+    m_queue.queue (&Target::deliver, Ptr (this), m_generation.get ());
+  }
+
+  void deliver (int generation)
+  {
+    Function <void (void)> f;
+
+    {
+      CriticalSection::ScopedLockType lock (m_mutex);
+
+      // Discard expirations from before a stop or restart.
+      if (generation != m_generation.get ())
+        return;
+
+      if (! m_periodic)
+        m_active = false;
+
+      f = m_f;
+    }
+
+    f ();
+  }
+
+private:
+  CallQueue& m_queue;
+  CriticalSection m_mutex;
+  Atomic <int> m_generation;
+  bool m_periodic;
+  bool m_active;
+  Function <void (void)> m_f;
+};
+
+//------------------------------------------------------------------------------
+
+CallQueueTimer::CallQueueTimer (CallQueue& queue)
+  : m_target (new Target (queue))
+{
+}
+
+CallQueueTimer::~CallQueueTimer ()
+{
+  m_target->stop ();
+}
+
+void CallQueueTimer::startOneShot (int milliseconds, Function <void (void)> f)
+{
+  m_target->start (milliseconds, f, false);
+}
+
+void CallQueueTimer::startPeriodic (int milliseconds, Function <void (void)> f)
+{
+  m_target->start (milliseconds, f, true);
+}
+
+void CallQueueTimer::stop ()
+{
+  m_target->stop ();
+}
+
+bool CallQueueTimer::isActive () const
+{
+  return m_target->isActive ();
+}
@@ -0,0 +1,93 @@
+/*============================================================================*/
+/*
+  VFLib: https://github.com/vinniefalco/VFLib
+
+  Copyright (C) 2008 by Vinnie Falco <vinnie.falco@gmail.com>
+
+  This library contains portions of other open source products covered by
+  separate licenses. Please see the corresponding source files for specific
+  terms.
+  
+  VFLib is provided under the terms of The MIT License (MIT):
+
+  Permission is hereby granted, free of charge, to any person obtaining a copy
+  of this software and associated documentation files (the "Software"), to deal
+  in the Software without restriction, including without limitation the rights
+  to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+  copies of the Software, and to permit persons to whom the Software is
+  furnished to do so, subject to the following conditions:
+
+  The above copyright notice and this permission notice shall be included in
+  all copies or substantial portions of the Software.
+
+  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+  FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+  IN THE SOFTWARE.
+*/
+/*============================================================================*/
+
+#ifndef VF_CALLQUEUETIMER_VFHEADER
+#define VF_CALLQUEUETIMER_VFHEADER
+
+/*============================================================================*/
+/**
+  A timer whose expirations are delivered through a CallQueue.
+
+  TimerWheel calls timerExpired() on its own thread. This adapter queues a
+  functor on a CallQueue instead, so the callback runs on the thread which
+  synchronizes the queue, with no locking needed in the caller:
+
+  @code
+
+  CallQueueTimer m_poll (m_ioThread);
+
+  m_poll.startPeriodic (100, vf::bind (&Device::poll, this));
+
+  @endcode
+
+  Stopping or restarting the timer discards expirations which were queued
+  but not yet called, so the functor is never called after stop() returns
+  if stop() is called from the thread which synchronizes the queue.
+
+  @see TimerWheel
+
+  @ingroup vf_concurrent
+*/
+class CallQueueTimer : Uncopyable
+{
+public:
+  /** Create a timer which delivers to the specified queue.
+  */
+  explicit CallQueueTimer (CallQueue& queue);
+
+  ~CallQueueTimer ();
+
+  /** Start or restart the timer so that it calls the functor once.
+  */
+  void startOneShot (int milliseconds, Function <void (void)> f);
+
+  /** Start or restart the timer so that it calls the functor repeatedly.
+  */
+  void startPeriodic (int milliseconds, Function <void (void)> f);
+
+  /** Stop the timer.
+  */
+  void stop ();
+
+  /** Determine if the timer is running.
+
+      A one shot timer is running until its functor is called.
+  */
+  bool isActive () const;
+
+private:
+  class Target;
+
+  ReferenceCountedObjectPtr <Target> m_target;
+};
+
+#endif
@@ -33,7 +33,21 @@
 class ConcurrentObject::Deleter
 {
 private:
-  Deleter () : m_thread ("AsyncDeleter")
+  typedef LockFreeStack <ConcurrentObject> Batch;
+
+  enum
+  {
+    // Objects per task when deleting on a ThreadGroup.
+    chunkSize = 256
+  };
+
+  struct Chunk
+  {
+    Batch objects;
+  };
+
+  Deleter ()
+    : m_thread ("AsyncDeleter")
   {
     m_thread.start ();
   }
@@ -48,18 +62,99 @@ private:
     //delete this;
   }
 
-  static void doDelete (ConcurrentObject* sharedObject)
+  // Called on the deleter thread once for every batch.
+  void collect ()
+  {
+    // Take everything released so far. Later releases
+    // start a new batch and queue another call.
+    Batch batch;
+    batch.takeAll (m_pending);
+
+    ThreadGroup* const group = m_group.get ();
+
+    if (group != nullptr)
+    {
+      ConcurrentObject* object = batch.pop_front ();
+
+      while (object != nullptr)
+      {
+        Chunk* const chunk = new Chunk;
+
+        for (int i = 0; i < chunkSize && object != nullptr; ++i)
+        {
+          chunk->objects.push_front (object);
+
+          object = batch.pop_front ();
+        }
+
+        group->call (1, &Deleter::deleteChunk, this, chunk);
+      }
+    }
+    else
+    {
+      deleteAll (batch);
+    }
+  }
+
+  void deleteChunk (Chunk* chunk)
+  {
+    deleteAll (chunk->objects);
+
+    delete chunk;
+  }
+
+  void deleteAll (Batch& batch)
   {
-    delete sharedObject;
+    ConcurrentObject* object;
+
+    while ((object = batch.pop_front ()) != nullptr)
+    {
+      delete object;
+
+      --m_backlog;
+    }
   }
 
 public:
   void destroy (ConcurrentObject* sharedObject)
   {
     if (m_thread.isAssociatedWithCurrentThread ())
+    {
       delete sharedObject;
+    }
     else
-      m_thread.call (&Deleter::doDelete, sharedObject);
+    {
+      int const backlog = ++m_backlog;
+
+      int highWater = m_highWater.get ();
+
+      while (backlog > highWater && ! m_highWater.compareAndSetBool (backlog, highWater))
+        highWater = m_highWater.get ();
+
+      // Only the push which makes the batch non-empty signals the thread.
+      if (m_pending.push_front (sharedObject))
+        m_thread.call (&Deleter::collect, this);
+    }
+  }
+
+  void setThreadGroup (ThreadGroup* group)
+  {
+    m_group.set (group);
+  }
+
+  int getBacklog () const
+  {
+    return m_backlog.get ();
+  }
+
+  int getHighWater () const
+  {
+    return m_highWater.get ();
+  }
+
+  void resetHighWater ()
+  {
+    m_highWater.set (m_backlog.get ());
   }
 
   static Deleter& getInstance ()
@@ -71,6 +166,10 @@ public:
 
 private:
   ThreadWithCallQueue m_thread;
+  Batch m_pending;
+  AtomicPointer <ThreadGroup> m_group;
+  Atomic <int> m_backlog;
+  Atomic <int> m_highWater;
 };
 
 //------------------------------------------------------------------------------
@@ -87,3 +186,23 @@ void ConcurrentObject::destroyConcurrentObject ()
 {
   Deleter::getInstance().destroy (this);
 }
+
+void ConcurrentObject::setDeletionThreadGroup (ThreadGroup* group)
+{
+  Deleter::getInstance().setThreadGroup (group);
+}
+
+int ConcurrentObject::getDeletionBacklog ()
+{
+  return Deleter::getInstance().getBacklog ();
+}
+
+int ConcurrentObject::getDeletionBacklogHighWater ()
+{
+  return Deleter::getInstance().getHighWater ();
+}
+
+void ConcurrentObject::resetDeletionBacklogHighWater ()
+{
+  Deleter::getInstance().resetHighWater ();
+}
@@ -49,12 +49,19 @@
   of performing heavyweight memory or cleanup operations from either an
   AudioIODeviceCallback or the message thread is avoided.
 
+  Released objects are handed to the deleter thread in batches: they are
+  linked into a lock-free stack, and the thread is only signaled when the
+  stack goes from empty to non-empty. Releasing many objects at once, for
+  example when a large shared structure is replaced, costs one queued call
+  instead of one per object. The batch may optionally be spread across the
+  threads of a ThreadGroup with setDeletionThreadGroup().
+
   The deletion behavior can be overriden by providing a replacement
   for destroyConcurrentObject().
 
   @ingroup vf_concurrent
 */
-class ConcurrentObject : Uncopyable
+class ConcurrentObject : public LockFreeStack <ConcurrentObject>::Node
 {
 public:
   inline void incReferenceCount() noexcept
@@ -68,6 +75,29 @@ public:
       destroyConcurrentObject ();
   }
 
+  /** Spread deletions across a ThreadGroup.
+
+      Batches of released objects are split into chunks, which are deleted
+      in parallel by the threads in the group. This helps when destructors
+      do significant work. Pass nullptr to delete everything on the deleter
+      thread, which is the default.
+
+      @note The group must outlive any pending deletions.
+  */
+  static void setDeletionThreadGroup (ThreadGroup* group);
+
+  /** Determine the number of objects waiting to be deleted.
+  */
+  static int getDeletionBacklog ();
+
+  /** Determine the largest backlog since the last reset.
+  */
+  static int getDeletionBacklogHighWater ();
+
+  /** Reset the backlog high water mark to the current backlog.
+  */
+  static void resetDeletionBacklogHighWater ();
+
 protected:
   ConcurrentObject();
 
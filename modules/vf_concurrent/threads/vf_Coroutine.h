@@ -0,0 +1,573 @@
+/*============================================================================*/
+/*
+  VFLib: https://github.com/vinniefalco/VFLib
+
+  Copyright (C) 2008 by Vinnie Falco <vinnie.falco@gmail.com>
+
+  This library contains portions of other open source products covered by
+  separate licenses. Please see the corresponding source files for specific
+  terms.
+  
+  VFLib is provided under the terms of The MIT License (MIT):
+
+  Permission is hereby granted, free of charge, to any person obtaining a copy
+  of this software and associated documentation files (the "Software"), to deal
+  in the Software without restriction, including without limitation the rights
+  to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+  copies of the Software, and to permit persons to whom the Software is
+  furnished to do so, subject to the following conditions:
+
+  The above copyright notice and this permission notice shall be included in
+  all copies or substantial portions of the Software.
+
+  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+  FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+  IN THE SOFTWARE.
+*/
+/*============================================================================*/
+
+#ifndef VF_COROUTINE_VFHEADER
+#define VF_COROUTINE_VFHEADER
+
+#if VF_COMPILER_SUPPORTS_COROUTINES
+
+/*============================================================================*/
+/**
+  Implementation details for Coroutine.
+
+  @internal
+
+  @ingroup vf_concurrent
+*/
+class CoroutineBase
+{
+public:
+  /** Allocator for coroutine frames.
+
+      Frames are usually short lived and released in roughly the order they
+      were created, which is the pattern the FIFO free store is built for.
+  */
+  typedef GlobalFifoFreeStore <CoroutineBase> AllocatorType;
+
+  /** Functor which resumes a suspended coroutine.
+  */
+  class Resume
+  {
+  public:
+    explicit Resume (std::coroutine_handle <> handle) : m_handle (handle)
+    {
+    }
+
+    void operator() () const
+    {
+      m_handle.resume ();
+    }
+
+    template <class Argument>
+    void operator() (Argument const&) const
+    {
+      m_handle.resume ();
+    }
+
+  private:
+    std::coroutine_handle <> m_handle;
+  };
+
+  /** Functor which rethrows a captured exception.
+  */
+  class Rethrow
+  {
+  public:
+    explicit Rethrow (std::exception_ptr exception) : m_exception (exception)
+    {
+    }
+
+    void operator() () const
+    {
+      std::rethrow_exception (m_exception);
+    }
+
+  private:
+    std::exception_ptr m_exception;
+  };
+
+  //============================================================================
+
+  /** Common part of the promise for every result type.
+  */
+  class PromiseBase
+  {
+  public:
+    PromiseBase () : m_detached (false)
+    {
+    }
+
+    static void* operator new (std::size_t bytes)
+    {
+      return AllocatorType::getInstance ()->allocate (bytes);
+    }
+
+    static void operator delete (void* p)
+    {
+      AllocatorType::deallocate (p);
+    }
+
+    /** Coroutines start suspended, and run when awaited or started.
+    */
+    std::suspend_always initial_suspend () noexcept
+    {
+      return std::suspend_always ();
+    }
+
+    /** Transfers control to the awaiting coroutine, if any.
+    */
+    class FinalAwaiter
+    {
+    public:
+      bool await_ready () const noexcept
+      {
+        return false;
+      }
+
+      template <class Promise>
+      std::coroutine_handle <> await_suspend (std::coroutine_handle <Promise> handle) noexcept
+      {
+        PromiseBase& promise = handle.promise ();
+
+        if (promise.m_continuation)
+          return promise.m_continuation;
+
+        if (promise.m_detached)
+        {
+          std::exception_ptr const exception = promise.m_exception;
+
+          handle.destroy ();
+
+          // Nothing awaits a started coroutine, so an exception which
+          // escaped from it is reported like one escaping a thread.
+          if (exception)
+            CatchAny (Rethrow (exception));
+        }
+
+        return std::noop_coroutine ();
+      }
+
+      void await_resume () const noexcept
+      {
+      }
+    };
+
+    FinalAwaiter final_suspend () noexcept
+    {
+      return FinalAwaiter ();
+    }
+
+    void unhandled_exception () noexcept
+    {
+      m_exception = std::current_exception ();
+    }
+
+    void rethrowIfFailed () const
+    {
+      if (m_exception)
+        std::rethrow_exception (m_exception);
+    }
+
+  public:
+    std::coroutine_handle <> m_continuation;
+    std::exception_ptr m_exception;
+    bool m_detached;
+  };
+
+  template <class T>
+  class PromiseType : public PromiseBase
+  {
+  public:
+    template <class U>
+    void return_value (U&& value)
+    {
+      m_value.emplace (std::forward <U> (value));
+    }
+
+    T getValue ()
+    {
+      rethrowIfFailed ();
+
+      return std::move (*m_value);
+    }
+
+  private:
+    std::optional <T> m_value;
+  };
+
+  //============================================================================
+
+  /** Awaitable which resumes the coroutine on a CallQueue.
+  */
+  class CallQueueAwaiter
+  {
+  public:
+    explicit CallQueueAwaiter (CallQueue& queue) : m_queue (queue)
+    {
+    }
+
+    bool await_ready () const
+    {
+      // Already on the queue's thread inside synchronize(), so keep going.
+      return m_queue.isAssociatedWithCurrentThread () &&
+             m_queue.isBeingSynchronized ();
+    }
+
+    void await_suspend (std::coroutine_handle <> handle)
+    {
+      m_queue.queuef (Resume (handle));
+    }
+
+    void await_resume () const
+    {
+    }
+
+  private:
+    CallQueue& m_queue;
+  };
+
+  /** Awaitable which resumes the coroutine on a ThreadGroup thread.
+  */
+  class ThreadGroupAwaiter
+  {
+  public:
+    explicit ThreadGroupAwaiter (ThreadGroup& group) : m_group (group)
+    {
+    }
+
+    bool await_ready () const
+    {
+      return false;
+    }
+
+    void await_suspend (std::coroutine_handle <> handle)
+    {
+      m_group.callf (1, Resume (handle));
+    }
+
+    void await_resume () const
+    {
+    }
+
+  private:
+    ThreadGroup& m_group;
+  };
+
+  /** Awaitable for a Future.
+  */
+  template <class T>
+  class FutureAwaiter
+  {
+  public:
+    explicit FutureAwaiter (Future <T> const& future) : m_future (future)
+    {
+    }
+
+    bool await_ready () const
+    {
+      return m_future.isReady ();
+    }
+
+    void await_suspend (std::coroutine_handle <> handle)
+    {
+      m_future.thenf (Resume (handle));
+    }
+
+    typename FutureBase::StateType <T>::ReturnType await_resume () const
+    {
+      return m_future.get ();
+    }
+
+  private:
+    Future <T> m_future;
+  };
+};
+
+/** Promise specialization for coroutines without a result.
+
+    @internal
+*/
+template <>
+class CoroutineBase::PromiseType <void> : public CoroutineBase::PromiseBase
+{
+public:
+  void return_void ()
+  {
+  }
+
+  void getValue ()
+  {
+    rethrowIfFailed ();
+  }
+};
+
+/*============================================================================*/
+/**
+  A lazily started C++20 coroutine producing a value of type T.
+
+  A function which returns a Coroutine may use `co_await` and `co_return`.
+  The body does not run until the coroutine is awaited by another coroutine,
+  or started with start() or toFuture(). Frames are allocated from a
+  GlobalFifoFreeStore instead of the general purpose heap.
+
+  Combined with resumeOn(), a workflow can move between threads without
+  chaining callbacks through CallQueue::call(). Each hop is a single queued
+  resumption, and awaiting a Coroutine transfers control directly to it with
+  no queueing at all:
+
+  @code
+
+  Coroutine <Image> loadThumbnail (File file)
+  {
+    co_await resumeOn (ioThread);            // a ThreadWithCallQueue
+
+    MemoryBlock data = readFile (file);
+
+    co_await resumeOn (*GlobalThreadGroup::getInstance ());
+
+    Image image = decodeAndScale (data);
+
+    co_await resumeOn (guiCallQueue);
+
+    co_return image;
+  }
+
+  Coroutine <void> showThumbnail (File file)
+  {
+    Image image = co_await loadThumbnail (file);
+
+    m_thumbnailComponent.setImage (image);
+  }
+
+  showThumbnail (file).start ();
+
+  @endcode
+
+  Exceptions thrown in the body propagate to the awaiting coroutine, or to
+  Future::get() when toFuture() is used. A coroutine run with start() has
+  nobody to receive them, so they go to CatchAny().
+
+  A Future may also be awaited directly. Since the coroutine then resumes
+  on the thread which makes the future ready, it is common to follow it with
+  resumeOn().
+
+  @note This is only available when VF_COMPILER_SUPPORTS_COROUTINES is set,
+        which happens automatically on compilers with C++20 coroutines.
+
+  @see resumeOn, Future
+
+  @ingroup vf_concurrent
+*/
+template <class T = void>
+class Coroutine : Uncopyable
+{
+public:
+  class promise_type : public CoroutineBase::PromiseType <T>
+  {
+  public:
+    Coroutine get_return_object ()
+    {
+      return Coroutine (std::coroutine_handle <promise_type>::from_promise (*this));
+    }
+  };
+
+  typedef std::coroutine_handle <promise_type> HandleType;
+
+  Coroutine (Coroutine&& other) noexcept
+    : m_handle (other.m_handle)
+  {
+    other.m_handle = nullptr;
+  }
+
+  Coroutine& operator= (Coroutine&& other) noexcept
+  {
+    if (this != &other)
+    {
+      if (m_handle)
+        m_handle.destroy ();
+
+      m_handle = other.m_handle;
+      other.m_handle = nullptr;
+    }
+
+    return *this;
+  }
+
+  ~Coroutine ()
+  {
+    if (m_handle)
+      m_handle.destroy ();
+  }
+
+  /** Determine if the coroutine has finished.
+  */
+  bool isDone () const
+  {
+    return ! m_handle || m_handle.done ();
+  }
+
+  /** Run the coroutine without waiting for it.
+
+      The coroutine runs on the calling thread until its first suspension.
+      Ownership of the frame passes to the coroutine itself, which is
+      destroyed when it finishes. An exception which escapes the body is
+      passed to CatchAny(), which reports it to the application's unhandled
+      exception handler, as for an exception escaping a thread.
+  */
+  void start ()
+  {
+    jassert (m_handle && ! m_handle.done ());
+
+    HandleType handle = m_handle;
+    m_handle = nullptr;
+
+    handle.promise ().m_detached = true;
+    handle.resume ();
+  }
+
+  /** Run the coroutine and provide its result as a Future.
+
+      Exceptions other than Error are reported as Error::exception.
+
+      @note The result type must meet the requirements of Future.
+  */
+  Future <T> toFuture ()
+  {
+    Promise <T> promise;
+
+    deliver (std::move (*this), promise).start ();
+
+    return promise.getFuture ();
+  }
+
+  //----------------------------------------------------------------------------
+
+  /** Awaiting a Coroutine starts it and resumes the caller when it finishes.
+  */
+  class Awaiter
+  {
+  public:
+    explicit Awaiter (HandleType handle) : m_handle (handle)
+    {
+    }
+
+    bool await_ready () const noexcept
+    {
+      return ! m_handle || m_handle.done ();
+    }
+
+    std::coroutine_handle <> await_suspend (std::coroutine_handle <> awaiting) noexcept
+    {
+      m_handle.promise ().m_continuation = awaiting;
+
+      return m_handle;
+    }
+
+    T await_resume ()
+    {
+      return m_handle.promise ().getValue ();
+    }
+
+  private:
+    HandleType m_handle;
+  };
+
+  Awaiter operator co_await () && noexcept
+  {
+    return Awaiter (m_handle);
+  }
+
+private:
+  explicit Coroutine (HandleType handle) : m_handle (handle)
+  {
+  }
+
+  static Coroutine <void> deliver (Coroutine coroutine, Promise <T> promise)
+  {
+    try
+    {
+      if constexpr (std::is_void <T>::value)
+      {
+        co_await std::move (coroutine);
+        promise.setValue ();
+      }
+      else
+      {
+        promise.setValue (co_await std::move (coroutine));
+      }
+    }
+    catch (Error& e)
+    {
+      promise.setError (e);
+    }
+    catch (std::exception& e)
+    {
+      promise.setError (Error ().fail (__FILE__, __LINE__,
+        String (e.what ()), Error::exception));
+    }
+    catch (...)
+    {
+      promise.setError (Error ().fail (__FILE__, __LINE__, Error::exception));
+    }
+  }
+
+private:
+  HandleType m_handle;
+};
+
+/*============================================================================*/
+/**
+  Resume the current coroutine on another thread.
+
+  When awaited, the coroutine is suspended and resumed by the specified
+  CallQueue during its next synchronize(), or by one thread in the
+  specified ThreadGroup. When already inside synchronize() of the queue,
+  the coroutine continues without suspending.
+
+  @code
+
+  co_await resumeOn (guiCallQueue);
+
+  @endcode
+
+  @see Coroutine
+
+  @ingroup vf_concurrent
+*/
+/** @{ */
+inline CoroutineBase::CallQueueAwaiter resumeOn (CallQueue& queue)
+{
+  return CoroutineBase::CallQueueAwaiter (queue);
+}
+
+inline CoroutineBase::ThreadGroupAwaiter resumeOn (ThreadGroup& group)
+{
+  return CoroutineBase::ThreadGroupAwaiter (group);
+}
+/** @} */
+
+/** Await a Future from a coroutine.
+
+    The result of the `co_await` expression is the value of the future. If
+    the future failed, its Error is thrown.
+
+    @ingroup vf_concurrent
+*/
+template <class T>
+CoroutineBase::FutureAwaiter <T> operator co_await (Future <T> const& future)
+{
+  return CoroutineBase::FutureAwaiter <T> (future);
+}
+
+#endif
+
+#endif
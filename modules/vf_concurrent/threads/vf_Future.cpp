@@ -0,0 +1,165 @@
+/*============================================================================*/
+/*
+  VFLib: https://github.com/vinniefalco/VFLib
+
+  Copyright (C) 2008 by Vinnie Falco <vinnie.falco@gmail.com>
+
+  This library contains portions of other open source products covered by
+  separate licenses. Please see the corresponding source files for specific
+  terms.
+  
+  VFLib is provided under the terms of The MIT License (MIT):
+
+  Permission is hereby granted, free of charge, to any person obtaining a copy
+  of this software and associated documentation files (the "Software"), to deal
+  in the Software without restriction, including without limitation the rights
+  to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+  copies of the Software, and to permit persons to whom the Software is
+  furnished to do so, subject to the following conditions:
+
+  The above copyright notice and this permission notice shall be included in
+  all copies or substantial portions of the Software.
+
+  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+  FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+  IN THE SOFTWARE.
+*/
+/*============================================================================*/
+
+FutureBase::State::State ()
+  : m_event (true) // manual reset
+  , m_continuations (nullptr)
+{
+}
+
+FutureBase::State::~State ()
+{
+  // A state that was never made ready has no continuations,
+  // since releasing the last promise fails the state.
+  jassert (m_continuations == nullptr);
+
+  m_error.willBeReported ();
+}
+
+void FutureBase::State::wait () const
+{
+  RealtimeChecker::check ("Future::wait");
+
+  if (! isReady ())
+    m_event.wait ();
+}
+
+bool FutureBase::State::wait (int milliseconds) const
+{
+  if (milliseconds != 0)
+    RealtimeChecker::check ("Future::wait");
+
+  if (isReady ())
+    return true;
+
+  return m_event.wait (milliseconds);
+}
+
+bool FutureBase::State::failed () const
+{
+  jassert (isReady ());
+
+  return m_error.failed ();
+}
+
+Error const& FutureBase::State::getError () const
+{
+  jassert (isReady ());
+
+  return m_error;
+}
+
+void FutureBase::State::setError (Error const& error)
+{
+  jassert (error.failed ());
+
+  m_error = error;
+
+  setReady ();
+}
+
+void FutureBase::State::addContinuation (Continuation* c)
+{
+  {
+    SpinLock::ScopedLockType lock (m_lock);
+
+    if (! isReady ())
+    {
+      c->m_next = m_continuations;
+      m_continuations = c;
+      c = nullptr;
+    }
+  }
+
+  // Already ready, so call it now.
+  if (c != nullptr)
+  {
+    (*c) ();
+
+    delete c;
+  }
+}
+
+void FutureBase::State::addPromise () noexcept
+{
+  ++m_promises;
+}
+
+void FutureBase::State::releasePromise ()
+{
+  if (--m_promises == 0 && ! isReady ())
+  {
+    setError (Error ().fail (__FILE__, __LINE__,
+      TRANS ("the promise was destroyed without a result"), Error::canceled));
+  }
+}
+
+void FutureBase::State::setReady ()
+{
+  Continuation* list;
+
+  {
+    SpinLock::ScopedLockType lock (m_lock);
+
+    // A promise may only be fulfilled once.
+    jassert (! isReady ());
+
+    m_ready.signal ();
+
+    list = m_continuations;
+    m_continuations = nullptr;
+  }
+
+  m_event.signal ();
+
+  // Reverse the list so continuations run in the order they were added.
+  Continuation* c = nullptr;
+
+  while (list != nullptr)
+  {
+    Continuation* const next = list->m_next;
+    list->m_next = c;
+    c = list;
+    list = next;
+  }
+
+  while (c != nullptr)
+  {
+    Continuation* const next = c->m_next;
+
+    (*c) ();
+
+    delete c;
+
+    c = next;
+  }
+}
@@ -0,0 +1,870 @@
+/*============================================================================*/
+/*
+  VFLib: https://github.com/vinniefalco/VFLib
+
+  Copyright (C) 2008 by Vinnie Falco <vinnie.falco@gmail.com>
+
+  This library contains portions of other open source products covered by
+  separate licenses. Please see the corresponding source files for specific
+  terms.
+  
+  VFLib is provided under the terms of The MIT License (MIT):
+
+  Permission is hereby granted, free of charge, to any person obtaining a copy
+  of this software and associated documentation files (the "Software"), to deal
+  in the Software without restriction, including without limitation the rights
+  to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+  copies of the Software, and to permit persons to whom the Software is
+  furnished to do so, subject to the following conditions:
+
+  The above copyright notice and this permission notice shall be included in
+  all copies or substantial portions of the Software.
+
+  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+  FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+  IN THE SOFTWARE.
+*/
+/*============================================================================*/
+
+#ifndef VF_FUTURE_VFHEADER
+#define VF_FUTURE_VFHEADER
+
+template <class T>
+class Future;
+
+template <class T>
+class Promise;
+
+/*============================================================================*/
+/**
+  Shared state for Promise and Future.
+
+  @internal
+
+  @ingroup vf_concurrent
+*/
+class FutureBase
+{
+public:
+  /** Allocator for shared states and continuations.
+  */
+  typedef GlobalFifoFreeStore <FutureBase> AllocatorType;
+
+  //============================================================================
+
+  /** Abstract nullary functor invoked when a future becomes ready.
+  */
+  class Continuation : public AllocatedBy <AllocatorType>
+  {
+  public:
+    Continuation () : m_next (nullptr) { }
+    virtual ~Continuation () { }
+    virtual void operator() () = 0;
+
+  private:
+    friend class FutureBase;
+
+    Continuation* m_next;
+  };
+
+  template <class Functor>
+  class ContinuationType : public Continuation
+  {
+  public:
+    explicit ContinuationType (Functor const& f) : m_f (f) { }
+    void operator() () { m_f (); }
+
+  private:
+    Functor m_f;
+  };
+
+  //============================================================================
+
+  /** Common part of the shared state.
+
+      A state becomes ready exactly once, either with a value or with an
+      Error. Continuations added before that point are stored and invoked by
+      the thread that makes the state ready. Continuations added afterwards
+      are invoked immediately by the thread adding them.
+  */
+  class State
+    : public ReferenceCountedObject
+    , public AllocatedBy <AllocatorType>
+    , Uncopyable
+  {
+  public:
+    State ();
+    ~State ();
+
+    inline bool isReady () const noexcept
+    {
+      return m_ready.isSignaled ();
+    }
+
+    void wait () const;
+
+    bool wait (int milliseconds) const;
+
+    bool failed () const;
+
+    Error const& getError () const;
+
+    void setError (Error const& error);
+
+    void addContinuation (Continuation* c);
+
+    void addPromise () noexcept;
+
+    void releasePromise ();
+
+  protected:
+    void setReady ();
+
+  private:
+    SpinLock m_lock;
+    AtomicFlag m_ready;
+    WaitableEvent m_event;
+    Continuation* m_continuations;
+    Atomic <int> m_promises;
+    Error m_error;
+  };
+
+  /** Shared state holding a value.
+
+      @note The value type must be default constructible and copyable.
+  */
+  template <class T>
+  class StateType : public State
+  {
+  public:
+    typedef T const& ReturnType;
+
+    inline ReturnType getValue () const
+    {
+      return m_value;
+    }
+
+    void setValue (T const& value)
+    {
+      m_value = value;
+
+      setReady ();
+    }
+
+  private:
+    T m_value;
+  };
+
+  //============================================================================
+
+  template <class R>
+  struct Invoke
+  {
+    template <class Functor, class Argument>
+    static void call (Promise <R>& promise, Functor& f, Argument const& arg)
+    {
+      promise.setValue (f (arg));
+    }
+
+    template <class Functor>
+    static void call (Promise <R>& promise, Functor& f)
+    {
+      promise.setValue (f ());
+    }
+  };
+
+  /** Continuation functor which produces the value of another promise.
+  */
+  template <class T, class R, class Functor>
+  class ThenCall
+  {
+  public:
+    ThenCall (Future <T> const& future, Promise <R> const& promise, Functor const& f)
+      : m_future (future)
+      , m_promise (promise)
+      , m_f (f)
+    {
+    }
+
+    void operator() ()
+    {
+      try
+      {
+        Invoke <R>::call (m_promise, m_f, m_future);
+      }
+      catch (Error& e)
+      {
+        m_promise.setError (e);
+      }
+      catch (std::exception& e)
+      {
+        m_promise.setError (Error ().fail (__FILE__, __LINE__,
+          String (e.what ()), Error::exception));
+      }
+      catch (...)
+      {
+        m_promise.setError (Error ().fail (__FILE__, __LINE__, Error::exception));
+      }
+    }
+
+  private:
+    Future <T> m_future;
+    Promise <R> m_promise;
+    Functor m_f;
+  };
+
+  /** Continuation functor which calls the caller's functor with the future.
+  */
+  template <class T, class Functor>
+  class ThenfCall
+  {
+  public:
+    ThenfCall (Future <T> const& future, Functor const& f)
+      : m_future (future)
+      , m_f (f)
+    {
+    }
+
+    void operator() ()
+    {
+      m_f (m_future);
+    }
+
+  private:
+    Future <T> m_future;
+    Functor m_f;
+  };
+
+  /** Continuation functor which produces the value of a promise on a
+      ThreadGroup thread.
+  */
+  template <class R, class Functor>
+  class AsyncCall
+  {
+  public:
+    AsyncCall (Promise <R> const& promise, Functor const& f)
+      : m_promise (promise)
+      , m_f (f)
+    {
+    }
+
+    void operator() ()
+    {
+      try
+      {
+        Invoke <R>::call (m_promise, m_f);
+      }
+      catch (Error& e)
+      {
+        m_promise.setError (e);
+      }
+      catch (std::exception& e)
+      {
+        m_promise.setError (Error ().fail (__FILE__, __LINE__,
+          String (e.what ()), Error::exception));
+      }
+      catch (...)
+      {
+        m_promise.setError (Error ().fail (__FILE__, __LINE__, Error::exception));
+      }
+    }
+
+  private:
+    Promise <R> m_promise;
+    Functor m_f;
+  };
+
+  /** Delivers a nullary functor to a CallQueue.
+  */
+  template <class Functor>
+  class QueueCall
+  {
+  public:
+    QueueCall (CallQueue& queue, Functor const& f) : m_queue (&queue), m_f (f) { }
+    void operator() () { m_queue->queuef (m_f); }
+
+  private:
+    CallQueue* m_queue;
+    Functor m_f;
+  };
+
+  /** Delivers a nullary functor to one thread in a ThreadGroup.
+  */
+  template <class Functor>
+  class GroupCall
+  {
+  public:
+    GroupCall (ThreadGroup& group, Functor const& f) : m_group (&group), m_f (f) { }
+    void operator() () { m_group->callf (1, m_f); }
+
+  private:
+    ThreadGroup* m_group;
+    Functor m_f;
+  };
+
+  //============================================================================
+
+  template <class Functor>
+  static void addContinuationf (State* state, Functor const& f)
+  {
+    state->addContinuation (new (*AllocatorType::getInstance ())
+      ContinuationType <Functor> (f));
+  }
+
+  template <class T>
+  static StateType <T>* newState ()
+  {
+    return new (*AllocatorType::getInstance ()) StateType <T>;
+  }
+};
+
+/** Shared state without a value.
+
+    @internal
+*/
+template <>
+class FutureBase::StateType <void> : public FutureBase::State
+{
+public:
+  typedef void ReturnType;
+
+  inline void getValue () const
+  {
+  }
+
+  void setValue ()
+  {
+    setReady ();
+  }
+};
+
+/*============================================================================*/
+/**
+  The consumer side of an asynchronous result.
+
+  A Future refers to a value of type T which is produced at some later time,
+  usually by a function running on another thread. Futures are cheap to copy;
+  all copies refer to the same shared state. The value may be obtained by
+  blocking, or by attaching a continuation which is invoked when the value is
+  ready. Continuations may run on the producing thread, be delivered to a
+  CallQueue (for example, a GuiCallQueue), or be posted to a ThreadGroup:
+
+  @code
+
+  int computeChecksum (String path);
+
+  void Gui::showChecksum (Future <int> const& result)
+  {
+    if (! result.failed ())
+      m_label.setText (String (result.get ()), false);
+  }
+
+  void Gui::startChecksum (String path)
+  {
+    Future <int> f = async <int> (*GlobalThreadGroup::getInstance (),
+                                  &computeChecksum, path);
+
+    f.thenf (m_guiCallQueue, vf::bind (&Gui::showChecksum, this, vf::_1));
+  }
+
+  @endcode
+
+  When the producer fails by throwing an Error, the Error is stored in the
+  shared state and rethrown by get().
+
+  @see Promise, async, whenAll, whenAny, TaskGraph
+
+  @ingroup vf_concurrent
+*/
+template <class T>
+class Future
+{
+public:
+  typedef T ValueType;
+
+  /** Create an invalid future.
+  */
+  Future ()
+  {
+  }
+
+  /** Determine if the future refers to a shared state.
+  */
+  inline bool isValid () const noexcept
+  {
+    return m_state != nullptr;
+  }
+
+  /** Determine if the value or error is available without blocking.
+  */
+  inline bool isReady () const noexcept
+  {
+    return m_state->isReady ();
+  }
+
+  /** Block until the future is ready.
+  */
+  void wait () const
+  {
+    m_state->wait ();
+  }
+
+  /** Block until the future is ready or the timeout expires.
+
+      @return `true` if the future is ready.
+  */
+  bool wait (int milliseconds) const
+  {
+    return m_state->wait (milliseconds);
+  }
+
+  /** Determine if the producer failed.
+
+      @invariant The future must be ready.
+  */
+  bool failed () const
+  {
+    return m_state->failed ();
+  }
+
+  /** Retrieve the Error from a failed producer.
+
+      @invariant The future must be ready.
+  */
+  Error const& getError () const
+  {
+    return m_state->getError ();
+  }
+
+  /** Retrieve the value, blocking if necessary.
+
+      If the producer failed, the corresponding Error is thrown.
+  */
+  typename FutureBase::StateType <T>::ReturnType get () const
+  {
+    m_state->wait ();
+
+    if (m_state->failed ())
+      Throw (m_state->getError ());
+
+    return m_state->getValue ();
+  }
+
+  /** Attach a continuation.
+
+      The functor is called with this future as its only argument once it is
+      ready. The call is made on the thread which makes the future ready, or
+      immediately if the future is already ready.
+
+      @param f A functor with the signature `void (Future <T> const&)`.
+  */
+  template <class Functor>
+  void thenf (Functor const& f) const
+  {
+    FutureBase::addContinuationf (m_state,
+      FutureBase::ThenfCall <T, Functor> (*this, f));
+  }
+
+  /** Attach a continuation which runs on a CallQueue.
+
+      When the future becomes ready, the functor is added to the queue with
+      CallQueue::queuef(), so it never runs synchronously from inside
+      the producer.
+  */
+  template <class Functor>
+  void thenf (CallQueue& queue, Functor const& f) const
+  {
+    typedef FutureBase::ThenfCall <T, Functor> CallType;
+
+    FutureBase::addContinuationf (m_state,
+      FutureBase::QueueCall <CallType> (queue, CallType (*this, f)));
+  }
+
+  /** Attach a continuation which runs on a ThreadGroup thread.
+  */
+  template <class Functor>
+  void thenf (ThreadGroup& group, Functor const& f) const
+  {
+    typedef FutureBase::ThenfCall <T, Functor> CallType;
+
+    FutureBase::addContinuationf (m_state,
+      FutureBase::GroupCall <CallType> (group, CallType (*this, f)));
+  }
+
+  /** Attach a continuation which produces another value.
+
+      The functor is called with this future once it is ready, and its return
+      value becomes the value of the returned future. An Error thrown by the
+      functor is stored in the returned future instead. The result type must
+      be specified explicitly:
+
+      @code
+
+      Future <Image> image = async <Image> (group, &loadImage, file);
+
+      Future <Image> thumb = image.then <Image> (&makeThumbnail);
+
+      @endcode
+
+      @param f A functor with the signature `R (Future <T> const&)`.
+  */
+  /** @{ */
+  template <class R, class Functor>
+  Future <R> then (Functor const& f) const
+  {
+    Promise <R> promise;
+
+    FutureBase::addContinuationf (m_state,
+      FutureBase::ThenCall <T, R, Functor> (*this, promise, f));
+
+    return promise.getFuture ();
+  }
+
+  template <class R, class Functor>
+  Future <R> then (CallQueue& queue, Functor const& f) const
+  {
+    typedef FutureBase::ThenCall <T, R, Functor> CallType;
+
+    Promise <R> promise;
+
+    FutureBase::addContinuationf (m_state,
+      FutureBase::QueueCall <CallType> (queue, CallType (*this, promise, f)));
+
+    return promise.getFuture ();
+  }
+
+  template <class R, class Functor>
+  Future <R> then (ThreadGroup& group, Functor const& f) const
+  {
+    typedef FutureBase::ThenCall <T, R, Functor> CallType;
+
+    Promise <R> promise;
+
+    FutureBase::addContinuationf (m_state,
+      FutureBase::GroupCall <CallType> (group, CallType (*this, promise, f)));
+
+    return promise.getFuture ();
+  }
+  /** @} */
+
+private:
+  friend class Promise <T>;
+
+  typedef ReferenceCountedObjectPtr <FutureBase::StateType <T> > StatePtr;
+
+  explicit Future (StatePtr const& state) : m_state (state)
+  {
+  }
+
+private:
+  StatePtr m_state;
+};
+
+/*============================================================================*/
+/**
+  The producer side of an asynchronous result.
+
+  A Promise creates the shared state and makes it ready exactly once, by
+  calling either setValue() or setError(). Copies of a Promise refer to the
+  same state. If the last copy is destroyed without making the state ready,
+  the associated futures fail with Error::canceled so that waiters and
+  continuations are not left hanging.
+
+  @see Future
+
+  @ingroup vf_concurrent
+*/
+template <class T>
+class Promise
+{
+public:
+  Promise ()
+    : m_state (FutureBase::newState <T> ())
+  {
+    m_state->addPromise ();
+  }
+
+  Promise (Promise const& other)
+    : m_state (other.m_state)
+  {
+    m_state->addPromise ();
+  }
+
+  Promise& operator= (Promise const& other)
+  {
+    other.m_state->addPromise ();
+    m_state->releasePromise ();
+    m_state = other.m_state;
+    return *this;
+  }
+
+  ~Promise ()
+  {
+    m_state->releasePromise ();
+  }
+
+  /** Retrieve a future referring to this promise.
+  */
+  Future <T> getFuture () const
+  {
+    return Future <T> (m_state);
+  }
+
+  /** Make the state ready with a value.
+  */
+  void setValue (T const& value)
+  {
+    m_state->setValue (value);
+  }
+
+  /** Make the state ready with an Error.
+  */
+  void setError (Error const& error)
+  {
+    m_state->setError (error);
+  }
+
+private:
+  ReferenceCountedObjectPtr <FutureBase::StateType <T> > m_state;
+};
+
+/** Promise specialization for operations without a result.
+
+    @ingroup vf_concurrent
+*/
+template <>
+class Promise <void>
+{
+public:
+  Promise ()
+    : m_state (FutureBase::newState <void> ())
+  {
+    m_state->addPromise ();
+  }
+
+  Promise (Promise const& other)
+    : m_state (other.m_state)
+  {
+    m_state->addPromise ();
+  }
+
+  Promise& operator= (Promise const& other)
+  {
+    other.m_state->addPromise ();
+    m_state->releasePromise ();
+    m_state = other.m_state;
+    return *this;
+  }
+
+  ~Promise ()
+  {
+    m_state->releasePromise ();
+  }
+
+  Future <void> getFuture () const
+  {
+    return Future <void> (m_state);
+  }
+
+  void setValue ()
+  {
+    m_state->setValue ();
+  }
+
+  void setError (Error const& error)
+  {
+    m_state->setError (error);
+  }
+
+private:
+  ReferenceCountedObjectPtr <FutureBase::StateType <void> > m_state;
+};
+
+template <>
+struct FutureBase::Invoke <void>
+{
+  template <class Functor, class Argument>
+  static void call (Promise <void>& promise, Functor& f, Argument const& arg)
+  {
+    f (arg);
+    promise.setValue ();
+  }
+
+  template <class Functor>
+  static void call (Promise <void>& promise, Functor& f)
+  {
+    f ();
+    promise.setValue ();
+  }
+};
+
+/*============================================================================*/
+/**
+  Run a function on a ThreadGroup and return its result as a Future.
+
+  The function runs on exactly one thread in the group. If it throws an
+  Error, the Error is stored in the future. The result type must be specified
+  explicitly:
+
+  @code
+
+  Future <int> f = async <int> (group, &computeChecksum, path);
+
+  @endcode
+
+  @param group The ThreadGroup to run the function on.
+
+  @param f The function to call followed by up to eight parameters,
+           evaluated immediately.
+
+  @ingroup vf_concurrent
+*/
+/** @{ */
+template <class R, class Functor>
+Future <R> asyncf (ThreadGroup& group, Functor const& f)
+{
+  Promise <R> promise;
+
+  group.callf (1, FutureBase::AsyncCall <R, Functor> (promise, f));
+
+  return promise.getFuture ();
+}
+
+template <class R, class Fn>
+Future <R> async (ThreadGroup& group, Fn f)
+  { return asyncf <R> (group, vf::bind (f)); }
+
+template <class R, class Fn, class T1>
+Future <R> async (ThreadGroup& group, Fn f, T1 t1)
+  { return asyncf <R> (group, vf::bind (f, t1)); }
+
+template <class R, class Fn, class T1, class T2>
+Future <R> async (ThreadGroup& group, Fn f, T1 t1, T2 t2)
+  { return asyncf <R> (group, vf::bind (f, t1, t2)); }
+
+template <class R, class Fn, class T1, class T2, class T3>
+Future <R> async (ThreadGroup& group, Fn f, T1 t1, T2 t2, T3 t3)
+  { return asyncf <R> (group, vf::bind (f, t1, t2, t3)); }
+
+template <class R, class Fn, class T1, class T2, class T3, class T4>
+Future <R> async (ThreadGroup& group, Fn f, T1 t1, T2 t2, T3 t3, T4 t4)
+  { return asyncf <R> (group, vf::bind (f, t1, t2, t3, t4)); }
+
+template <class R, class Fn, class T1, class T2, class T3, class T4, class T5>
+Future <R> async (ThreadGroup& group, Fn f, T1 t1, T2 t2, T3 t3, T4 t4, T5 t5)
+  { return asyncf <R> (group, vf::bind (f, t1, t2, t3, t4, t5)); }
+
+template <class R, class Fn, class T1, class T2, class T3, class T4, class T5, class T6>
+Future <R> async (ThreadGroup& group, Fn f, T1 t1, T2 t2, T3 t3, T4 t4, T5 t5, T6 t6)
+  { return asyncf <R> (group, vf::bind (f, t1, t2, t3, t4, t5, t6)); }
+
+template <class R, class Fn, class T1, class T2, class T3, class T4, class T5, class T6, class T7>
+Future <R> async (ThreadGroup& group, Fn f, T1 t1, T2 t2, T3 t3, T4 t4, T5 t5, T6 t6, T7 t7)
+  { return asyncf <R> (group, vf::bind (f, t1, t2, t3, t4, t5, t6, t7)); }
+
+template <class R, class Fn, class T1, class T2, class T3, class T4, class T5, class T6, class T7, class T8>
+Future <R> async (ThreadGroup& group, Fn f, T1 t1, T2 t2, T3 t3, T4 t4, T5 t5, T6 t6, T7 t7, T8 t8)
+  { return asyncf <R> (group, vf::bind (f, t1, t2, t3, t4, t5, t6, t7, t8)); }
+/** @} */
+
+/*============================================================================*/
+
+/** Shared state for whenAll() and whenAny().
+
+    @internal
+*/
+class FutureJoin
+  : public ReferenceCountedObject
+  , public AllocatedBy <FutureBase::AllocatorType>
+  , Uncopyable
+{
+public:
+  FutureJoin (int numberOfFutures)
+    : m_remaining (numberOfFutures)
+  {
+  }
+
+  template <class T>
+  void allReady (Future <T> const& future)
+  {
+    if (future.failed () && m_firstFailure.trySignal ())
+      m_all.setError (future.getError ());
+
+    if (--m_remaining == 0 && ! m_firstFailure.isSignaled ())
+      m_all.setValue ();
+  }
+
+  template <class T>
+  void anyReady (int index, Future <T> const&)
+  {
+    if (m_firstReady.trySignal ())
+      m_any.setValue (index);
+  }
+
+  Promise <void> m_all;
+  Promise <int> m_any;
+
+private:
+  Atomic <int> m_remaining;
+  AtomicFlag m_firstFailure;
+  AtomicFlag m_firstReady;
+};
+
+/** Combine futures into one which becomes ready when all are ready.
+
+    If any of the futures fails, the combined future fails immediately with
+    the first Error observed, without waiting for the others.
+
+    @ingroup vf_concurrent
+*/
+template <class T>
+Future <void> whenAll (std::vector <Future <T> > const& futures)
+{
+  ReferenceCountedObjectPtr <FutureJoin> join (
+    new (*FutureBase::AllocatorType::getInstance ()) FutureJoin (int (futures.size ())));
+
+  Future <void> result = join->m_all.getFuture ();
+
+  if (futures.empty ())
+  {
+    join->m_all.setValue ();
+  }
+  else
+  {
+    for (std::size_t i = 0; i < futures.size (); ++i)
+      futures [i].thenf (vf::bind (&FutureJoin::allReady <T>, join, vf::_1));
+  }
+
+  return result;
+}
+
+/** Combine futures into one which becomes ready when any is ready.
+
+    The value of the combined future is the index of the first future to
+    become ready, whether or not it failed.
+
+    @invariant There must be at least one future.
+
+    @ingroup vf_concurrent
+*/
+template <class T>
+Future <int> whenAny (std::vector <Future <T> > const& futures)
+{
+  jassert (! futures.empty ());
+
+  ReferenceCountedObjectPtr <FutureJoin> join (
+    new (*FutureBase::AllocatorType::getInstance ()) FutureJoin (int (futures.size ())));
+
+  Future <int> result = join->m_any.getFuture ();
+
+  for (std::size_t i = 0; i < futures.size (); ++i)
+    futures [i].thenf (vf::bind (&FutureJoin::anyReady <T>, join, int (i), vf::_1));
+
+  return result;
+}
+
+#endif
@@ -48,7 +48,8 @@ private:
   friend class RefCountedSingleton <GlobalThreadGroup>;
 
   GlobalThreadGroup ()
-    : RefCountedSingleton <GlobalThreadGroup> (
+    : ThreadGroup (SystemStats::getNumCpus (), "GlobalThreadGroup")
+    , RefCountedSingleton <GlobalThreadGroup> (
         SingletonLifetime::persistAfterCreation)
   {
   }
@@ -274,6 +274,8 @@ void ListenersBase::Group::queue1 (Call* const c,
 //
 void ListenersBase::Group::do_call (Call* const c, const timestamp_t timestamp)
 {
+  VF_TRACE_SCOPE ("Listeners::dispatch");
+
   if (!empty ())
   {
     ReadWriteMutex::ScopedReadLockType lock (m_mutex);
@@ -319,6 +321,8 @@ void ListenersBase::Group::do_call (Call* const c, const timestamp_t timestamp)
 void ListenersBase::Group::do_call1 (Call* const c, const timestamp_t timestamp,
                                      void* const listener)
 {
+  VF_TRACE_SCOPE ("Listeners::dispatch");
+
   if (!empty ())
   {
     ReadWriteMutex::ScopedReadLockType lock (m_mutex);
@@ -645,6 +649,8 @@ void ListenersBase::remove_void (void* const listener)
 
 void ListenersBase::callp (Call::Ptr cp)
 {
+  VF_TRACE_SCOPE ("Listeners::call");
+
   Call* c = cp;
 
   ReadWriteMutex::ScopedReadLockType lock (m_groups_mutex);
@@ -657,6 +663,8 @@ void ListenersBase::callp (Call::Ptr cp)
 
 void ListenersBase::queuep (Call::Ptr cp)
 {
+  VF_TRACE_SCOPE ("Listeners::queue");
+
   Call* c = cp;
 
   ReadWriteMutex::ScopedReadLockType lock (m_groups_mutex);
@@ -669,6 +677,8 @@ void ListenersBase::queuep (Call::Ptr cp)
 
 void ListenersBase::call1p_void (void* const listener, Call* c)
 {
+  VF_TRACE_SCOPE ("Listeners::call1");
+
   ReadWriteMutex::ScopedReadLockType lock (m_groups_mutex);
 
   // can't be const iterator because queue() might cause called functors
@@ -686,6 +696,8 @@ void ListenersBase::call1p_void (void* const listener, Call* c)
 
 void ListenersBase::queue1p_void (void* const listener, Call* c)
 {
+  VF_TRACE_SCOPE ("Listeners::queue1");
+
   ReadWriteMutex::ScopedReadLockType lock (m_groups_mutex);
 
   // can't be const iterator because queue() might cause called functors
@@ -707,6 +719,8 @@ void ListenersBase::queue1p_void (void* const listener, Call* c)
 void ListenersBase::updatep (void const* const member,
                              const size_t bytes, Call::Ptr cp)
 {
+  VF_TRACE_SCOPE ("Listeners::update");
+
   Call* c = cp;
 
   ReadWriteMutex::ScopedReadLockType lock (m_groups_mutex);
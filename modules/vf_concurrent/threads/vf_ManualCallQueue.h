@@ -75,7 +75,7 @@
     are put into the queue after it is closed, it will generate an exception so
     you can track it down.
 
-    @see CallQueue
+    @see CallQueue, RealtimeChecker
 
     @ingroup vf_concurrent
 */
@@ -43,6 +43,8 @@ int ParallelFor::getNumberOfThreads () const
 
 void ParallelFor::doLoop (int numberOfIterations, Iteration& iteration)
 {
+  VF_TRACE_SCOPE ("ParallelFor::loop");
+
   if (numberOfIterations > 1)
   {
     int const numberOfThreads = m_pool.getNumberOfThreads ();
@@ -66,6 +68,8 @@ void ParallelFor::doLoop (int numberOfIterations, Iteration& iteration)
     // Also use the caller's thread to run the loop body.
     loopState->forLoopBody ();
 
+    RealtimeChecker::check ("ParallelFor::loop");
+
     m_finishedEvent.wait ();
   }
   else if (numberOfIterations == 1)
@@ -202,6 +202,8 @@ private:
 
     void forLoopBody ()
     {
+      VF_TRACE_SCOPE ("ParallelFor::body");
+
       for (;;)
       {
         // Request a loop index to process.
@@ -373,6 +375,8 @@ private:
 
     void forLoopBody ()
     {
+      VF_TRACE_SCOPE ("ParallelFor::body");
+
       Iterator* iterator = m_factory (m_allocator);
 
       for (;;)
@@ -416,6 +420,8 @@ private:
 private:
   void doLoop (int numberOfIterations, Factory& factory)
   {
+    VF_TRACE_SCOPE ("ParallelFor::loop");
+
     if (numberOfIterations > 1)
     {
       int const numberOfThreads = m_pool.getNumberOfThreads ();
@@ -443,6 +449,8 @@ private:
       // Also use the caller's thread to run the loop body.
       loopState->forLoopBody ();
 
+      RealtimeChecker::check ("ParallelFor::loop");
+
       m_finishedEvent.wait ();
     }
     else if (numberOfIterations == 1)
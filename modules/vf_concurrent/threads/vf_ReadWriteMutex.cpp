@@ -30,7 +30,26 @@
 */
 /*============================================================================*/
 
+namespace
+{
+
+// Used by every ReadWriteMutex without sites of its own.
+//
+ContentionProfiler::Site readSite ("ReadWriteMutex::enterRead");
+ContentionProfiler::Site writeSite ("ReadWriteMutex::enterWrite");
+
+}
+
 ReadWriteMutex::ReadWriteMutex () noexcept
+  : m_readSite (readSite)
+  , m_writeSite (writeSite)
+{
+}
+
+ReadWriteMutex::ReadWriteMutex (ContentionProfiler::Site& readSite,
+                                ContentionProfiler::Site& writeSite) noexcept
+  : m_readSite (readSite)
+  , m_writeSite (writeSite)
 {
 }
 
@@ -40,6 +59,8 @@ ReadWriteMutex::~ReadWriteMutex () noexcept
 
 void ReadWriteMutex::enterRead () const noexcept
 {
+  RealtimeChecker::check ("ReadWriteMutex::enterRead");
+
   for (;;)
   {
     // attempt the lock optimistically
@@ -55,6 +76,8 @@ void ReadWriteMutex::enterRead () const noexcept
 
       // block until the writer is done
       {
+        ContentionProfiler::ScopedBlock block (m_readSite);
+
         CriticalSection::ScopedLockType lock (m_mutex);
       }
 
@@ -65,6 +88,8 @@ void ReadWriteMutex::enterRead () const noexcept
       break;
     }
   }
+
+  m_readSite.addAcquisition ();
 }
 
 void ReadWriteMutex::exitRead () const noexcept
@@ -74,12 +99,27 @@ void ReadWriteMutex::exitRead () const noexcept
 
 void ReadWriteMutex::enterWrite () const noexcept
 {
+  RealtimeChecker::check ("ReadWriteMutex::enterWrite");
+
   // Optimistically acquire the write lock.
   m_writes->addref ();
 
   // Go for the mutex.
   // Another writer might block us here.
+#if VF_USE_CONTENTION_PROFILER
+  // An acquisition which waits for the mutex and then for
+  // readers is counted as contended once, from the start.
+  int64 const startTicks = CpuTicks::getTicks ();
+
+  bool const blocked = ! m_mutex.tryEnter ();
+
+  if (blocked)
+    m_mutex.enter ();
+#else
   m_mutex.enter ();
+#endif
+
+  m_writeSite.addAcquisition ();
 
   // Only one competing writer will get here,
   // but we don't know who, so we have to drain
@@ -88,13 +128,23 @@ void ReadWriteMutex::enterWrite () const noexcept
   //
   if (m_readers->isSignaled ())
   {
-    SpinDelay delay; 
+#if VF_USE_CONTENTION_PROFILER
+    SpinDelay delay (m_writeSite, startTicks);
+#else
+    SpinDelay delay;
+#endif
     do
     {
       delay.pause ();
     }
     while (m_readers->isSignaled ());
   }
+#if VF_USE_CONTENTION_PROFILER
+  else if (blocked)
+  {
+    m_writeSite.addContention (0, 0, CpuTicks::getTicks () - startTicks);
+  }
+#endif
 }
 
 void ReadWriteMutex::exitWrite () const noexcept
@@ -117,8 +117,22 @@ public:
   /** Provides the type of scoped write lock to use with a ReadWriteMutex. */
   typedef GenericScopedWriteLock <ReadWriteMutex> ScopedWriteLockType;
 
-  /** Create a ReadWriteMutex */
+  /** Create a ReadWriteMutex.
+
+      Contention is recorded in the sites shared by every ReadWriteMutex
+      which is not given its own.
+  */
   ReadWriteMutex () noexcept;
+
+  /** Create a ReadWriteMutex which records contention in its own sites.
+
+      The sites must outlive the mutex. See ContentionProfiler.
+
+      @param readSite  The site for enterRead().
+      @param writeSite The site for enterWrite().
+  */
+  ReadWriteMutex (ContentionProfiler::Site& readSite,
+                  ContentionProfiler::Site& writeSite) noexcept;
   
   /** Destroy a ReadWriteMutex
 
@@ -148,6 +162,9 @@ public:
   void exitWrite () const noexcept;
 
 private:
+  ContentionProfiler::Site& m_readSite;
+  ContentionProfiler::Site& m_writeSite;
+
   CriticalSection m_mutex;
 
   mutable CacheLine::Padded <AtomicCounter> m_writes;
@@ -0,0 +1,246 @@
+/*============================================================================*/
+/*
+  VFLib: https://github.com/vinniefalco/VFLib
+
+  Copyright (C) 2008 by Vinnie Falco <vinnie.falco@gmail.com>
+
+  This library contains portions of other open source products covered by
+  separate licenses. Please see the corresponding source files for specific
+  terms.
+  
+  VFLib is provided under the terms of The MIT License (MIT):
+
+  Permission is hereby granted, free of charge, to any person obtaining a copy
+  of this software and associated documentation files (the "Software"), to deal
+  in the Software without restriction, including without limitation the rights
+  to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+  copies of the Software, and to permit persons to whom the Software is
+  furnished to do so, subject to the following conditions:
+
+  The above copyright notice and this permission notice shall be included in
+  all copies or substantial portions of the Software.
+
+  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+  FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+  IN THE SOFTWARE.
+*/
+/*============================================================================*/
+
+TaskGraph::TaskGraph (ThreadGroup& group)
+  : m_group (group)
+{
+}
+
+TaskGraph::~TaskGraph ()
+{
+  clear ();
+}
+
+void TaskGraph::clear ()
+{
+  // Can't modify a running graph.
+  jassert (! m_running.isSignaled ());
+
+  for (std::size_t i = 0; i < m_nodes.size (); ++i)
+    delete m_nodes [i];
+
+  m_nodes.clear ();
+}
+
+int TaskGraph::getNumberOfNodes () const
+{
+  return int (m_nodes.size ());
+}
+
+TaskGraph::Node* TaskGraph::addNode (Node* node)
+{
+  // Can't modify a running graph.
+  jassert (! m_running.isSignaled ());
+
+  m_nodes.push_back (node);
+
+  return node;
+}
+
+void TaskGraph::precede (Node* before, Node* after)
+{
+  // Can't modify a running graph.
+  jassert (! m_running.isSignaled ());
+
+  jassert (before != after);
+
+  before->m_successors.push_back (after);
+
+  ++after->m_numberOfPredecessors;
+}
+
+void TaskGraph::checkForCycles () const
+{
+  // Kahn's algorithm: if a topological order does
+  // not visit every node, there must be a cycle.
+  std::vector <Node*> ready;
+  std::map <Node const*, int> counts;
+
+  for (std::size_t i = 0; i < m_nodes.size (); ++i)
+  {
+    Node* const node = m_nodes [i];
+
+    counts [node] = node->m_numberOfPredecessors;
+
+    if (node->m_numberOfPredecessors == 0)
+      ready.push_back (node);
+  }
+
+  std::size_t visited = 0;
+
+  while (! ready.empty ())
+  {
+    Node* const node = ready.back ();
+    ready.pop_back ();
+
+    ++visited;
+
+    for (std::size_t i = 0; i < node->m_successors.size (); ++i)
+    {
+      Node* const successor = node->m_successors [i];
+
+      if (--counts [successor] == 0)
+        ready.push_back (successor);
+    }
+  }
+
+  if (visited != m_nodes.size ())
+  {
+    Throw (Error ().fail (__FILE__, __LINE__,
+      TRANS ("the task graph contains a cycle"), Error::badParameter));
+  }
+}
+
+Future <void> TaskGraph::start ()
+{
+  checkForCycles ();
+
+  // Can't run the graph concurrently with itself.
+  jassert (! m_running.isSignaled ());
+  m_running.signal ();
+
+  m_promise = Promise <void> ();
+  if (m_failed.isSignaled ())
+    m_failed.reset ();
+  m_error = Error ();
+  m_error.willBeReported ();
+
+  Future <void> future = m_promise.getFuture ();
+
+  if (! m_nodes.empty ())
+  {
+    m_remaining = int (m_nodes.size ());
+
+    std::vector <Node*> roots;
+
+    for (std::size_t i = 0; i < m_nodes.size (); ++i)
+    {
+      Node* const node = m_nodes [i];
+
+      node->m_pending = node->m_numberOfPredecessors;
+
+      if (node->m_numberOfPredecessors == 0)
+        roots.push_back (node);
+    }
+
+    // Post the roots after every counter is reset,
+    // since running nodes will decrement them.
+    for (std::size_t i = 0; i < roots.size (); ++i)
+      m_group.call (1, &TaskGraph::execute, this, roots [i]);
+  }
+  else
+  {
+    finish ();
+  }
+
+  return future;
+}
+
+void TaskGraph::run ()
+{
+  start ().get ();
+}
+
+void TaskGraph::execute (Node* node)
+{
+  do
+  {
+    if (! m_failed.isSignaled ())
+    {
+      try
+      {
+        (*node) ();
+      }
+      catch (Error& e)
+      {
+        if (m_failed.trySignal ())
+          m_error = e;
+      }
+      catch (std::exception& e)
+      {
+        if (m_failed.trySignal ())
+          m_error = Error ().fail (__FILE__, __LINE__,
+            String (e.what ()), Error::exception);
+      }
+      catch (...)
+      {
+        if (m_failed.trySignal ())
+          m_error = Error ().fail (__FILE__, __LINE__, Error::exception);
+      }
+    }
+
+    // Continue on this thread with the first successor that becomes
+    // runnable, and post the rest to the group.
+    Node* next = nullptr;
+
+    for (std::size_t i = 0; i < node->m_successors.size (); ++i)
+    {
+      Node* const successor = node->m_successors [i];
+
+      if (--successor->m_pending == 0)
+      {
+        if (next == nullptr)
+          next = successor;
+        else
+          m_group.call (1, &TaskGraph::execute, this, successor);
+      }
+    }
+
+    // The graph may be destroyed once the last node finishes.
+    if (--m_remaining == 0)
+    {
+      jassert (next == nullptr);
+
+      finish ();
+    }
+
+    node = next;
+  }
+  while (node != nullptr);
+}
+
+void TaskGraph::finish ()
+{
+  // Take copies, since a continuation may restart or destroy the graph.
+  Promise <void> promise (m_promise);
+  Error error (m_error);
+  bool const failed = m_failed.isSignaled ();
+
+  m_running.reset ();
+
+  if (failed)
+    promise.setError (error);
+  else
+    promise.setValue ();
+
+  error.willBeReported ();
+}
@@ -0,0 +1,227 @@
+/*============================================================================*/
+/*
+  VFLib: https://github.com/vinniefalco/VFLib
+
+  Copyright (C) 2008 by Vinnie Falco <vinnie.falco@gmail.com>
+
+  This library contains portions of other open source products covered by
+  separate licenses. Please see the corresponding source files for specific
+  terms.
+  
+  VFLib is provided under the terms of The MIT License (MIT):
+
+  Permission is hereby granted, free of charge, to any person obtaining a copy
+  of this software and associated documentation files (the "Software"), to deal
+  in the Software without restriction, including without limitation the rights
+  to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+  copies of the Software, and to permit persons to whom the Software is
+  furnished to do so, subject to the following conditions:
+
+  The above copyright notice and this permission notice shall be included in
+  all copies or substantial portions of the Software.
+
+  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+  FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+  IN THE SOFTWARE.
+*/
+/*============================================================================*/
+
+#ifndef VF_TASKGRAPH_VFHEADER
+#define VF_TASKGRAPH_VFHEADER
+
+/*============================================================================*/
+/**
+  A directed acyclic graph of tasks executed on a ThreadGroup.
+
+  Each node in the graph holds a functor. Edges express dependencies: a node
+  runs only after all of its predecessors have finished. Nodes whose
+  dependencies are satisfied run in parallel on the threads of the group.
+  When a node finishes, the first successor it makes runnable is executed on
+  the same thread to avoid a hand-off, and the remaining ones are posted to
+  the group.
+
+  The graph is built once and may be run many times:
+
+  @code
+
+  TaskGraph graph;
+
+  TaskGraph::Node* decode  = graph.add (&Renderer::decode, &renderer);
+  TaskGraph::Node* layout  = graph.add (&Renderer::layout, &renderer);
+  TaskGraph::Node* raster  = graph.add (&Renderer::rasterize, &renderer);
+
+  graph.precede (decode, raster);
+  graph.precede (layout, raster);
+
+  // Deliver the completion to the message thread.
+  graph.start ().thenf (guiCallQueue, vf::bind (&Renderer::frameDone, &renderer, vf::_1));
+
+  @endcode
+
+  If a node throws an Error, the nodes which have not started yet are
+  skipped and the future returned by start() fails with that Error.
+
+  @note It is undefined to modify the graph or to destroy it while it is
+        running.
+
+  @see Future, ThreadGroup, ParallelFor
+
+  @ingroup vf_concurrent
+*/
+class TaskGraph : Uncopyable
+{
+public:
+  typedef ThreadGroup::AllocatorType AllocatorType;
+
+  /** A task in the graph.
+  */
+  class Node
+    : public AllocatedBy <AllocatorType>
+    , Uncopyable
+  {
+  public:
+    virtual ~Node () { }
+
+  protected:
+    Node () : m_numberOfPredecessors (0)
+    {
+    }
+
+  private:
+    friend class TaskGraph;
+
+    virtual void operator() () = 0;
+
+    int m_numberOfPredecessors;
+    Atomic <int> m_pending;
+    std::vector <Node*> m_successors;
+  };
+
+  /** Create an empty graph.
+
+      @param group The ThreadGroup to run tasks on. If this is omitted then
+                   the global ThreadGroup is used.
+  */
+  explicit TaskGraph (ThreadGroup& group = *GlobalThreadGroup::getInstance ());
+
+  ~TaskGraph ();
+
+  /** Remove all nodes from the graph.
+  */
+  void clear ();
+
+  /** Determine the number of nodes in the graph.
+  */
+  int getNumberOfNodes () const;
+
+  /** Add a node to the graph.
+
+      @param f The functor to call when the node runs.
+
+      @return The new node, owned by the graph.
+  */
+  /** @{ */
+  template <class Functor>
+  Node* addf (Functor const& f)
+  {
+    return addNode (new (m_group.getAllocator ()) NodeType <Functor> (f));
+  }
+
+  template <class Fn>
+  Node* add (Fn f)
+    { return addf (vf::bind (f)); }
+
+  template <class Fn, class T1>
+  Node* add (Fn f, T1 t1)
+    { return addf (vf::bind (f, t1)); }
+
+  template <class Fn, class T1, class T2>
+  Node* add (Fn f, T1 t1, T2 t2)
+    { return addf (vf::bind (f, t1, t2)); }
+
+  template <class Fn, class T1, class T2, class T3>
+  Node* add (Fn f, T1 t1, T2 t2, T3 t3)
+    { return addf (vf::bind (f, t1, t2, t3)); }
+
+  template <class Fn, class T1, class T2, class T3, class T4>
+  Node* add (Fn f, T1 t1, T2 t2, T3 t3, T4 t4)
+    { return addf (vf::bind (f, t1, t2, t3, t4)); }
+
+  template <class Fn, class T1, class T2, class T3, class T4, class T5>
+  Node* add (Fn f, T1 t1, T2 t2, T3 t3, T4 t4, T5 t5)
+    { return addf (vf::bind (f, t1, t2, t3, t4, t5)); }
+
+  template <class Fn, class T1, class T2, class T3, class T4, class T5, class T6>
+  Node* add (Fn f, T1 t1, T2 t2, T3 t3, T4 t4, T5 t5, T6 t6)
+    { return addf (vf::bind (f, t1, t2, t3, t4, t5, t6)); }
+
+  template <class Fn, class T1, class T2, class T3, class T4, class T5, class T6, class T7>
+  Node* add (Fn f, T1 t1, T2 t2, T3 t3, T4 t4, T5 t5, T6 t6, T7 t7)
+    { return addf (vf::bind (f, t1, t2, t3, t4, t5, t6, t7)); }
+
+  template <class Fn, class T1, class T2, class T3, class T4, class T5, class T6, class T7, class T8>
+  Node* add (Fn f, T1 t1, T2 t2, T3 t3, T4 t4, T5 t5, T6 t6, T7 t7, T8 t8)
+    { return addf (vf::bind (f, t1, t2, t3, t4, t5, t6, t7, t8)); }
+  /** @} */
+
+  /** Add a dependency.
+
+      @param before The node which must finish first.
+
+      @param after The node which runs after `before` finishes.
+  */
+  void precede (Node* before, Node* after);
+
+  /** Start running the graph.
+
+      All nodes without predecessors are posted to the ThreadGroup
+      immediately. An Error is thrown if the graph contains a cycle.
+
+      @return A future which becomes ready when every node has finished.
+  */
+  Future <void> start ();
+
+  /** Run the graph and wait for it to finish.
+
+      If a node threw an Error, it is rethrown here.
+
+      @note Calling this from a thread in the same ThreadGroup can deadlock
+            if there are not enough other threads to run the graph.
+  */
+  void run ();
+
+private:
+  template <class Functor>
+  class NodeType : public Node, LeakChecked <NodeType <Functor> >
+  {
+  public:
+    explicit NodeType (Functor const& f) : m_f (f) { }
+    void operator() () { m_f (); }
+
+  private:
+    Functor m_f;
+  };
+
+  Node* addNode (Node* node);
+
+  void checkForCycles () const;
+
+  void execute (Node* node);
+
+  void finish ();
+
+private:
+  ThreadGroup& m_group;
+  std::vector <Node*> m_nodes;
+  AtomicFlag m_running;
+  Atomic <int> m_remaining;
+  AtomicFlag m_failed;
+  Error m_error;
+  Promise <void> m_promise;
+};
+
+#endif
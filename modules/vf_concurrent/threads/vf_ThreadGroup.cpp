@@ -66,7 +66,12 @@ void ThreadGroup::Worker::run ()
 
     jassert (work != nullptr);
 
-    work->operator() (this);
+    {
+      VF_TRACE_SCOPE ("ThreadGroup::Work");
+      VF_TRACE_FLOW_END ("ThreadGroup", work->m_flowId);
+
+      work->operator() (this);
+    }
 
     delete work;
   }
@@ -75,14 +80,17 @@ void ThreadGroup::Worker::run ()
 
 //==============================================================================
 
-ThreadGroup::ThreadGroup (int numberOfThreads)
+ThreadGroup::ThreadGroup (int numberOfThreads, String name)
   : m_numberOfThreads (numberOfThreads)
-  , m_semaphore (0)
+  , m_waitSite (name + "::wait")
+  , m_queueSite (name + "::m_queue")
+  , m_semaphore (0, m_waitSite)
+  , m_queue (m_queueSite)
 {
   for (int i = 0; i++ < numberOfThreads; )
   {
     String s;
-    s << "ThreadGroup (" << i << ")";
+    s << name << " (" << i << ")";
 
     m_threads.push_front (new Worker (s, *this));
   }
@@ -108,8 +116,25 @@ ThreadGroup::~ThreadGroup ()
       break;
   }
 
-  // There must not be pending work!
-  jassert (m_queue.pop_front () == nullptr);
+  // Run work that the workers never got to. This happens with ParallelFor,
+  // which posts a loop body for every thread, when other threads claim all
+  // the iterations before a posted body runs. The body then finds nothing
+  // to do and releases the loop state.
+  for (;;)
+  {
+    Work* work = m_queue.pop_front ();
+
+    if (work != nullptr)
+    {
+      work->operator() (nullptr);
+
+      delete work;
+    }
+    else
+    {
+      break;
+    }
+  }
 }
 
 int ThreadGroup::getNumberOfThreads () const
@@ -51,9 +51,19 @@ public:
       @param numberOfThreads The number of threads in the group. This must be
                              greater than zero. If this parameter is omitted,
                              one thread is created per available CPU.
+
+      @param name            The name of the group, used to name its threads
+                             and its ContentionProfiler sites.
   */
-  explicit ThreadGroup (int numberOfThreads = SystemStats::getNumCpus ());
+  explicit ThreadGroup (int numberOfThreads = SystemStats::getNumCpus (),
+                        String name = "ThreadGroup");
+
+  /** Stop the threads.
 
+      Work still in the queue after the threads exit is run on the calling
+      thread. ParallelFor relies on this: it posts a loop body for every
+      thread, and a body may still be queued after the loop returns.
+  */
   ~ThreadGroup ();
 
   /** Allocator access.
@@ -89,9 +99,19 @@ public:
     if (maxThreads != -1 && maxThreads < numberOfThreads)
       numberOfThreads = maxThreads;
 
+    VF_TRACE_SCOPE ("ThreadGroup::call");
+
     while (numberOfThreads--)
     {
-      m_queue.push_front (new (getAllocator ()) WorkType <Functor> (f));
+      Work* const work = new (getAllocator ()) WorkType <Functor> (f);
+
+#if VF_USE_TRACE
+      work->m_flowId = Trace::createFlowId ();
+#endif
+
+      VF_TRACE_FLOW_START ("ThreadGroup", work->m_flowId);
+
+      m_queue.push_front (work);
       m_semaphore.signal ();
     }
   }
@@ -168,11 +188,19 @@ private:
              , public AllocatedBy <AllocatorType>
   {
   public:
+#if VF_USE_TRACE
+    Work () : m_flowId (0) { }
+#endif
+
     virtual ~Work () { }
 
     /* The worker is passed in so we can make it quit later.
     */
     virtual void operator() (Worker* worker) = 0;
+
+#if VF_USE_TRACE
+    int64 m_flowId;
+#endif
   };
 
   template <class Functor>
@@ -199,6 +227,8 @@ private:
 
 private:
   int const m_numberOfThreads;
+  ContentionProfiler::Site m_waitSite;
+  ContentionProfiler::Site m_queueSite;
   Semaphore m_semaphore;
   AllocatorType m_allocator;
   LockFreeStack <Work> m_queue;
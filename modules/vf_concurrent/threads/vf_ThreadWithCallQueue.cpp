@@ -36,6 +36,7 @@ ThreadWithCallQueue::ThreadWithCallQueue (String name)
   , m_calledStart (false)
   , m_calledStop (false)
   , m_shouldStop (false)
+  , m_spinTicks (0)
 {
 }
 
@@ -117,6 +118,72 @@ void ThreadWithCallQueue::interrupt ()
   call (Function <void (void)>::None ());
 }
 
+void ThreadWithCallQueue::setSpinWindow (int microseconds)
+{
+  jassert (microseconds >= 0);
+
+  m_spinWindow = jmax (microseconds, 0);
+}
+
+int ThreadWithCallQueue::getNumberOfWakeups () const
+{
+  return m_numberOfWakeups.get ();
+}
+
+int ThreadWithCallQueue::getNumberOfSpuriousWakeups () const
+{
+  return m_numberOfSpuriousWakeups.get ();
+}
+
+int ThreadWithCallQueue::getNumberOfSpinHits () const
+{
+  return m_numberOfSpinHits.get ();
+}
+
+// Spin until interrupted or the window expires.
+//
+// While the thread spins it is in the Run state, so a producer's
+// interrupt() is a single atomic operation instead of a notify.
+//
+bool ThreadWithCallQueue::spin ()
+{
+  int const window = m_spinWindow.get ();
+
+  // On a single processor, spinning only delays the producer.
+  if (window == 0 || SystemStats::getNumCpus () < 2)
+    return false;
+
+  int64 const maxTicks = Time::secondsToHighResolutionTicks (window / 1000000.0);
+
+  if (m_spinTicks <= 0 || m_spinTicks > maxTicks)
+    m_spinTicks = maxTicks;
+
+  int64 const start = Time::getHighResolutionTicks ();
+
+  SpinDelay delay;
+
+  do
+  {
+    if (m_thread.isInterrupted ())
+    {
+      // Work arrived, so spinning paid off.
+      m_spinTicks = maxTicks;
+
+      ++m_numberOfSpinHits;
+
+      return interruptionPoint ();
+    }
+
+    delay.pause ();
+  }
+  while (Time::getHighResolutionTicks () - start < m_spinTicks);
+
+  // Spin less next time, but never stop entirely.
+  m_spinTicks = jmax (m_spinTicks / 2, maxTicks / 16);
+
+  return false;
+}
+
 void ThreadWithCallQueue::signal ()
 {
   m_thread.interrupt ();
@@ -135,9 +202,16 @@ void ThreadWithCallQueue::run ()
 {
   m_init ();
 
+  bool woke = false;
+
   for (;;)
   {
-    CallQueue::synchronize ();
+    bool const didSomething = CallQueue::synchronize ();
+
+    if (woke && !didSomething)
+      ++m_numberOfSpuriousWakeups;
+
+    woke = false;
 
     if (m_shouldStop)
       break;
@@ -149,7 +223,16 @@ void ThreadWithCallQueue::run ()
       interrupted = interruptionPoint ();
 
     if (!interrupted)
+      interrupted = spin ();
+
+    if (!interrupted)
+    {
       m_thread.wait ();
+
+      ++m_numberOfWakeups;
+
+      woke = true;
+    }
   }
 
   m_exit ();
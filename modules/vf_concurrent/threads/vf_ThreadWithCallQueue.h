@@ -49,6 +49,14 @@
   initialization function is executed on the thread. When the thread exits,
   a user-defined exit function may be executed on the thread.
 
+  Waking a sleeping thread costs a system call and a context switch for
+  every post to an idle queue. To avoid this when functors arrive in quick
+  succession, the thread can spin for a short window before it sleeps; see
+  setSpinWindow(). A post which arrives during the spin only changes the
+  interrupt state, and bursts are drained without the thread sleeping in
+  between. The window adapts: it shrinks while spins go unrewarded and
+  returns to the full length as soon as one succeeds.
+
   @see CallQueue
 
   @ingroup vf_concurrent
@@ -127,7 +135,35 @@ public:
   */
   void interrupt ();
 
+  /** Set how long the thread spins before sleeping.
+
+      Spinning trades CPU time for wakeup latency, and is only worthwhile
+      for threads which receive frequent small work items. The thread never
+      spins on a single processor system. This may be called at any time,
+      from any thread.
+
+      @param microseconds The longest spin, or zero to sleep immediately.
+                          The default is zero.
+  */
+  void setSpinWindow (int microseconds);
+
+  /** Determine the number of times the thread woke up from sleeping.
+  */
+  int getNumberOfWakeups () const;
+
+  /** Determine the number of wakeups which found nothing to do.
+  */
+  int getNumberOfSpuriousWakeups () const;
+
+  /** Determine the number of times work arrived while spinning.
+
+      Each of these is a wakeup that did not require the thread to sleep.
+  */
+  int getNumberOfSpinHits () const;
+
 private:
+  bool spin ();
+
   void signal ();
   void reset ();
 
@@ -143,6 +179,12 @@ private:
   idle_t m_idle;
   init_t m_init;
   exit_t m_exit;
+
+  Atomic <int> m_spinWindow;
+  int64 m_spinTicks;
+  Atomic <int> m_numberOfWakeups;
+  Atomic <int> m_numberOfSpuriousWakeups;
+  Atomic <int> m_numberOfSpinHits;
 };
 
 #endif
@@ -49,23 +49,28 @@ namespace vf
 {
 #if VF_USE_BOOST
 #include "memory/vf_FifoFreeStoreWithTLS.cpp"
-#else
-#include "memory/vf_FifoFreeStoreWithoutTLS.cpp"
 #endif
+#include "memory/vf_FifoFreeStoreWithoutTLS.cpp"
 #include "memory/vf_GlobalPagedFreeStore.cpp"
 #include "memory/vf_PagedFreeStore.cpp"
 
 #include "threads/vf_CallQueue.cpp"
+#include "threads/vf_CallQueueMetrics.cpp"
+#include "threads/vf_CallQueueTimer.cpp"
 #include "threads/vf_ConcurrentObject.cpp"
+#include "threads/vf_Future.cpp"
 #include "threads/vf_Listeners.cpp"
 #include "threads/vf_ManualCallQueue.cpp"
 #include "threads/vf_MessageThread.cpp"
 #include "threads/vf_ParallelFor.cpp"
 #include "threads/vf_ReadWriteMutex.cpp"
+#include "threads/vf_TaskGraph.cpp"
 #include "threads/vf_ThreadGroup.cpp"
 #include "threads/vf_ThreadWithCallQueue.cpp"
 
 #include "threads/vf_GuiCallQueue.cpp"
+
+#include "diagnostic/vf_ConcurrentBenchmark.cpp"
 }
 
 #if JUCE_MSVC
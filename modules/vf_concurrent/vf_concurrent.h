@@ -144,6 +144,29 @@
 
 #include "modules/juce_gui_basics/juce_gui_basics.h"
 
+/* C++20 coroutine support is detected automatically. Set this
+   to 0 in AppConfig.h to leave it out even when available.
+*/
+#ifndef VF_COMPILER_SUPPORTS_COROUTINES
+# if defined (__cpp_impl_coroutine) && defined (__has_include)
+#  if __has_include (<coroutine>)
+#   define VF_COMPILER_SUPPORTS_COROUTINES 1
+#  endif
+# endif
+#endif
+
+#ifndef VF_COMPILER_SUPPORTS_COROUTINES
+#define VF_COMPILER_SUPPORTS_COROUTINES 0
+#endif
+
+#if VF_COMPILER_SUPPORTS_COROUTINES
+#include <coroutine>
+#include <exception>
+#include <optional>
+#include <type_traits>
+#include <utility>
+#endif
+
 namespace vf
 {
 
@@ -151,9 +174,8 @@ namespace vf
 #include "memory/vf_FifoFreeStore.h"
 #if VF_USE_BOOST
 #include "memory/vf_FifoFreeStoreWithTLS.h"
-#else
-#include "memory/vf_FifoFreeStoreWithoutTLS.h"
 #endif
+#include "memory/vf_FifoFreeStoreWithoutTLS.h"
 #include "memory/vf_GlobalFifoFreeStore.h"
 #include "memory/vf_GlobalPagedFreeStore.h"
 #include "memory/vf_PagedFreeStore.h"
@@ -161,18 +183,25 @@ namespace vf
 #include "threads/vf_ReadWriteMutex.h"
 #include "threads/vf_ThreadGroup.h"
 
+#include "threads/vf_CallQueueMetrics.h"
 #include "threads/vf_CallQueue.h"
+#include "threads/vf_CallQueueTimer.h"
 #include "threads/vf_ConcurrentObject.h"
 #include "threads/vf_ConcurrentState.h"
+#include "threads/vf_Future.h"
+#include "threads/vf_Coroutine.h"
 #include "threads/vf_GlobalThreadGroup.h"
 #include "threads/vf_Listeners.h"
 #include "threads/vf_ManualCallQueue.h"
 #include "threads/vf_ParallelFor.h"
+#include "threads/vf_TaskGraph.h"
 #include "threads/vf_ThreadWithCallQueue.h"
 
 #include "threads/vf_GuiCallQueue.h"
 
 #include "threads/vf_MessageThread.h"
+
+#include "diagnostic/vf_ConcurrentBenchmark.h"
 }
 
 #endif
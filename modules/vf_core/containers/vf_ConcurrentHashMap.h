@@ -0,0 +1,348 @@
+/*============================================================================*/
+/*
+  VFLib: https://github.com/vinniefalco/VFLib
+
+  Copyright (C) 2008 by Vinnie Falco <vinnie.falco@gmail.com>
+
+  This library contains portions of other open source products covered by
+  separate licenses. Please see the corresponding source files for specific
+  terms.
+  
+  VFLib is provided under the terms of The MIT License (MIT):
+
+  Permission is hereby granted, free of charge, to any person obtaining a copy
+  of this software and associated documentation files (the "Software"), to deal
+  in the Software without restriction, including without limitation the rights
+  to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+  copies of the Software, and to permit persons to whom the Software is
+  furnished to do so, subject to the following conditions:
+
+  The above copyright notice and this permission notice shall be included in
+  all copies or substantial portions of the Software.
+
+  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+  FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+  IN THE SOFTWARE.
+*/
+/*============================================================================*/
+
+#ifndef VF_CONCURRENTHASHMAP_VFHEADER
+#define VF_CONCURRENTHASHMAP_VFHEADER
+
+#include "vf_FlatHashMap.h"
+#include "../memory/vf_MemoryAlignment.h"
+#include "../threads/vf_SpinDelay.h"
+
+//==============================================================================
+/**
+  Hash map which can be shared between threads.
+
+  The map is split into shards by hash, each one a FlatHashMap with its own
+  lock. Writers lock only the shard holding the key, so writers to different
+  shards do not contend.
+
+  Readers never lock. Each shard has a version number which a writer makes
+  odd while it changes the shard, and even again when it is done. A reader
+  notes the version, copies the value out, and tries again if the version
+  changed in the meantime. When the table of a shard doubles in size, the
+  old table is kept until the map is destroyed so that a reader which is
+  still looking at it does not touch freed memory. Deleted slots are
+  reclaimed within the same table, so only growth retires a table, and the
+  retired tables of a shard together are smaller than its current one. This
+  at most doubles the memory used.
+
+  Because readers may look at an element while it is being written and
+  throw the result away, the key and value types must be plain data, with
+  no constructors, destructors or pointers to owned memory. Use a
+  FlatHashMap protected by a lock, or ReadWriteMutex, for other types.
+
+  @code
+
+  ConcurrentHashMap <int, float> gains;
+
+  // On any thread
+  gains.set (channel, 0.5f);
+
+  // On the audio thread
+  float gain;
+  if (gains.find (channel, &gain))
+    applyGain (gain);
+
+  @endcode
+
+  @see FlatHashMap
+
+  @ingroup vf_core
+*/
+template <class KeyType,
+          class ValueType,
+          class HashFunctionType = HashFunction <KeyType>,
+          class AllocatorType = HeapAllocator>
+class ConcurrentHashMap : Uncopyable
+{
+public:
+  enum
+  {
+    defaultNumberOfShards = 16
+  };
+
+  /** Create an empty map.
+
+      @param numberOfShards The number of independently locked parts. This
+                            must be a power of two.
+  */
+  explicit ConcurrentHashMap (int numberOfShards = defaultNumberOfShards)
+    : m_shards (new Shard [numberOfShards])
+    , m_shardMask (uint32 (numberOfShards - 1))
+    , m_shardShift (getShardShift (numberOfShards))
+  {
+    jassert (isPowerOfTwo (numberOfShards));
+
+    for (int i = 0; i < numberOfShards; ++i)
+      m_shards [i].map.m_retainStorage = true;
+  }
+
+  ~ConcurrentHashMap ()
+  {
+    delete [] m_shards;
+  }
+
+  /** Find the value for a key.
+
+      This never blocks, although it may retry while a writer changes
+      the same shard.
+
+      @param key   The key to locate.
+      @param value Where to copy the value, if the key was found.
+
+      @return `true` if the key was found.
+  */
+  bool find (KeyType const& key, ValueType* value) const
+  {
+    uint32 const hash = m_hash (key);
+
+    Shard const& shard = getShard (hash);
+
+    SpinDelay delay;
+
+    for (;;)
+    {
+      int const version = shard.version.get ();
+
+      if ((version & 1) == 0)
+      {
+        ValueType const* const found = shard.map.findWithHash (key, hash);
+
+        ValueType copy;
+
+        if (found != nullptr)
+          copy = *found;
+
+        if (shard.version.get () == version)
+        {
+          if (found != nullptr)
+            *value = copy;
+
+          return found != nullptr;
+        }
+      }
+
+      delay.pause ();
+    }
+  }
+
+  /** Determine if a key exists.
+  */
+  bool contains (KeyType const& key) const
+  {
+    ValueType value;
+
+    return find (key, &value);
+  }
+
+  /** Add an element if the key does not already exist.
+
+      @return `true` if the element was added.
+  */
+  bool insert (KeyType const& key, ValueType const& value)
+  {
+    uint32 const hash = m_hash (key);
+
+    Shard& shard = getShard (hash);
+
+    CriticalSection::ScopedLockType lock (shard.mutex);
+
+    bool inserted;
+
+    if (shard.map.findWithHash (key, hash) == nullptr)
+    {
+      ScopedWrite write (shard);
+
+      shard.map.addWithHash (key, value, hash);
+
+      inserted = true;
+    }
+    else
+    {
+      inserted = false;
+    }
+
+    return inserted;
+  }
+
+  /** Add an element, or replace the value if the key exists.
+  */
+  void set (KeyType const& key, ValueType const& value)
+  {
+    uint32 const hash = m_hash (key);
+
+    Shard& shard = getShard (hash);
+
+    CriticalSection::ScopedLockType lock (shard.mutex);
+
+    ScopedWrite write (shard);
+
+    shard.map.setWithHash (key, value, hash);
+  }
+
+  /** Remove the element with a key.
+
+      @return `true` if the element was found.
+  */
+  bool remove (KeyType const& key)
+  {
+    uint32 const hash = m_hash (key);
+
+    Shard& shard = getShard (hash);
+
+    CriticalSection::ScopedLockType lock (shard.mutex);
+
+    bool removed;
+
+    if (shard.map.findWithHash (key, hash) != nullptr)
+    {
+      ScopedWrite write (shard);
+
+      removed = shard.map.removeWithHash (key, hash);
+    }
+    else
+    {
+      removed = false;
+    }
+
+    return removed;
+  }
+
+  /** Retrieve the number of elements.
+
+      When other threads are writing, this is only approximate.
+  */
+  int size () const
+  {
+    int total = 0;
+
+    for (uint32 i = 0; i <= m_shardMask; ++i)
+      total += m_shards [i].map.size ();
+
+    return total;
+  }
+
+  /** Remove all elements.
+
+      Elements added by other threads during the call may remain.
+  */
+  void clear ()
+  {
+    for (uint32 i = 0; i <= m_shardMask; ++i)
+    {
+      Shard& shard = m_shards [i];
+
+      CriticalSection::ScopedLockType lock (shard.mutex);
+
+      ScopedWrite write (shard);
+
+      shard.map.clear ();
+    }
+  }
+
+  /** Make room for a number of elements, spread evenly over the shards.
+  */
+  void reserve (int numberOfElements)
+  {
+    int const perShard = numberOfElements / int (m_shardMask + 1) + 1;
+
+    for (uint32 i = 0; i <= m_shardMask; ++i)
+    {
+      Shard& shard = m_shards [i];
+
+      CriticalSection::ScopedLockType lock (shard.mutex);
+
+      ScopedWrite write (shard);
+
+      shard.map.reserve (perShard);
+    }
+  }
+
+private:
+  typedef FlatHashMap <KeyType, ValueType, HashFunctionType, AllocatorType> MapType;
+
+  struct Shard
+  {
+    Atomic <int> version;
+    CriticalSection mutex;
+    MapType map;
+
+    // Keep shards on separate cache lines.
+    char pad [Memory::cacheLineAlignBytes];
+  };
+
+  // Makes the version odd for the duration of a change.
+  //
+  class ScopedWrite : Uncopyable
+  {
+  public:
+    explicit ScopedWrite (Shard& shard) : m_shard (shard)
+    {
+      ++m_shard.version;
+    }
+
+    ~ScopedWrite ()
+    {
+      ++m_shard.version;
+    }
+
+  private:
+    Shard& m_shard;
+  };
+
+  // The top bits of the hash choose the shard, since the low bits are
+  // used for the position within it. The shift is done in 64 bits so
+  // that a single shard, with a shift of 32, always picks shard zero.
+  //
+  inline Shard& getShard (uint32 hash) const
+  {
+    return m_shards [uint32 (uint64 (hash) >> m_shardShift)];
+  }
+
+  static int getShardShift (int numberOfShards)
+  {
+    int shift = 32;
+
+    while ((1 << (32 - shift)) < numberOfShards)
+      --shift;
+
+    return shift;
+  }
+
+private:
+  Shard* const m_shards;
+  uint32 const m_shardMask;
+  int const m_shardShift;
+  HashFunctionType m_hash;
+};
+
+#endif
@@ -0,0 +1,807 @@
+/*============================================================================*/
+/*
+  VFLib: https://github.com/vinniefalco/VFLib
+
+  Copyright (C) 2008 by Vinnie Falco <vinnie.falco@gmail.com>
+
+  This library contains portions of other open source products covered by
+  separate licenses. Please see the corresponding source files for specific
+  terms.
+  
+  VFLib is provided under the terms of The MIT License (MIT):
+
+  Permission is hereby granted, free of charge, to any person obtaining a copy
+  of this software and associated documentation files (the "Software"), to deal
+  in the Software without restriction, including without limitation the rights
+  to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+  copies of the Software, and to permit persons to whom the Software is
+  furnished to do so, subject to the following conditions:
+
+  The above copyright notice and this permission notice shall be included in
+  all copies or substantial portions of the Software.
+
+  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+  FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+  IN THE SOFTWARE.
+*/
+/*============================================================================*/
+
+#ifndef VF_FLATHASHMAP_VFHEADER
+#define VF_FLATHASHMAP_VFHEADER
+
+#include "../math/vf_MurmurHash.h"
+#include "../memory/vf_HeapAllocator.h"
+
+template <class KeyType, class ValueType, class HashFunctionType, class AllocatorType>
+class ConcurrentHashMap;
+
+//==============================================================================
+/**
+  The default hash function for FlatHashMap and ConcurrentHashMap.
+
+  Keys are hashed with Murmur::Hash over their bytes, so the key type must
+  not contain padding or pointers to the data that makes it unique. Strings
+  are hashed by their UTF-8 characters. Provide a specialization, or a
+  different HashFunctionType, for other keys.
+
+  @ingroup vf_core
+*/
+template <class KeyType>
+struct HashFunction
+{
+  inline uint32 operator() (KeyType const& key) const
+  {
+    uint32 hash;
+
+    Murmur::Hash (&key, sizeof (KeyType), 0, &hash);
+
+    return hash;
+  }
+};
+
+template <>
+struct HashFunction <String>
+{
+  inline uint32 operator() (String const& key) const
+  {
+    uint32 hash;
+
+    Murmur::Hash (key.toRawUTF8 (), int (key.getNumBytesAsUTF8 ()), 0, &hash);
+
+    return hash;
+  }
+};
+
+//==============================================================================
+/**
+  Hash map using open addressing in a single flat array.
+
+  Elements are stored directly in one array, with a parallel array of
+  control bytes. Each control byte records whether its slot is empty,
+  deleted, or full, and for full slots holds seven bits of the hash. A
+  lookup compares a group of sixteen control bytes at once, using SSE2 when
+  it is available, and only compares keys in the slots whose bits match.
+  Most lookups touch one group of control bytes and one slot.
+
+  The table grows by doubling when it is seven eighths full. Pointers to
+  values are invalidated by any insertion or removal.
+
+  @code
+
+  FlatHashMap <int, String> names;
+
+  names.set (1, "one");
+  names.set (2, "two");
+
+  if (String* name = names.find (1))
+    DBG (*name);
+
+  for (FlatHashMap <int, String>::Iterator iter (names); iter.next ();)
+    DBG (String (iter.getKey ()) << " = " << iter.getValue ());
+
+  @endcode
+
+  This object is not thread safe. See ConcurrentHashMap for a version
+  which can be shared between threads.
+
+  @param KeyType          The type of key. It must be copyable and have
+                          operator==.
+
+  @param ValueType        The type of value. It must be copyable, and default
+                          constructible in order to use getReference().
+
+  @param HashFunctionType A functor returning a uint32 hash for a key.
+
+  @param AllocatorType    The allocator for the table, with the same interface
+                          as HeapAllocator. Note that the free stores in
+                          vf_concurrent only serve blocks up to their page
+                          size, which limits the capacity of the table.
+
+  @ingroup vf_core
+*/
+template <class KeyType,
+          class ValueType,
+          class HashFunctionType = HashFunction <KeyType>,
+          class AllocatorType = HeapAllocator>
+class FlatHashMap : Uncopyable
+{
+public:
+  //============================================================================
+  /**
+    Iterates over the elements in an unspecified order.
+
+    @code
+
+    for (Map::Iterator iter (map); iter.next ();)
+      process (iter.getKey (), iter.getValue ());
+
+    @endcode
+  */
+  class Iterator
+  {
+  public:
+    explicit Iterator (FlatHashMap& map)
+      : m_map (map)
+      , m_index (-1)
+    {
+    }
+
+    /** Move to the next element.
+
+        @return `false` when there are no more elements.
+    */
+    bool next ()
+    {
+      if (m_map.m_storage != nullptr)
+      {
+        int8 const* const control = getControl (m_map.m_storage);
+
+        while (++m_index <= m_map.m_storage->mask)
+        {
+          if (isFull (control [m_index]))
+            return true;
+        }
+      }
+
+      return false;
+    }
+
+    KeyType const& getKey () const
+    {
+      return getSlots (m_map.m_storage) [m_index].key;
+    }
+
+    ValueType& getValue () const
+    {
+      return getSlots (m_map.m_storage) [m_index].value;
+    }
+
+  private:
+    FlatHashMap& m_map;
+    int m_index;
+  };
+
+  //============================================================================
+
+  FlatHashMap ()
+    : m_storage (nullptr)
+    , m_retired (nullptr)
+    , m_size (0)
+    , m_growthLeft (0)
+    , m_retainStorage (false)
+  {
+  }
+
+  ~FlatHashMap ()
+  {
+    destroyElements ();
+
+    freeStorage (m_storage);
+    freeStorage (m_retired);
+  }
+
+  /** Retrieve the number of elements.
+  */
+  int size () const noexcept
+  {
+    return m_size;
+  }
+
+  /** Determine if there are no elements.
+  */
+  bool isEmpty () const noexcept
+  {
+    return m_size == 0;
+  }
+
+  /** Retrieve the number of slots in the table.
+  */
+  int getCapacity () const noexcept
+  {
+    return m_storage != nullptr ? m_storage->mask + 1 : 0;
+  }
+
+  /** Make room for a number of elements without growing.
+  */
+  void reserve (int numberOfElements)
+  {
+    int capacity = groupSize;
+
+    while (getGrowth (capacity) < numberOfElements)
+      capacity *= 2;
+
+    if (capacity > getCapacity ())
+      rehash (capacity);
+  }
+
+  /** Remove all elements.
+
+      The capacity is kept.
+  */
+  void clear ()
+  {
+    destroyElements ();
+
+    if (m_storage != nullptr)
+    {
+      memset (getControl (m_storage), ctrlEmpty, m_storage->mask + 1 + groupSize);
+
+      m_growthLeft = getGrowth (m_storage->mask + 1);
+    }
+
+    m_size = 0;
+  }
+
+  /** Determine if a key exists.
+  */
+  bool contains (KeyType const& key) const
+  {
+    return findWithHash (key, m_hash (key)) != nullptr;
+  }
+
+  /** Find the value for a key.
+
+      @return A pointer to the value, or `nullptr` if the key was not found.
+  */
+  ValueType* find (KeyType const& key)
+  {
+    return const_cast <ValueType*> (findWithHash (key, m_hash (key)));
+  }
+
+  /** Find the value for a key.
+
+      @return A pointer to the value, or `nullptr` if the key was not found.
+  */
+  ValueType const* find (KeyType const& key) const
+  {
+    return findWithHash (key, m_hash (key));
+  }
+
+  /** Add an element if the key does not already exist.
+
+      @return `true` if the element was added.
+  */
+  bool insert (KeyType const& key, ValueType const& value)
+  {
+    return insertWithHash (key, value, m_hash (key));
+  }
+
+  /** Add an element, or replace the value if the key exists.
+  */
+  void set (KeyType const& key, ValueType const& value)
+  {
+    setWithHash (key, value, m_hash (key));
+  }
+
+  /** Retrieve the value for a key, adding a default value if necessary.
+  */
+  ValueType& getReference (KeyType const& key)
+  {
+    uint32 const hash = m_hash (key);
+
+    ValueType* value = const_cast <ValueType*> (findWithHash (key, hash));
+
+    if (value == nullptr)
+    {
+      int const index = addWithHash (key, ValueType (), hash);
+
+      value = &getSlots (m_storage) [index].value;
+    }
+
+    return *value;
+  }
+
+  /** Remove the element with a key.
+
+      @return `true` if the element was found.
+  */
+  bool remove (KeyType const& key)
+  {
+    return removeWithHash (key, m_hash (key));
+  }
+
+private:
+  template <class K, class V, class H, class A>
+  friend class ConcurrentHashMap;
+
+  enum
+  {
+    groupSize = 16,
+    slotAlignment = 16
+  };
+
+  // Control byte values. Full slots hold the low seven bits of
+  // the hash, so they are the only values with the high bit clear.
+  //
+  enum
+  {
+    ctrlEmpty = -128,
+    ctrlDeleted = -2,
+    ctrlSentinel = -1
+  };
+
+  struct Slot
+  {
+    Slot (KeyType const& key_, ValueType const& value_)
+      : key (key_)
+      , value (value_)
+    {
+    }
+
+    KeyType key;
+    ValueType value;
+  };
+
+  // The header of the single block holding the table. It is followed
+  // by the control bytes, with the first group repeated at the end so
+  // that a group can be loaded at any position, and then the slots.
+  //
+  struct Storage
+  {
+    Storage* next;
+    int mask;
+  };
+
+  //----------------------------------------------------------------------------
+
+  // A group of control bytes, compared all at once.
+  //
+  class Group
+  {
+  public:
+#if VF_COMPILER_SUPPORTS_SSE2
+    explicit Group (int8 const* control)
+      : m_control (_mm_loadu_si128 (reinterpret_cast <__m128i const*> (control)))
+    {
+    }
+
+    // Returns a bit for every byte equal to the value.
+    inline uint32 match (int8 value) const
+    {
+      return uint32 (_mm_movemask_epi8 (_mm_cmpeq_epi8 (_mm_set1_epi8 (value), m_control)));
+    }
+
+    inline uint32 matchEmptyOrDeleted () const
+    {
+      return uint32 (_mm_movemask_epi8 (_mm_cmpgt_epi8 (_mm_set1_epi8 (ctrlSentinel), m_control)));
+    }
+
+  private:
+    __m128i m_control;
+
+#else
+    explicit Group (int8 const* control)
+      : m_control (control)
+    {
+    }
+
+    inline uint32 match (int8 value) const
+    {
+      uint32 bits = 0;
+
+      for (int i = 0; i < groupSize; ++i)
+        if (m_control [i] == value)
+          bits |= uint32 (1) << i;
+
+      return bits;
+    }
+
+    inline uint32 matchEmptyOrDeleted () const
+    {
+      uint32 bits = 0;
+
+      for (int i = 0; i < groupSize; ++i)
+        if (m_control [i] < ctrlSentinel)
+          bits |= uint32 (1) << i;
+
+      return bits;
+    }
+
+  private:
+    int8 const* m_control;
+
+#endif
+  };
+
+  //----------------------------------------------------------------------------
+
+  static inline bool isFull (int8 control) noexcept
+  {
+    return control >= 0;
+  }
+
+  static inline int8 getH2 (uint32 hash) noexcept
+  {
+    return int8 (hash & 0x7f);
+  }
+
+  static inline uint32 getH1 (uint32 hash) noexcept
+  {
+    return hash >> 7;
+  }
+
+  static inline int getLowestBit (uint32 bits) noexcept
+  {
+#if JUCE_MSVC
+    unsigned long index;
+    _BitScanForward (&index, bits);
+    return int (index);
+#elif JUCE_GCC || JUCE_CLANG
+    return __builtin_ctz (bits);
+#else
+    int index = 0;
+    while ((bits & 1) == 0)
+    {
+      bits >>= 1;
+      ++index;
+    }
+    return index;
+#endif
+  }
+
+  // The number of elements which fit before the table must grow.
+  static inline int getGrowth (int capacity) noexcept
+  {
+    return capacity - capacity / 8;
+  }
+
+  static inline size_t getSlotsOffset (int capacity) noexcept
+  {
+    return (sizeof (Storage) + capacity + groupSize + slotAlignment - 1) & ~size_t (slotAlignment - 1);
+  }
+
+  static inline int8* getControl (Storage* storage) noexcept
+  {
+    return reinterpret_cast <int8*> (storage + 1);
+  }
+
+  static inline int8 const* getControl (Storage const* storage) noexcept
+  {
+    return reinterpret_cast <int8 const*> (storage + 1);
+  }
+
+  static inline Slot* getSlots (Storage* storage) noexcept
+  {
+    return reinterpret_cast <Slot*> (reinterpret_cast <char*> (storage) +
+                                     getSlotsOffset (storage->mask + 1));
+  }
+
+  static inline Slot const* getSlots (Storage const* storage) noexcept
+  {
+    return reinterpret_cast <Slot const*> (reinterpret_cast <char const*> (storage) +
+                                           getSlotsOffset (storage->mask + 1));
+  }
+
+  static inline void setControl (Storage* storage, int index, int8 value) noexcept
+  {
+    int8* const control = getControl (storage);
+
+    control [index] = value;
+
+    if (index < groupSize)
+      control [storage->mask + 1 + index] = value;
+  }
+
+  //----------------------------------------------------------------------------
+
+  // Returns the index of the slot holding the key, or -1.
+  //
+  static int findIndex (Storage const* storage, KeyType const& key, uint32 hash)
+  {
+    int8 const* const control = getControl (storage);
+    Slot const* const slots = getSlots (storage);
+    int const mask = storage->mask;
+    int8 const h2 = getH2 (hash);
+
+    int position = int (getH1 (hash)) & mask;
+
+    for (int step = groupSize; step <= mask + groupSize; step += groupSize)
+    {
+      Group const group (control + position);
+
+      for (uint32 bits = group.match (h2); bits != 0; bits &= bits - 1)
+      {
+        int const index = (position + getLowestBit (bits)) & mask;
+
+        if (slots [index].key == key)
+          return index;
+      }
+
+      if (group.match (ctrlEmpty) != 0)
+        break;
+
+      position = (position + step) & mask;
+    }
+
+    return -1;
+  }
+
+  // The lookup reads the storage pointer once, so that it sees a
+  // consistent table even while ConcurrentHashMap replaces it.
+  //
+  ValueType const* findWithHash (KeyType const& key, uint32 hash) const
+  {
+    Storage const* const storage = m_storage;
+
+    if (storage != nullptr)
+    {
+      int const index = findIndex (storage, key, hash);
+
+      if (index != -1)
+        return &getSlots (storage) [index].value;
+    }
+
+    return nullptr;
+  }
+
+  // Returns the index of the first slot along the probe
+  // sequence for the hash which is empty or deleted.
+  //
+  static int findFirstNonFull (Storage const* storage, uint32 hash)
+  {
+    int8 const* const control = getControl (storage);
+    int const mask = storage->mask;
+
+    int position = int (getH1 (hash)) & mask;
+
+    for (int step = groupSize; ; step += groupSize)
+    {
+      uint32 const bits = Group (control + position).matchEmptyOrDeleted ();
+
+      if (bits != 0)
+        return (position + getLowestBit (bits)) & mask;
+
+      position = (position + step) & mask;
+    }
+  }
+
+  // Adds an element whose key is known not to exist, and returns its index.
+  //
+  int addWithHash (KeyType const& key, ValueType const& value, uint32 hash)
+  {
+    int index = m_storage != nullptr ? findFirstNonFull (m_storage, hash) : 0;
+
+    if (m_storage == nullptr || (m_growthLeft == 0 && getControl (m_storage) [index] == ctrlEmpty))
+    {
+      grow ();
+
+      index = findFirstNonFull (m_storage, hash);
+    }
+
+    if (getControl (m_storage) [index] == ctrlEmpty)
+      --m_growthLeft;
+
+    new (&getSlots (m_storage) [index]) Slot (key, value);
+
+    setControl (m_storage, index, getH2 (hash));
+
+    ++m_size;
+
+    return index;
+  }
+
+  bool insertWithHash (KeyType const& key, ValueType const& value, uint32 hash)
+  {
+    bool inserted;
+
+    if (findWithHash (key, hash) == nullptr)
+    {
+      addWithHash (key, value, hash);
+
+      inserted = true;
+    }
+    else
+    {
+      inserted = false;
+    }
+
+    return inserted;
+  }
+
+  void setWithHash (KeyType const& key, ValueType const& value, uint32 hash)
+  {
+    ValueType* const existing = const_cast <ValueType*> (findWithHash (key, hash));
+
+    if (existing != nullptr)
+      *existing = value;
+    else
+      addWithHash (key, value, hash);
+  }
+
+  bool removeWithHash (KeyType const& key, uint32 hash)
+  {
+    bool removed;
+
+    int const index = m_storage != nullptr ? findIndex (m_storage, key, hash) : -1;
+
+    if (index != -1)
+    {
+      getSlots (m_storage) [index].~Slot ();
+
+      setControl (m_storage, index, ctrlDeleted);
+
+      --m_size;
+
+      removed = true;
+    }
+    else
+    {
+      removed = false;
+    }
+
+    return removed;
+  }
+
+  //----------------------------------------------------------------------------
+
+  void grow ()
+  {
+    int const capacity = getCapacity ();
+
+    // If most of the used slots are deleted, rehashing
+    // in place is enough to get them back.
+    //
+    if (capacity > 0 && m_size <= getGrowth (capacity) / 2)
+      dropDeleted ();
+    else
+      rehash (capacity > 0 ? capacity * 2 : groupSize);
+  }
+
+  // Rebuilds the table at the same capacity to reclaim deleted slots.
+  // The storage is reused, so nothing is retired and the memory held by
+  // a map with retained storage stays bounded under insert/remove churn.
+  //
+  void dropDeleted ()
+  {
+    int const capacity = m_storage->mask + 1;
+    int8* const control = getControl (m_storage);
+    Slot* const slots = getSlots (m_storage);
+
+    Slot* const elements = m_size > 0 ? static_cast <Slot*> (
+      m_allocator.allocate (m_size * sizeof (Slot))) : nullptr;
+
+    int count = 0;
+
+    for (int i = 0; i < capacity; ++i)
+    {
+      if (isFull (control [i]))
+      {
+        new (&elements [count++]) Slot (slots [i]);
+
+        slots [i].~Slot ();
+      }
+    }
+
+    jassert (count == m_size);
+
+    memset (control, ctrlEmpty, capacity + groupSize);
+
+    for (int i = 0; i < count; ++i)
+    {
+      uint32 const hash = m_hash (elements [i].key);
+
+      int const index = findFirstNonFull (m_storage, hash);
+
+      new (&slots [index]) Slot (elements [i]);
+
+      setControl (m_storage, index, getH2 (hash));
+
+      elements [i].~Slot ();
+    }
+
+    if (elements != nullptr)
+      AllocatorType::deallocate (elements);
+
+    m_growthLeft = getGrowth (capacity) - m_size;
+  }
+
+  void rehash (int capacity)
+  {
+    jassert (isPowerOfTwo (capacity) && capacity >= groupSize);
+
+    Storage* const storage = static_cast <Storage*> (m_allocator.allocate (
+      getSlotsOffset (capacity) + capacity * sizeof (Slot)));
+
+    storage->next = nullptr;
+    storage->mask = capacity - 1;
+
+    memset (getControl (storage), ctrlEmpty, capacity + groupSize);
+
+    Slot* const slots = getSlots (storage);
+
+    if (m_storage != nullptr)
+    {
+      int8 const* const oldControl = getControl (m_storage);
+      Slot* const oldSlots = getSlots (m_storage);
+
+      for (int i = 0; i <= m_storage->mask; ++i)
+      {
+        if (isFull (oldControl [i]))
+        {
+          uint32 const hash = m_hash (oldSlots [i].key);
+
+          int const index = findFirstNonFull (storage, hash);
+
+          new (&slots [index]) Slot (oldSlots [i]);
+
+          setControl (storage, index, getH2 (hash));
+
+          oldSlots [i].~Slot ();
+        }
+      }
+
+      if (m_retainStorage)
+      {
+        m_storage->next = m_retired;
+        m_retired = m_storage;
+      }
+      else
+      {
+        AllocatorType::deallocate (m_storage);
+      }
+    }
+
+    m_storage = storage;
+    m_growthLeft = getGrowth (capacity) - m_size;
+  }
+
+  void destroyElements ()
+  {
+    if (m_storage != nullptr)
+    {
+      int8 const* const control = getControl (m_storage);
+      Slot* const slots = getSlots (m_storage);
+
+      for (int i = 0; i <= m_storage->mask; ++i)
+        if (isFull (control [i]))
+          slots [i].~Slot ();
+    }
+  }
+
+  static void freeStorage (Storage* storage)
+  {
+    while (storage != nullptr)
+    {
+      Storage* const next = storage->next;
+
+      AllocatorType::deallocate (storage);
+
+      storage = next;
+    }
+  }
+
+private:
+  Storage* volatile m_storage;
+  Storage* m_retired;
+  int m_size;
+  int m_growthLeft;
+  bool m_retainStorage;
+  HashFunctionType m_hash;
+  AllocatorType m_allocator;
+};
+
+#endif
@@ -76,12 +76,33 @@ public:
 
 public:
   /** Create an empty list.
+
+      Contention is recorded in the site shared by every LockFreeQueue
+      which is not given its own.
   */
   LockFreeQueue ()
     : m_head (&m_null)
     , m_tail (&m_null)
     , m_null (nullptr)
+#if VF_USE_CONTENTION_PROFILER
+    , m_site (nullptr)
+#endif
+  {
+  }
+
+  /** Create an empty list which records contention in its own site.
+
+      The site must outlive the list. See ContentionProfiler.
+  */
+  explicit LockFreeQueue (ContentionProfiler::Site& site)
+    : m_head (&m_null)
+    , m_tail (&m_null)
+    , m_null (nullptr)
+#if VF_USE_CONTENTION_PROFILER
+    , m_site (&site)
+#endif
   {
+    (void) site;
   }
 
   /** Determine if the list is empty.
@@ -128,10 +149,22 @@ public:
   {
     Element* elem;
 
+#if VF_USE_CONTENTION_PROFILER
+    // Queues in zero-initialized static storage have no site yet.
+    ContentionProfiler::Site& site = (m_site != nullptr) ?
+      *m_site : ContentionProfiler::getLockFreeQueueSite ();
+
+    site.addAcquisition ();
+#endif
+
     // Avoid the SpinDelay ctor if possible
     if (!try_pop_front (&elem))
     {
+#if VF_USE_CONTENTION_PROFILER
+      SpinDelay delay (site);
+#else
       SpinDelay delay;
+#endif
       do
       {
         delay.pause ();
@@ -225,6 +258,9 @@ private:
   AtomicPointer <Node> m_head;
   Node* m_tail;
   Node m_null;
+#if VF_USE_CONTENTION_PROFILER
+  ContentionProfiler::Site* const m_site;
+#endif
 };
 
 /*============================================================================*/
@@ -33,6 +33,7 @@
 #ifndef VF_LOCKFREESTACK_VFHEADER
 #define VF_LOCKFREESTACK_VFHEADER
 
+#include "../diagnostic/vf_ContentionProfiler.h"
 #include "../memory/vf_AtomicPointer.h"
 
 struct LockFreeStackDefaultTag;
@@ -75,8 +76,28 @@ public:
   };
 
 public:
+  /** Create an empty stack.
+
+      Contention is recorded in the site shared by every LockFreeStack
+      which is not given its own.
+  */
   LockFreeStack () : m_head (0)
+#if VF_USE_CONTENTION_PROFILER
+    , m_site (nullptr)
+#endif
+  {
+  }
+
+  /** Create an empty stack which records contention in its own site.
+
+      The site must outlive the stack. See ContentionProfiler.
+  */
+  explicit LockFreeStack (ContentionProfiler::Site& site) : m_head (0)
+#if VF_USE_CONTENTION_PROFILER
+    , m_site (&site)
+#endif
   {
+    (void) site;
   }
 
   /** Create a LockFreeStack from another stack.
@@ -87,7 +108,27 @@ public:
       @param other  The other stack to acquire.
   */
   explicit LockFreeStack (LockFreeStack& other)
+    : Uncopyable ()
+    , m_head (0)
+#if VF_USE_CONTENTION_PROFILER
+    , m_site (other.m_site)
+#endif
   {
+    takeAll (other);
+  }
+
+  /** Move the contents of another stack onto this empty stack.
+
+      The contents of the other stack are atomically acquired, and the other
+      stack is cleared. Pushes to the other stack which happen afterwards go
+      into the other stack. This stack must not be in use by other threads.
+
+      @param other  The other stack to acquire.
+  */
+  void takeAll (LockFreeStack& other)
+  {
+    jassert (m_head.get () == 0);
+
     Node* head;
 
     do
@@ -114,14 +155,25 @@ public:
     bool first;
     Node* head;
 
+#if VF_USE_CONTENTION_PROFILER
+    int attempts = 0;
+#endif
+
     do
     {
+#if VF_USE_CONTENTION_PROFILER
+      ++attempts;
+#endif
       head = m_head.get();
       first = head == 0;
       node->m_next = head;
     }
     while (!m_head.compareAndSet (node, head));
 
+#if VF_USE_CONTENTION_PROFILER
+    addToProfile (attempts);
+#endif
+
     return first;
   }
 
@@ -137,8 +189,15 @@ public:
     Node* node;
     Node* head;
 
+#if VF_USE_CONTENTION_PROFILER
+    int attempts = 0;
+#endif
+
     do
     {
+#if VF_USE_CONTENTION_PROFILER
+      ++attempts;
+#endif
       node = m_head.get();
       if (node == 0)
         break;
@@ -146,6 +205,10 @@ public:
     }
     while (!m_head.compareAndSet (head, node));
 
+#if VF_USE_CONTENTION_PROFILER
+    addToProfile (attempts);
+#endif
+
     return node ? static_cast <Element*> (node) : nullptr;
   }
 
@@ -163,8 +226,27 @@ public:
     m_head.set (temp);
   }
 
+private:
+#if VF_USE_CONTENTION_PROFILER
+  // Each failed compare and swap counts as a spin.
+  void addToProfile (int attempts)
+  {
+    // Stacks in zero-initialized static storage have no site yet.
+    ContentionProfiler::Site& site = (m_site != nullptr) ?
+      *m_site : ContentionProfiler::getLockFreeStackSite ();
+
+    site.addAcquisition ();
+
+    if (attempts > 1)
+      site.addContention (attempts - 1, 0, 0);
+  }
+#endif
+
 private:
   AtomicPointer <Node> m_head;
+#if VF_USE_CONTENTION_PROFILER
+  ContentionProfiler::Site* const m_site;
+#endif
 };
 
 /*============================================================================*/
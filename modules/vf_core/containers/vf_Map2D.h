@@ -35,6 +35,21 @@
 
 /** Two dimensional array.
 
+    Elements are stored in rows. Each row starts on a rowAlignment byte
+    boundary, so consecutive rows are getStride() elements apart rather
+    than getCols(). Code which walks the map should take a pointer to each
+    row with getRow() and index it, instead of calling get() per element.
+
+    The bulk operations fill(), copyFrom(), transform() and transposeTo()
+    work a row at a time on contiguous memory, which the compiler can
+    vectorize. Column-wise passes are best done either as a sweep over rows
+    that carries one value per column, or on a transposed copy. The
+    transpose works in cache sized blocks, using SSE2 for four byte
+    elements.
+
+    The same operations are available on a View, which is a rectangle
+    within a map.
+
     @ingroup vf_core
 */
 template <class T>
@@ -43,6 +58,201 @@ class Map2D : Uncopyable
 public:
   typedef T Type;
 
+  enum
+  {
+    /** The alignment of each row in bytes. */
+    rowAlignment = 16
+  };
+
+  //============================================================================
+  /**
+    A rectangle of elements within a map.
+
+    The view does not own the elements, so it must not outlive the map.
+  */
+  class View
+  {
+  public:
+    /** Create an empty view. */
+    View ()
+      : m_data (nullptr)
+      , m_cols (0)
+      , m_rows (0)
+      , m_stride (0)
+    {
+    }
+
+    /** Create a view of existing rows of elements.
+
+        @param stride The distance between the start of each row, in elements.
+    */
+    View (T* data, int cols, int rows, int stride)
+      : m_data (data)
+      , m_cols (cols)
+      , m_rows (rows)
+      , m_stride (stride)
+    {
+      jassert (cols >= 0 && rows >= 0 && stride >= cols);
+    }
+
+    inline int getCols () const noexcept
+    {
+      return m_cols;
+    }
+
+    inline int getRows () const noexcept
+    {
+      return m_rows;
+    }
+
+    inline int getStride () const noexcept
+    {
+      return m_stride;
+    }
+
+    inline T* getRow (int y) const noexcept
+    {
+      jassert (isPositiveAndBelow (y, m_rows));
+      return m_data + y * m_stride;
+    }
+
+    inline T& get (int x, int y) const noexcept
+    {
+      jassert (isPositiveAndBelow (x, m_cols) && isPositiveAndBelow (y, m_rows));
+      return m_data [y * m_stride + x];
+    }
+
+    inline T& operator() (int x, int y) const noexcept
+    {
+      return get (x, y);
+    }
+
+    /** Retrieve a rectangle within this view. */
+    View getView (int x, int y, int cols, int rows) const noexcept
+    {
+      jassert (x >= 0 && y >= 0 && x + cols <= m_cols && y + rows <= m_rows);
+      return View (m_data + y * m_stride + x, cols, rows, m_stride);
+    }
+
+    /** Set every element to a value. */
+    template <class U>
+    void fill (U value) const
+    {
+      for (int y = 0; y < m_rows; ++y)
+      {
+        T* const row = getRow (y);
+        std::fill (row, row + m_cols, value);
+      }
+    }
+
+    /** Copy the elements of a view with the same size. */
+    void copyFrom (View const& source) const
+    {
+      jassert (source.getCols () == m_cols && source.getRows () == m_rows);
+
+      for (int y = 0; y < m_rows; ++y)
+      {
+        T const* const row = source.getRow (y);
+        std::copy (row, row + m_cols, getRow (y));
+      }
+    }
+
+    /** Replace every element with the result of a functor.
+
+        The functor is called as `f (element)` and returns the new value.
+    */
+    template <class Functor>
+    void transform (Functor f) const
+    {
+      for (int y = 0; y < m_rows; ++y)
+      {
+        T* const row = getRow (y);
+
+        for (int x = 0; x < m_cols; ++x)
+          row [x] = f (row [x]);
+      }
+    }
+
+    /** Write the transpose of this view into another.
+
+        The destination must have as many columns as this view has rows,
+        and as many rows as this view has columns. The views must not
+        overlap.
+    */
+    void transposeTo (View const& dest) const
+    {
+      jassert (dest.getCols () == m_rows && dest.getRows () == m_cols);
+
+      for (int y0 = 0; y0 < m_rows; y0 += transposeBlockSize)
+      {
+        int const y1 = jmin (y0 + int (transposeBlockSize), m_rows);
+
+        for (int x0 = 0; x0 < m_cols; x0 += transposeBlockSize)
+        {
+          int const x1 = jmin (x0 + int (transposeBlockSize), m_cols);
+
+          transposeBlock (dest, x0, y0, x1, y1);
+        }
+      }
+    }
+
+  private:
+    enum
+    {
+      // Two blocks of this many elements on a side fit in the L1 cache.
+      transposeBlockSize = 32
+    };
+
+    void transposeBlock (View const& dest, int x0, int y0, int x1, int y1) const
+    {
+      int y = y0;
+
+#if VF_COMPILER_SUPPORTS_SSE2
+      if (sizeof (T) == sizeof (float))
+      {
+        for (; y + 4 <= y1; y += 4)
+        {
+          int x = x0;
+
+          for (; x + 4 <= x1; x += 4)
+          {
+            __m128 r0 = _mm_loadu_ps (reinterpret_cast <float const*> (getRow (y) + x));
+            __m128 r1 = _mm_loadu_ps (reinterpret_cast <float const*> (getRow (y + 1) + x));
+            __m128 r2 = _mm_loadu_ps (reinterpret_cast <float const*> (getRow (y + 2) + x));
+            __m128 r3 = _mm_loadu_ps (reinterpret_cast <float const*> (getRow (y + 3) + x));
+
+            _MM_TRANSPOSE4_PS (r0, r1, r2, r3);
+
+            _mm_storeu_ps (reinterpret_cast <float*> (dest.getRow (x) + y), r0);
+            _mm_storeu_ps (reinterpret_cast <float*> (dest.getRow (x + 1) + y), r1);
+            _mm_storeu_ps (reinterpret_cast <float*> (dest.getRow (x + 2) + y), r2);
+            _mm_storeu_ps (reinterpret_cast <float*> (dest.getRow (x + 3) + y), r3);
+          }
+
+          for (; x < x1; ++x)
+            for (int i = 0; i < 4; ++i)
+              dest.getRow (x) [y + i] = getRow (y + i) [x];
+        }
+      }
+#endif
+
+      for (; y < y1; ++y)
+      {
+        T const* const row = getRow (y);
+
+        for (int x = x0; x < x1; ++x)
+          dest.getRow (x) [y] = row [x];
+      }
+    }
+
+    T* m_data;
+    int m_cols;
+    int m_rows;
+    int m_stride;
+  };
+
+  //============================================================================
+
   /** Creates a null map.
   */
   Map2D ()
@@ -109,16 +319,16 @@ public:
   template <class U>
   void reset (U u = U ()) const noexcept
   {
-     std::fill (
-      m_data->getData (),
-      m_data->getData () + m_data->getRows () * m_data->getCols (), u);
+    fill (u);
   }
 
   /** Get a pointer to the start of the data.
+
+      Rows are getStride() elements apart.
   */
   inline T* getData () const noexcept
   {
-    return m_data.getData ();
+    return m_data->getData ();
   }
 
   /** Conversion to T*.
@@ -142,6 +352,13 @@ public:
     return m_data->getCols ();
   }
 
+  /** Get the distance between the start of each row, in elements.
+  */
+  inline int getStride () const noexcept
+  {
+    return m_data->getStride ();
+  }
+
   /** Access an element.
   */
   inline T& get (int x, int y) const noexcept
@@ -160,7 +377,64 @@ public:
   */
   inline T* getRow (int y) const noexcept
   {
-    return m_data->getRow ();
+    return m_data->getRow (y);
+  }
+
+  /** Retrieve a view of the whole map.
+  */
+  View getView () const noexcept
+  {
+    return View (getData (), getCols (), getRows (), getStride ());
+  }
+
+  /** Retrieve a view of a rectangle within the map.
+  */
+  View getView (int x, int y, int cols, int rows) const noexcept
+  {
+    return getView ().getView (x, y, cols, rows);
+  }
+
+  /** Set every element to a value.
+  */
+  template <class U>
+  void fill (U value) const
+  {
+    getView ().fill (value);
+  }
+
+  /** Copy the elements of a map with the same size.
+  */
+  void copyFrom (Map2D const& source) const
+  {
+    getView ().copyFrom (source.getView ());
+  }
+
+  /** Replace every element with the result of a functor.
+
+      @see View::transform
+  */
+  template <class Functor>
+  void transform (Functor f) const
+  {
+    getView ().transform (f);
+  }
+
+  /** Write the transpose of this map into another.
+
+      @see View::transposeTo
+  */
+  void transposeTo (Map2D const& dest) const
+  {
+    getView ().transposeTo (dest.getView ());
+  }
+
+  /** Create a new map holding the transpose of this one.
+  */
+  Map2D transposed () const
+  {
+    Map2D result (getRows (), getCols ());
+    transposeTo (result);
+    return result;
   }
 
 private:
@@ -172,7 +446,10 @@ private:
     Data (int width, int height, bool fillMemoryWithZeros = false)
       : m_rows (height)
       , m_cols (width)
-      , m_vec (height * width, fillMemoryWithZeros)
+      , m_stride (getAlignedStride (width))
+      , m_block (size_t (height) * m_stride * sizeof (T) + rowAlignment - 1, fillMemoryWithZeros)
+      , m_vec (reinterpret_cast <T*> ((reinterpret_cast <uintptr_t> (m_block.getData ()) +
+                                       rowAlignment - 1) & ~uintptr_t (rowAlignment - 1)))
     {
     }
 
@@ -186,28 +463,47 @@ private:
       return m_cols;
     }
 
+    inline int getStride () const noexcept
+    {
+      return m_stride;
+    }
+
     inline T* getData () const noexcept
     {
-      return m_vec.getData ();
+      return m_vec;
     }
 
     inline T& get (int x, int y) const noexcept
     {
       jassert (isPositiveAndBelow (x, m_cols) && isPositiveAndBelow (y, m_rows));
-      return m_vec [y * m_cols + x];
+      return m_vec [y * m_stride + x];
     }
 
     inline T* getRow (int y) const noexcept
     {
       jassert (isPositiveAndBelow (y, m_rows));
     
-      return m_vec + y * m_cols;
+      return m_vec + y * m_stride;
     }
 
   private:
+    // Rounds the row length up so that every row starts aligned. Elements
+    // which do not divide the alignment are left unpadded.
+    static int getAlignedStride (int width) noexcept
+    {
+      if (rowAlignment % sizeof (T) != 0)
+        return width;
+
+      int const elements = int (rowAlignment / sizeof (T));
+
+      return (width + elements - 1) / elements * elements;
+    }
+
     int const m_rows;
     int const m_cols;
-    HeapBlock <T> m_vec;
+    int const m_stride;
+    HeapBlock <char> m_block;
+    T* const m_vec;
   };
 
   typename Data::Ptr m_data;
@@ -35,7 +35,27 @@
 
 /** Handle to a reference counted fixed size table.
 
-    @note Currently, ElementType must be an aggregate of POD.
+    The entries are stored in chunks of 4096 which are shared individually,
+    so copying a table is cheap and writing to a shared table only duplicates
+    the chunks which are written. Writes through set(), getWritableReference()
+    and the bulk functions do this automatically:
+
+    @code
+
+    SharedTable <int> table (1000000, 0);
+
+    SharedTable <int> copy (table);     // shares every chunk
+
+    copy.set (42, 1);                   // duplicates only the first chunk
+
+    @endcode
+
+    The reference returned by operator[] writes through to every table which
+    shares the entry. Call duplicateIfShared() first if the table is to be
+    modified that way; this duplicates every chunk which is still shared.
+
+    Entries are constructed and destroyed normally, so ElementType may be any
+    copyable type with a default constructor.
 
     @tparam ElementType The type of element.
     
@@ -57,14 +77,22 @@ public:
 
   /** Creates a table with the specified number of entries.
 
-      The entries are uninitialized.
+      The entries are default constructed.
 
       @param numEntries The number of entries in the table.
-
-      @todo Initialize the data if ElementType is not POD.
   */
   explicit SharedTable (int numEntries)
-    : m_data (new Data (numEntries))
+    : m_data (new Data (numEntries, nullptr))
+  {
+  }
+
+  /** Creates a table with every entry set to a value.
+
+      @param numEntries   The number of entries in the table.
+      @param initialValue The value copied into each entry.
+  */
+  SharedTable (int numEntries, ElementType const& initialValue)
+    : m_data (new Data (numEntries, &initialValue))
   {
   }
 
@@ -141,15 +169,20 @@ public:
   */
   SharedTable createCopy () const
   {
-     return SharedTable (m_data != nullptr ? m_data->clone() : nullptr);
+     return SharedTable (m_data != nullptr ? new Data (*m_data, true) : nullptr);
   }
 
   /** Makes sure no other tables share the same entries as this table.
   */
   void duplicateIfShared ()
   {
-    if (m_data != nullptr && m_data->getReferenceCount() > 1)
-      m_data = m_data->clone ();
+    if (m_data != nullptr)
+    {
+      makeDataUnique ();
+
+      for (int i = 0; i < m_data->getNumChunks (); ++i)
+        m_data->getWritableChunk (i);
+    }
   }
 
   /** Return the number of entries in this table.
@@ -168,28 +201,244 @@ public:
     return m_data->getReference (index);
   }
 
+  /** Retrieve a table entry for modification.
+
+      If the entry is shared with another table, only its chunk is
+      duplicated.
+
+      @param index The index of the entry, from 0 to getNumEntries ().
+  */
+  ElementType& getWritableReference (int index)
+  {
+    jassert (index >= 0 && index < getNumEntries ());
+
+    makeDataUnique ();
+
+    return m_data->getWritableChunk (index >> chunkShift) [index & chunkMask];
+  }
+
+  /** Change a table entry.
+
+      @param index    The index of the entry, from 0 to getNumEntries ().
+      @param newValue The value to assign.
+  */
+  void set (int index, ElementType const& newValue)
+  {
+    getWritableReference (index) = newValue;
+  }
+
+#if JUCE_COMPILER_SUPPORTS_MOVE_SEMANTICS
+  void set (int index, ElementType&& newValue)
+  {
+    getWritableReference (index) = static_cast <ElementType&&> (newValue);
+  }
+#endif
+
+  /** Apply a function to a range of entries.
+
+      Each chunk in the range is duplicated at most once if shared, and the
+      functor is called as `f (ElementType&)` for each entry in order.
+
+      @param startIndex The index of the first entry.
+      @param numEntries The number of entries to update.
+      @param f          The functor to call.
+  */
+  template <class Functor>
+  void update (int startIndex, int numEntries, Functor f)
+  {
+    jassert (startIndex >= 0 && numEntries >= 0);
+    jassert (startIndex + numEntries <= getNumEntries ());
+
+    if (numEntries > 0)
+    {
+      makeDataUnique ();
+
+      int const endIndex = startIndex + numEntries;
+
+      for (int index = startIndex; index < endIndex;)
+      {
+        ElementType* const chunk = m_data->getWritableChunk (index >> chunkShift);
+
+        int const chunkEnd = jmin (endIndex, ((index >> chunkShift) + 1) << chunkShift);
+
+        for (; index < chunkEnd; ++index)
+          f (chunk [index & chunkMask]);
+      }
+    }
+  }
+
+  /** Copy values into a range of entries.
+
+      @param startIndex The index of the first entry to change.
+      @param values     The values to copy.
+      @param numValues  The number of values.
+  */
+  void setRange (int startIndex, ElementType const* values, int numValues)
+  {
+    update (startIndex, numValues, CopyFrom (values));
+  }
+
+  /** Assign a value to a range of entries.
+
+      @param startIndex The index of the first entry to change.
+      @param numEntries The number of entries to change.
+      @param value      The value to assign.
+  */
+  void fillRange (int startIndex, int numEntries, ElementType const& value)
+  {
+    update (startIndex, numEntries, Assign (value));
+  }
+
+  /** Assign a value to every entry.
+  */
+  void fill (ElementType const& value)
+  {
+    fillRange (0, getNumEntries (), value);
+  }
+
+  /** Copy a range of entries out of the table.
+
+      @param startIndex The index of the first entry to copy.
+      @param dest       The array to receive the entries.
+      @param numEntries The number of entries to copy.
+  */
+  void copyTo (int startIndex, ElementType* dest, int numEntries) const
+  {
+    jassert (startIndex >= 0 && numEntries >= 0);
+    jassert (startIndex + numEntries <= getNumEntries ());
+
+    for (int i = 0; i < numEntries; ++i)
+      dest [i] = m_data->getReference (startIndex + i);
+  }
+
 private:
-  class Data : public ReferenceCountedObject
+  enum
+  {
+    chunkShift = 12,
+    chunkSize = 1 << chunkShift,
+    chunkMask = chunkSize - 1
+  };
+
+  struct CopyFrom
+  {
+    explicit CopyFrom (ElementType const* values) : m_values (values)
+    {
+    }
+
+    inline void operator () (ElementType& element)
+    {
+      element = *m_values++;
+    }
+
+    ElementType const* m_values;
+  };
+
+  struct Assign
+  {
+    explicit Assign (ElementType const& value) : m_value (value)
+    {
+    }
+
+    inline void operator () (ElementType& element) const
+    {
+      element = m_value;
+    }
+
+    ElementType const& m_value;
+  };
+
+  //----------------------------------------------------------------------------
+
+  class Chunk : public ReferenceCountedObject
   {
   public:
-    typedef ReferenceCountedObjectPtr <Data> Ptr;
+    typedef ReferenceCountedObjectPtr <Chunk> Ptr;
 
-    explicit Data (int numEntries)
+    Chunk (int numEntries, ElementType const* initialValue)
       : m_numEntries (numEntries)
-      , m_table (numEntries)
+      , m_storage (numEntries * sizeof (ElementType))
+    {
+      ElementType* const elements = getData ();
+
+      for (int i = 0; i < m_numEntries; ++i)
+      {
+        if (initialValue != nullptr)
+          new (elements + i) ElementType (*initialValue);
+        else
+          new (elements + i) ElementType ();
+      }
+    }
+
+    explicit Chunk (Chunk const& other)
+      : ReferenceCountedObject ()
+      , m_numEntries (other.m_numEntries)
+      , m_storage (other.m_numEntries * sizeof (ElementType))
     {
+      ElementType* const elements = getData ();
+      ElementType const* const source = other.getData ();
+
+      for (int i = 0; i < m_numEntries; ++i)
+        new (elements + i) ElementType (source [i]);
     }
 
-    inline Data* clone () const
+    ~Chunk ()
     {
-      Data* data = new Data (m_numEntries);
+      ElementType* const elements = getData ();
 
-      memcpy (
-        data->m_table.getData (),
-        m_table.getData (),
-        m_numEntries * sizeof (ElementType));
+      for (int i = 0; i < m_numEntries; ++i)
+        elements [i].~ElementType ();
+    }
 
-      return data;
+    inline ElementType* getData () const noexcept
+    {
+      return reinterpret_cast <ElementType*> (m_storage.getData ());
+    }
+
+  private:
+    Chunk& operator= (Chunk const&);
+
+    int const m_numEntries;
+    HeapBlock <char> const m_storage;
+  };
+
+  //----------------------------------------------------------------------------
+
+  class Data : public ReferenceCountedObject
+  {
+  public:
+    typedef ReferenceCountedObjectPtr <Data> Ptr;
+
+    Data (int numEntries, ElementType const* initialValue)
+      : m_numEntries (numEntries)
+    {
+      int const numChunks = (numEntries + chunkSize - 1) >> chunkShift;
+
+      m_chunks.reserve (numChunks);
+      m_elements.reserve (numChunks);
+
+      for (int i = 0; i < numChunks; ++i)
+      {
+        m_chunks.push_back (new Chunk (jmin (int (chunkSize), numEntries - (i << chunkShift)),
+                                       initialValue));
+        m_elements.push_back (m_chunks.back ()->getData ());
+      }
+    }
+
+    // Shares the chunks of another table, or copies them if deep is true.
+    Data (Data const& other, bool deep)
+      : ReferenceCountedObject ()
+      , m_numEntries (other.m_numEntries)
+      , m_chunks (other.m_chunks)
+      , m_elements (other.m_elements)
+    {
+      if (deep)
+      {
+        for (int i = 0; i < getNumChunks (); ++i)
+        {
+          m_chunks [i] = new Chunk (*m_chunks [i]);
+          m_elements [i] = m_chunks [i]->getData ();
+        }
+      }
     }
 
     inline int getNumEntries () const
@@ -197,15 +446,37 @@ private:
       return m_numEntries;
     }
 
+    inline int getNumChunks () const
+    {
+      return int (m_chunks.size ());
+    }
+
     inline ElementType& getReference (int index) const
     {
       jassert (index >= 0 && index < m_numEntries);
-      return m_table [index];
+      return m_elements [index >> chunkShift] [index & chunkMask];
+    }
+
+    // Duplicates the chunk if another table shares it.
+    ElementType* getWritableChunk (int chunkIndex)
+    {
+      jassert (getReferenceCount () == 1);
+
+      if (m_chunks [chunkIndex]->getReferenceCount () > 1)
+      {
+        m_chunks [chunkIndex] = new Chunk (*m_chunks [chunkIndex]);
+        m_elements [chunkIndex] = m_chunks [chunkIndex]->getData ();
+      }
+
+      return m_elements [chunkIndex];
     }
 
   private:
+    Data& operator= (Data const&);
+
     int const m_numEntries;
-    HeapBlock <ElementType> const m_table;
+    std::vector <typename Chunk::Ptr> m_chunks;
+    std::vector <ElementType*> m_elements;
   };
 
   explicit SharedTable (Data* data)
@@ -213,6 +484,13 @@ private:
   {
   }
 
+  // Only the chunk pointers are copied here.
+  void makeDataUnique ()
+  {
+    if (m_data->getReferenceCount () > 1)
+      m_data = new Data (*m_data, false);
+  }
+
   ReferenceCountedObjectPtr <Data> m_data;
 };
 
@@ -57,6 +57,17 @@
   To use the table, reserve space with reserveSpaceForValues() if the number
   of elements is known ahead of time. Then, call insert() for  all the your
   elements. Call prepareForLookups() once then call lookupValueByKey () 
+
+  The keys are searched through a StaticBTree, so a lookup touches about
+  one cache line per level instead of one per comparison. Use
+  lookupValuesByKey() to find many keys at once.
+
+  Values may still be inserted after prepareForLookups(). They are gathered
+  a few at a time, sorted, and kept in sorted runs which are merged with
+  each other as they grow, so that each run is at most half the size of the
+  one before it. The runs are searched along with the tree, and merged into
+  the table once they hold a sixteenth of it, without sorting the whole
+  table again.
 */
 template <class SchemaType>
 class SortedLookupTable
@@ -67,38 +78,73 @@ private:
 
   typedef std::vector <ValueType> values_t;
 
+  enum
+  {
+    // Inserts after preparation are searched linearly
+    // until there are this many, and then sorted into a run.
+    recentSize = 32,
+
+    // The runs are merged into the table once they hold
+    // this many values, or a sixteenth of the table.
+    minimumMergeSize = 256
+  };
+
+  SchemaType m_schema;
   values_t m_values;
+  values_t m_recent;
+  std::vector <values_t> m_runs;
+  typename values_t::size_type m_pendingSize;
+  StaticBTree <KeyType> m_tree;
+  bool m_prepared;
 
 private:
   struct SortCompare
   {
+    explicit SortCompare (SchemaType& schema) : m_schema (schema)
+    {
+    }
+
     bool operator() (ValueType const& lhs, ValueType const& rhs) const
     {
-      return SchemaType().getKey (lhs) < SchemaType().getKey (rhs);
+      return m_schema.getKey (lhs) < m_schema.getKey (rhs);
     }
+
+    SchemaType& m_schema;
   };
 
   struct FindCompare
   {
+    explicit FindCompare (SchemaType& schema) : m_schema (schema)
+    {
+    }
+
     bool operator () (ValueType const& lhs, ValueType const& rhs)
     {
-      return SchemaType().getKey (lhs) < SchemaType().getKey (rhs);
+      return m_schema.getKey (lhs) < m_schema.getKey (rhs);
     }
 
     bool operator () (KeyType const& key, ValueType const& rhs)
     {
-      return key < SchemaType().getKey (rhs);
+      return key < m_schema.getKey (rhs);
     }
 
     bool operator() (ValueType const& lhs, KeyType const& key)
     {
-      return SchemaType().getKey (lhs) < key;
+      return m_schema.getKey (lhs) < key;
     }
+
+    SchemaType& m_schema;
   };
 
 public:
   typedef typename values_t::size_type size_type;
 
+  SortedLookupTable ()
+    : m_pendingSize (0)
+    , m_prepared (false)
+  {
+  }
+
   /** Reserve space for values.
 
       Although not necessary, this can help with memory usage if the
@@ -113,13 +159,32 @@ public:
 
   /** Insert a value into the index.
 
+      After prepareForLookups() has been called, the value is available
+      to lookups immediately.
+
       @invariant The value must not already exist in the index.
 
       @param valueToInsert The value to insert.
   */
   void insert (ValueType const& valueToInsert)
   {
-    m_values.push_back (valueToInsert);
+    if (m_prepared)
+    {
+      m_recent.push_back (valueToInsert);
+      ++m_pendingSize;
+
+      if (m_recent.size () >= recentSize)
+      {
+        addRun ();
+
+        if (m_pendingSize >= jmax (size_type (minimumMergeSize), m_values.size () / 16))
+          mergePending ();
+      }
+    }
+    else
+    {
+      m_values.push_back (valueToInsert);
+    }
   }
 
   /** Prepare the index for lookups.
@@ -129,7 +194,18 @@ public:
   */
   void prepareForLookups ()
   {
-    std::sort (m_values.begin (), m_values.end (), SortCompare ());
+    if (m_prepared)
+    {
+      mergePending ();
+    }
+    else
+    {
+      std::sort (m_values.begin (), m_values.end (), SortCompare (m_schema));
+
+      buildTree ();
+
+      m_prepared = true;
+    }
   }
 
   /** Find the value for a key.
@@ -137,8 +213,8 @@ public:
       Quickly locates a value matching the key, or returns false
       indicating no value was found.
 
-      @invariant You must call prepareForLookups() once, after all
-                 insertions, before calling this function.
+      @invariant You must call prepareForLookups() once before calling
+                 this function.
 
       @param key         The key to locate.
       @param pFoundValue Pointer to store the value if a matching
@@ -147,23 +223,164 @@ public:
   */
   bool lookupValueByKey (KeyType const& key, ValueType* pFoundValue)
   {
-    bool found;
+    jassert (m_prepared);
+
+    return getFoundValue (m_tree.lowerBound (key), key, pFoundValue);
+  }
+
+  /** Find the values for many keys.
 
-    std::pair <typename values_t::iterator, typename values_t::iterator> result =
-      std::equal_range (m_values.begin (), m_values.end (), key, FindCompare ());
+      This is faster than calling lookupValueByKey() for each key when the
+      table is larger than the cache, because the searches are overlapped.
 
-    if (result.first != result.second)
+      @param keys        The keys to locate.
+      @param foundValues An array to receive the value for each key that
+                         was found.
+      @param found       An array to receive `true` for each key that was
+                         found, and `false` otherwise.
+      @param numberOfKeys The number of keys.
+      @return The number of keys that were found.
+  */
+  int lookupValuesByKey (KeyType const* keys,
+                         ValueType* foundValues,
+                         bool* found,
+                         int numberOfKeys)
+  {
+    jassert (m_prepared);
+
+    int numberFound = 0;
+
+    HeapBlock <int> positions (numberOfKeys);
+
+    m_tree.lowerBound (keys, positions, numberOfKeys);
+
+    for (int i = 0; i < numberOfKeys; ++i)
     {
-      *pFoundValue = *result.first;
+      found [i] = getFoundValue (positions [i], keys [i], foundValues + i);
+
+      if (found [i])
+        ++numberFound;
+    }
+
+    return numberFound;
+  }
+
+private:
+  bool getFoundValue (int position, KeyType const& key, ValueType* pFoundValue)
+  {
+    bool found;
+
+    if (position < int (m_values.size ()) && !(key < m_schema.getKey (m_values [position])))
+    {
+      *pFoundValue = m_values [position];
       found = true;
     }
     else
     {
-      found = false;
+      found = findPending (key, pFoundValue);
     }
 
     return found;
   }
+
+  // The recent values are few enough to search one by one.
+  bool findPending (KeyType const& key, ValueType* pFoundValue)
+  {
+    bool found = false;
+
+    for (typename values_t::iterator iter = m_recent.begin ();
+         !found && iter != m_recent.end (); ++iter)
+    {
+      if (!(key < m_schema.getKey (*iter)) && !(m_schema.getKey (*iter) < key))
+      {
+        *pFoundValue = *iter;
+        found = true;
+      }
+    }
+
+    for (std::size_t i = 0; !found && i < m_runs.size (); ++i)
+    {
+      typename values_t::iterator iter = std::lower_bound (
+        m_runs [i].begin (), m_runs [i].end (), key, FindCompare (m_schema));
+
+      if (iter != m_runs [i].end () && !(key < m_schema.getKey (*iter)))
+      {
+        *pFoundValue = *iter;
+        found = true;
+      }
+    }
+
+    return found;
+  }
+
+  // Sorts the recent values into a run, then merges runs until each
+  // is at most half the size of the one before it. A value takes part
+  // in a logarithmic number of merges before reaching the table.
+  void addRun ()
+  {
+    if (!m_recent.empty ())
+    {
+      std::sort (m_recent.begin (), m_recent.end (), SortCompare (m_schema));
+
+      m_runs.push_back (values_t ());
+      m_runs.back ().swap (m_recent);
+
+      collapseRuns (false);
+    }
+  }
+
+  void collapseRuns (bool all)
+  {
+    while (m_runs.size () > 1)
+    {
+      values_t& last = m_runs [m_runs.size () - 1];
+      values_t& previous = m_runs [m_runs.size () - 2];
+
+      if (!all && previous.size () >= 2 * last.size ())
+        break;
+
+      values_t merged;
+      merged.reserve (previous.size () + last.size ());
+
+      std::merge (previous.begin (), previous.end (), last.begin (), last.end (),
+                  std::back_inserter (merged), SortCompare (m_schema));
+
+      previous.swap (merged);
+      m_runs.pop_back ();
+    }
+  }
+
+  // The runs and the table are already sorted, so each merge is linear.
+  void mergePending ()
+  {
+    addRun ();
+    collapseRuns (true);
+
+    if (!m_runs.empty ())
+    {
+      size_type const middle = m_values.size ();
+
+      m_values.insert (m_values.end (), m_runs [0].begin (), m_runs [0].end ());
+      m_runs.clear ();
+      m_pendingSize = 0;
+
+      std::inplace_merge (m_values.begin (), m_values.begin () + middle,
+                          m_values.end (), SortCompare (m_schema));
+
+      buildTree ();
+    }
+  }
+
+  void buildTree ()
+  {
+    std::vector <KeyType> keys;
+    keys.reserve (m_values.size ());
+
+    for (typename values_t::iterator iter = m_values.begin (); iter != m_values.end (); ++iter)
+      keys.push_back (m_schema.getKey (*iter));
+
+    m_tree.build (keys.empty () ? nullptr : &keys [0], int (keys.size ()));
+  }
 };
 
 #endif
@@ -0,0 +1,391 @@
+/*============================================================================*/
+/*
+  VFLib: https://github.com/vinniefalco/VFLib
+
+  Copyright (C) 2008 by Vinnie Falco <vinnie.falco@gmail.com>
+
+  This library contains portions of other open source products covered by
+  separate licenses. Please see the corresponding source files for specific
+  terms.
+  
+  VFLib is provided under the terms of The MIT License (MIT):
+
+  Permission is hereby granted, free of charge, to any person obtaining a copy
+  of this software and associated documentation files (the "Software"), to deal
+  in the Software without restriction, including without limitation the rights
+  to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+  copies of the Software, and to permit persons to whom the Software is
+  furnished to do so, subject to the following conditions:
+
+  The above copyright notice and this permission notice shall be included in
+  all copies or substantial portions of the Software.
+
+  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+  FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+  IN THE SOFTWARE.
+*/
+/*============================================================================*/
+
+#ifndef VF_STATICBTREE_VFHEADER
+#define VF_STATICBTREE_VFHEADER
+
+/** Counts the keys in a node which are less than a key.
+
+    This is used by StaticBTree. It is specialized to compare 32 bit
+    integer keys with SSE2 when it is available.
+
+    @internal
+*/
+template <class KeyType, int KeysPerNode>
+struct StaticBTreeRank
+{
+  static inline int count (KeyType const* node, KeyType const& key) noexcept
+  {
+    int n = 0;
+
+    for (int i = 0; i < KeysPerNode; ++i)
+      n += (node [i] < key) ? 1 : 0;
+
+    return n;
+  }
+};
+
+#if VF_COMPILER_SUPPORTS_SSE2
+template <>
+struct StaticBTreeRank <int, 16>
+{
+  // Each compare produces -1 for a key which is less, so the
+  // sum of the four compares is minus the count.
+  static inline int count (int const* node, int const& key) noexcept
+  {
+    __m128i const* const v = reinterpret_cast <__m128i const*> (node);
+    __m128i const x = _mm_set1_epi32 (key);
+
+    __m128i sum = _mm_add_epi32 (
+      _mm_add_epi32 (_mm_cmpgt_epi32 (x, _mm_loadu_si128 (v)),
+                     _mm_cmpgt_epi32 (x, _mm_loadu_si128 (v + 1))),
+      _mm_add_epi32 (_mm_cmpgt_epi32 (x, _mm_loadu_si128 (v + 2)),
+                     _mm_cmpgt_epi32 (x, _mm_loadu_si128 (v + 3))));
+
+    sum = _mm_add_epi32 (sum, _mm_shuffle_epi32 (sum, _MM_SHUFFLE (1, 0, 3, 2)));
+    sum = _mm_add_epi32 (sum, _mm_shuffle_epi32 (sum, _MM_SHUFFLE (2, 3, 0, 1)));
+
+    return -_mm_cvtsi128_si32 (sum);
+  }
+};
+
+template <>
+struct StaticBTreeRank <uint32, 16>
+{
+  // SSE2 only compares signed integers, so the sign bits are flipped.
+  static inline int count (uint32 const* node, uint32 const& key) noexcept
+  {
+    __m128i const* const v = reinterpret_cast <__m128i const*> (node);
+    __m128i const bias = _mm_set1_epi32 (int (0x80000000));
+    __m128i const x = _mm_xor_si128 (_mm_set1_epi32 (int (key)), bias);
+
+    __m128i sum = _mm_add_epi32 (
+      _mm_add_epi32 (_mm_cmpgt_epi32 (x, _mm_xor_si128 (_mm_loadu_si128 (v), bias)),
+                     _mm_cmpgt_epi32 (x, _mm_xor_si128 (_mm_loadu_si128 (v + 1), bias))),
+      _mm_add_epi32 (_mm_cmpgt_epi32 (x, _mm_xor_si128 (_mm_loadu_si128 (v + 2), bias)),
+                     _mm_cmpgt_epi32 (x, _mm_xor_si128 (_mm_loadu_si128 (v + 3), bias))));
+
+    sum = _mm_add_epi32 (sum, _mm_shuffle_epi32 (sum, _MM_SHUFFLE (1, 0, 3, 2)));
+    sum = _mm_add_epi32 (sum, _mm_shuffle_epi32 (sum, _MM_SHUFFLE (2, 3, 0, 1)));
+
+    return -_mm_cvtsi128_si32 (sum);
+  }
+};
+#endif
+
+//==============================================================================
+/**
+  Sorted keys arranged for fast searching.
+
+  The keys are stored as an implicit B-tree. Each node holds a cache line
+  of keys, and the children of a node are found by calculation rather than
+  by pointers. A search touches one cache line per level, where a binary
+  search over a sorted array touches one per comparison for most of its
+  steps. For 32 bit integer keys the keys in a node are compared all at
+  once with SSE2.
+
+  The tree is built once from keys in ascending order, and searches return
+  positions in that order:
+
+  @code
+
+  std::vector <int> keys;
+  // ... fill and sort keys
+
+  StaticBTree <int> tree;
+  tree.build (&keys [0], int (keys.size ()));
+
+  int const index = tree.lowerBound (42);
+
+  if (index < tree.size () && keys [index] == 42)
+  {
+    // found
+  }
+
+  @endcode
+
+  Batch searches interleave a group of lookups a level at a time and
+  prefetch the next node of each, so that the cache misses overlap.
+
+  KeyType must be copyable and ordered by operator<. Copying a tree copies
+  its keys.
+
+  @see SortedLookupTable
+
+  @ingroup vf_core
+*/
+template <class KeyType>
+class StaticBTree
+{
+public:
+  enum
+  {
+    /** The number of keys in each node, filling a cache line. */
+    keysPerNode = (sizeof (KeyType) <= 16) ? int (64 / sizeof (KeyType)) : 4
+  };
+
+  /** Create an empty tree. */
+  StaticBTree ()
+    : m_size (0)
+    , m_numberOfNodes (0)
+    , m_keys (nullptr)
+  {
+  }
+
+  StaticBTree (StaticBTree const& other)
+    : m_size (0)
+    , m_numberOfNodes (0)
+    , m_keys (nullptr)
+  {
+    copyFrom (other);
+  }
+
+  StaticBTree& operator= (StaticBTree const& other)
+  {
+    if (&other != this)
+    {
+      clear ();
+      copyFrom (other);
+    }
+
+    return *this;
+  }
+
+  ~StaticBTree ()
+  {
+    clear ();
+  }
+
+  /** Remove all keys. */
+  void clear ()
+  {
+    for (int i = 0; i < m_numberOfNodes * keysPerNode; ++i)
+      m_keys [i].~KeyType ();
+
+    m_size = 0;
+    m_numberOfNodes = 0;
+    m_keys = nullptr;
+    m_block.free ();
+    m_positions.clear ();
+  }
+
+  /** Replace the contents with keys in ascending order. */
+  void build (KeyType const* sortedKeys, int count)
+  {
+    clear ();
+
+    if (count > 0)
+    {
+      allocate ((count + keysPerNode - 1) / keysPerNode);
+
+      m_size = count;
+
+      int next = 0;
+      fill (sortedKeys, next, 0);
+
+      jassert (next == count);
+    }
+  }
+
+  /** Retrieve the number of keys. */
+  int size () const noexcept
+  {
+    return m_size;
+  }
+
+  /** Find the first key which is not less than a key.
+
+      @return The position of the key in the sorted order, or size()
+              if every key is less.
+  */
+  int lowerBound (KeyType const& key) const noexcept
+  {
+    int result = m_size;
+
+    for (int k = 0; k < m_numberOfNodes;)
+    {
+      int const i = Rank::count (getNode (k), key);
+
+      if (i < keysPerNode)
+        result = m_positions [k * keysPerNode + i];
+
+      k = getChild (k, i);
+    }
+
+    return result;
+  }
+
+  /** Find the lower bound of many keys.
+
+      This is equivalent to calling lowerBound() for each key, but faster
+      when the tree is larger than the cache.
+  */
+  void lowerBound (KeyType const* keys, int* results, int count) const noexcept
+  {
+    for (int start = 0; start < count; start += batchSize)
+    {
+      int const n = jmin (int (batchSize), count - start);
+
+      int node [batchSize];
+
+      for (int j = 0; j < n; ++j)
+      {
+        node [j] = 0;
+        results [start + j] = m_size;
+      }
+
+      for (bool active = m_numberOfNodes > 0; active;)
+      {
+        active = false;
+
+        for (int j = 0; j < n; ++j)
+        {
+          int const k = node [j];
+
+          if (k < m_numberOfNodes)
+          {
+            int const i = Rank::count (getNode (k), keys [start + j]);
+
+            if (i < keysPerNode)
+              results [start + j] = m_positions [k * keysPerNode + i];
+
+            int const child = getChild (k, i);
+
+            if (child < m_numberOfNodes)
+            {
+              prefetch (getNode (child));
+              active = true;
+            }
+
+            node [j] = child;
+          }
+        }
+      }
+    }
+  }
+
+private:
+  typedef StaticBTreeRank <KeyType, keysPerNode> Rank;
+
+  enum
+  {
+    cacheLineBytes = 64,
+
+    // The number of searches in flight in a batch.
+    batchSize = 16
+  };
+
+  // Allocates cache line aligned nodes. The keys are constructed later.
+  void allocate (int numberOfNodes)
+  {
+    int const numberOfSlots = numberOfNodes * keysPerNode;
+
+    m_block.malloc (numberOfSlots * sizeof (KeyType) + cacheLineBytes - 1);
+    m_keys = reinterpret_cast <KeyType*> ((reinterpret_cast <uintptr_t> (m_block.getData ()) +
+                                            cacheLineBytes - 1) & ~uintptr_t (cacheLineBytes - 1));
+    m_positions.resize (numberOfSlots);
+
+    m_numberOfNodes = numberOfNodes;
+  }
+
+  void copyFrom (StaticBTree const& other)
+  {
+    if (other.m_numberOfNodes > 0)
+    {
+      allocate (other.m_numberOfNodes);
+
+      for (int i = 0; i < m_numberOfNodes * keysPerNode; ++i)
+        new (m_keys + i) KeyType (other.m_keys [i]);
+
+      m_positions = other.m_positions;
+      m_size = other.m_size;
+    }
+  }
+
+  static inline int getChild (int k, int i) noexcept
+  {
+    return k * (keysPerNode + 1) + i + 1;
+  }
+
+  inline KeyType const* getNode (int k) const noexcept
+  {
+    return m_keys + k * keysPerNode;
+  }
+
+  static inline void prefetch (void const* p) noexcept
+  {
+#if VF_COMPILER_SUPPORTS_SSE2
+    _mm_prefetch (static_cast <char const*> (p), _MM_HINT_T0);
+#elif JUCE_GCC
+    __builtin_prefetch (p);
+#else
+    (void) p;
+#endif
+  }
+
+  // Assigns the keys to the nodes in order. Slots past the
+  // end repeat the last key, and report the end position.
+  void fill (KeyType const* sortedKeys, int& next, int k)
+  {
+    if (k < m_numberOfNodes)
+    {
+      for (int i = 0; i < keysPerNode; ++i)
+      {
+        fill (sortedKeys, next, getChild (k, i));
+
+        int const slot = k * keysPerNode + i;
+
+        if (next < m_size)
+        {
+          new (m_keys + slot) KeyType (sortedKeys [next]);
+          m_positions [slot] = next;
+          ++next;
+        }
+        else
+        {
+          new (m_keys + slot) KeyType (sortedKeys [m_size - 1]);
+          m_positions [slot] = m_size;
+        }
+      }
+
+      fill (sortedKeys, next, getChild (k, keysPerNode));
+    }
+  }
+
+  int m_size;
+  int m_numberOfNodes;
+  KeyType* m_keys;
+  HeapBlock <char> m_block;
+  std::vector <int> m_positions;
+};
+
+#endif
@@ -0,0 +1,281 @@
+/*============================================================================*/
+/*
+  VFLib: https://github.com/vinniefalco/VFLib
+
+  Copyright (C) 2008 by Vinnie Falco <vinnie.falco@gmail.com>
+
+  This library contains portions of other open source products covered by
+  separate licenses. Please see the corresponding source files for specific
+  terms.
+  
+  VFLib is provided under the terms of The MIT License (MIT):
+
+  Permission is hereby granted, free of charge, to any person obtaining a copy
+  of this software and associated documentation files (the "Software"), to deal
+  in the Software without restriction, including without limitation the rights
+  to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+  copies of the Software, and to permit persons to whom the Software is
+  furnished to do so, subject to the following conditions:
+
+  The above copyright notice and this permission notice shall be included in
+  all copies or substantial portions of the Software.
+
+  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+  FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+  IN THE SOFTWARE.
+*/
+/*============================================================================*/
+
+class Benchmark::Worker : public Thread
+{
+public:
+  Worker (Case& benchmarkCase,
+          int threadIndex,
+          Options const& options,
+          WaitableEvent& startEvent)
+    : Thread ("Benchmark")
+    , m_case (benchmarkCase)
+    , m_threadIndex (threadIndex)
+    , m_options (options)
+    , m_startEvent (startEvent)
+  {
+    m_samples.reserve (options.operationsPerThread / options.sampleInterval + 1);
+  }
+
+  ~Worker ()
+  {
+    stopThread (-1);
+  }
+
+  std::vector <int64> const& getSamples () const
+  {
+    return m_samples;
+  }
+
+  void run ()
+  {
+    if (m_options.pinThreads)
+    {
+      int const processor = (m_options.firstProcessor + m_threadIndex) %
+                             jmin (SystemStats::getNumCpus (), 32);
+
+      Thread::setCurrentThreadAffinityMask (uint32 (1) << processor);
+    }
+
+    m_startEvent.wait ();
+
+    int const sampleInterval = m_options.sampleInterval;
+
+    for (int i = 0; i < m_options.operationsPerThread; ++i)
+    {
+      if (i % sampleInterval == 0)
+      {
+        int64 const start = Time::getHighResolutionTicks ();
+
+        m_case.operation (m_threadIndex);
+
+        m_samples.push_back (Time::getHighResolutionTicks () - start);
+      }
+      else
+      {
+        m_case.operation (m_threadIndex);
+      }
+    }
+  }
+
+private:
+  Case& m_case;
+  int const m_threadIndex;
+  Options const& m_options;
+  WaitableEvent& m_startEvent;
+  std::vector <int64> m_samples;
+};
+
+//------------------------------------------------------------------------------
+
+Benchmark::Options::Options ()
+  : operationsPerThread (100000)
+  , warmupOperations (1000)
+  , sampleInterval (1)
+  , pinThreads (false)
+  , firstProcessor (0)
+{
+  int const numberOfCpus = SystemStats::getNumCpus ();
+
+  for (int n = 1; n < numberOfCpus; n *= 2)
+    threadCounts.push_back (n);
+
+  threadCounts.push_back (numberOfCpus);
+
+  payloadSizes.push_back (8);
+}
+
+Benchmark::Benchmark ()
+{
+}
+
+Benchmark::~Benchmark ()
+{
+}
+
+void Benchmark::setOptions (Options const& options)
+{
+  jassert (options.operationsPerThread > 0);
+  jassert (options.sampleInterval > 0);
+
+  m_options = options;
+}
+
+Benchmark::Options const& Benchmark::getOptions () const
+{
+  return m_options;
+}
+
+void Benchmark::add (Case* benchmarkCase)
+{
+  m_cases.add (benchmarkCase);
+}
+
+std::vector <Benchmark::Result> Benchmark::run ()
+{
+  std::vector <Result> results;
+
+  for (int i = 0; i < m_cases.size (); ++i)
+  {
+    for (std::size_t t = 0; t < m_options.threadCounts.size (); ++t)
+    {
+      for (std::size_t p = 0; p < m_options.payloadSizes.size (); ++p)
+      {
+        Parameters parameters;
+        parameters.numberOfThreads = m_options.threadCounts [t];
+        parameters.payloadBytes = m_options.payloadSizes [p];
+
+        results.push_back (measure (*m_cases [i], parameters));
+      }
+    }
+  }
+
+  return results;
+}
+
+Benchmark::Result Benchmark::measure (Case& benchmarkCase, Parameters const& parameters)
+{
+  jassert (parameters.numberOfThreads > 0);
+
+  benchmarkCase.prepare (parameters);
+
+  for (int i = 0; i < m_options.warmupOperations; ++i)
+    benchmarkCase.operation (0);
+
+  int const numberOfCallers = benchmarkCase.isConcurrent () ? parameters.numberOfThreads : 1;
+
+  WaitableEvent startEvent (true);
+  OwnedArray <Worker> workers;
+
+  for (int i = 0; i < numberOfCallers; ++i)
+  {
+    workers.add (new Worker (benchmarkCase, i, m_options, startEvent));
+    workers [i]->startThread ();
+  }
+
+  int64 const start = Time::getHighResolutionTicks ();
+
+  startEvent.signal ();
+
+  for (int i = 0; i < workers.size (); ++i)
+    workers [i]->stopThread (-1);
+
+  int64 const elapsed = Time::getHighResolutionTicks () - start;
+
+  benchmarkCase.finish ();
+
+  std::vector <int64> samples;
+
+  for (int i = 0; i < workers.size (); ++i)
+    samples.insert (samples.end (), workers [i]->getSamples ().begin (), workers [i]->getSamples ().end ());
+
+  std::sort (samples.begin (), samples.end ());
+
+  double const nanosecondsPerTick = 1000000000.0 / Time::getHighResolutionTicksPerSecond ();
+
+  Result result;
+
+  result.name = benchmarkCase.getName ();
+  result.numberOfThreads = parameters.numberOfThreads;
+  result.payloadBytes = parameters.payloadBytes;
+  result.operations = int64 (numberOfCallers) * m_options.operationsPerThread;
+  result.seconds = Time::highResolutionTicksToSeconds (elapsed);
+  result.operationsPerSecond = result.seconds > 0 ? result.operations / result.seconds : 0;
+  result.p50 = getPercentile (samples, 0.5) * nanosecondsPerTick;
+  result.p90 = getPercentile (samples, 0.9) * nanosecondsPerTick;
+  result.p99 = getPercentile (samples, 0.99) * nanosecondsPerTick;
+  result.p999 = getPercentile (samples, 0.999) * nanosecondsPerTick;
+  result.max = getPercentile (samples, 1) * nanosecondsPerTick;
+
+  return result;
+}
+
+double Benchmark::getPercentile (std::vector <int64> const& sorted, double fraction)
+{
+  if (sorted.empty ())
+    return 0;
+
+  std::size_t const index = std::size_t (fraction * (sorted.size () - 1) + 0.5);
+
+  return double (sorted [jmin (index, sorted.size () - 1)]);
+}
+
+String Benchmark::toJSON (std::vector <Result> const& results)
+{
+  String s ("[\n");
+
+  for (std::size_t i = 0; i < results.size (); ++i)
+  {
+    Result const& r = results [i];
+
+    s << "  { \"name\": \"" << r.name.replace ("\\", "\\\\").replace ("\"", "\\\"") << "\""
+      << ", \"threads\": " << r.numberOfThreads
+      << ", \"payload\": " << r.payloadBytes
+      << ", \"operations\": " << r.operations
+      << ", \"seconds\": " << r.seconds
+      << ", \"opsPerSecond\": " << r.operationsPerSecond
+      << ", \"p50\": " << r.p50
+      << ", \"p90\": " << r.p90
+      << ", \"p99\": " << r.p99
+      << ", \"p999\": " << r.p999
+      << ", \"max\": " << r.max
+      << (i + 1 < results.size () ? " },\n" : " }\n");
+  }
+
+  s << "]\n";
+
+  return s;
+}
+
+String Benchmark::toCSV (std::vector <Result> const& results)
+{
+  String s ("name,threads,payload,operations,seconds,opsPerSecond,p50,p90,p99,p999,max\n");
+
+  for (std::size_t i = 0; i < results.size (); ++i)
+  {
+    Result const& r = results [i];
+
+    s << "\"" << r.name.replace ("\"", "\"\"") << "\","
+      << r.numberOfThreads << ","
+      << r.payloadBytes << ","
+      << r.operations << ","
+      << r.seconds << ","
+      << r.operationsPerSecond << ","
+      << r.p50 << ","
+      << r.p90 << ","
+      << r.p99 << ","
+      << r.p999 << ","
+      << r.max << "\n";
+  }
+
+  return s;
+}
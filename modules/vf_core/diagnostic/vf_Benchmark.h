@@ -0,0 +1,245 @@
+/*============================================================================*/
+/*
+  VFLib: https://github.com/vinniefalco/VFLib
+
+  Copyright (C) 2008 by Vinnie Falco <vinnie.falco@gmail.com>
+
+  This library contains portions of other open source products covered by
+  separate licenses. Please see the corresponding source files for specific
+  terms.
+  
+  VFLib is provided under the terms of The MIT License (MIT):
+
+  Permission is hereby granted, free of charge, to any person obtaining a copy
+  of this software and associated documentation files (the "Software"), to deal
+  in the Software without restriction, including without limitation the rights
+  to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+  copies of the Software, and to permit persons to whom the Software is
+  furnished to do so, subject to the following conditions:
+
+  The above copyright notice and this permission notice shall be included in
+  all copies or substantial portions of the Software.
+
+  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+  FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+  IN THE SOFTWARE.
+*/
+/*============================================================================*/
+
+#ifndef VF_BENCHMARK_VFHEADER
+#define VF_BENCHMARK_VFHEADER
+
+/*============================================================================*/
+/**
+  Measures the throughput and latency of operations across threads.
+
+  A benchmark is a set of cases. Each case performs one operation at a time,
+  and the runner calls it from a number of threads in parallel, sweeping
+  over thread counts and payload sizes. For every combination the runner
+  reports the throughput and the latency distribution of the operation.
+
+  @code
+
+  class IncrementCase : public Benchmark::Case
+  {
+  public:
+    String getName () const { return "Atomic increment"; }
+
+    void operation (int)
+    {
+      ++m_value;
+    }
+
+  private:
+    Atomic <int> m_value;
+  };
+
+  Benchmark benchmark;
+
+  benchmark.add (new IncrementCase);
+
+  std::vector <Benchmark::Result> results = benchmark.run ();
+
+  std::cout << Benchmark::toJSON (results);
+
+  @endcode
+
+  Latency is measured by timestamping individual operations with the high
+  resolution timer. For very short operations the cost of the timer is
+  significant, so only every Nth operation may be sampled by setting
+  Options::sampleInterval. Throughput is always measured over all
+  operations.
+
+  Results can be written as JSON or CSV, to be compared against earlier runs
+  by a script.
+
+  @see ConcurrentBenchmark, HashBenchmark, db::bulk_benchmark
+
+  @ingroup vf_core
+*/
+class Benchmark : Uncopyable
+{
+public:
+  /** The configuration of a single measurement.
+  */
+  struct Parameters
+  {
+    int numberOfThreads;
+    int payloadBytes;
+  };
+
+  //============================================================================
+  /**
+    A benchmark case.
+
+    Derived classes implement operation(), and optionally prepare() and
+    finish() to set up and tear down state for each measurement.
+  */
+  class Case
+  {
+  public:
+    virtual ~Case () { }
+
+    /** Retrieve the name used in the results.
+    */
+    virtual String getName () const = 0;
+
+    /** Determine if the operation is called from every thread.
+
+        Cases which are parallel internally, for example ParallelFor, return
+        `false` so that the operation is called from a single thread. They
+        still receive the thread count in prepare().
+    */
+    virtual bool isConcurrent () const
+    {
+      return true;
+    }
+
+    /** Called on the calling thread before a measurement.
+    */
+    virtual void prepare (Parameters const& parameters)
+    {
+      (void) parameters;
+    }
+
+    /** Perform one operation.
+
+        @param threadIndex The index of the calling thread, from zero up to
+                           the number of threads in the measurement.
+    */
+    virtual void operation (int threadIndex) = 0;
+
+    /** Called on the calling thread after a measurement.
+    */
+    virtual void finish ()
+    {
+    }
+  };
+
+  //============================================================================
+  /**
+    The outcome of one measurement.
+
+    Latencies are in nanoseconds.
+  */
+  struct Result
+  {
+    String name;
+    int numberOfThreads;
+    int payloadBytes;
+    int64 operations;
+    double seconds;
+    double operationsPerSecond;
+    double p50;
+    double p90;
+    double p99;
+    double p999;
+    double max;
+  };
+
+  //============================================================================
+  /**
+    Settings which control a run.
+  */
+  struct Options
+  {
+    /** Create the default options.
+
+        The thread counts are powers of two up to the number of processors,
+        with a single payload size of 8 bytes.
+    */
+    Options ();
+
+    /** The thread counts to sweep over. */
+    std::vector <int> threadCounts;
+
+    /** The payload sizes to sweep over, in bytes. */
+    std::vector <int> payloadSizes;
+
+    /** The number of timed operations on each thread. */
+    int operationsPerThread;
+
+    /** The number of untimed operations before the measurement. */
+    int warmupOperations;
+
+    /** Every Nth operation has its latency recorded. */
+    int sampleInterval;
+
+    /** Pin each thread to its own processor. */
+    bool pinThreads;
+
+    /** The processor used by the first thread when pinning. */
+    int firstProcessor;
+  };
+
+  Benchmark ();
+
+  ~Benchmark ();
+
+  /** Change the options for subsequent runs.
+  */
+  void setOptions (Options const& options);
+
+  /** Retrieve the current options.
+  */
+  Options const& getOptions () const;
+
+  /** Add a case.
+
+      The benchmark takes ownership of the case.
+  */
+  void add (Case* benchmarkCase);
+
+  /** Run every case with every combination of thread count and payload.
+
+      @return The results, in the order they were measured.
+  */
+  std::vector <Result> run ();
+
+  /** Measure a single case with the specified parameters.
+  */
+  Result measure (Case& benchmarkCase, Parameters const& parameters);
+
+  /** Format results as a JSON array of objects.
+  */
+  static String toJSON (std::vector <Result> const& results);
+
+  /** Format results as CSV with a header row.
+  */
+  static String toCSV (std::vector <Result> const& results);
+
+private:
+  class Worker;
+
+  static double getPercentile (std::vector <int64> const& sorted, double fraction);
+
+private:
+  Options m_options;
+  OwnedArray <Case> m_cases;
+};
+
+#endif
@@ -176,6 +176,8 @@ bool CatchAny (Function <void (void)> f, bool returnFromException)
   }
   catch (Error& e)
   {
+    e.willBeReported ();
+
     if (!returnFromException)
     {
       JUCEApplication* app = JUCEApplication::getInstance();
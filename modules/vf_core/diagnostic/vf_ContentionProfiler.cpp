@@ -0,0 +1,271 @@
+/*============================================================================*/
+/*
+  VFLib: https://github.com/vinniefalco/VFLib
+
+  Copyright (C) 2008 by Vinnie Falco <vinnie.falco@gmail.com>
+
+  This library contains portions of other open source products covered by
+  separate licenses. Please see the corresponding source files for specific
+  terms.
+  
+  VFLib is provided under the terms of The MIT License (MIT):
+
+  Permission is hereby granted, free of charge, to any person obtaining a copy
+  of this software and associated documentation files (the "Software"), to deal
+  in the Software without restriction, including without limitation the rights
+  to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+  copies of the Software, and to permit persons to whom the Software is
+  furnished to do so, subject to the following conditions:
+
+  The above copyright notice and this permission notice shall be included in
+  all copies or substantial portions of the Software.
+
+  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+  FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+  IN THE SOFTWARE.
+*/
+/*============================================================================*/
+
+ContentionProfiler::Site::Site (String const& name)
+  : m_name (name)
+  , m_isTotals (false)
+  , m_next (nullptr)
+{
+#if VF_USE_CONTENTION_PROFILER
+  ContentionProfiler::addSite (this);
+#endif
+}
+
+ContentionProfiler::Site::Site (String const& name, bool isTotals)
+  : m_name (name)
+  , m_isTotals (isTotals)
+  , m_next (nullptr)
+{
+}
+
+ContentionProfiler::Site::~Site ()
+{
+#if VF_USE_CONTENTION_PROFILER
+  ContentionProfiler::removeSite (this);
+#endif
+}
+
+//------------------------------------------------------------------------------
+
+// The list of sites lives in zero-initialized static storage,
+// so sites can be created during static initialization in any order.
+//
+struct ContentionProfiler::SiteList
+{
+  SpinLock mutex;
+  Site* first;
+};
+
+ContentionProfiler::SiteList& ContentionProfiler::getSiteList ()
+{
+  static Static::Storage <SiteList, ContentionProfiler> s_list;
+
+  return *s_list;
+}
+
+void ContentionProfiler::addSite (Site* site)
+{
+  SiteList& list = getSiteList ();
+
+  SpinLock::ScopedLockType lock (list.mutex);
+
+  site->m_next = list.first;
+  list.first = site;
+}
+
+// The counts of a site that goes away, such as one owned by a CallQueue,
+// are added to a totals site with the same name, which is never freed.
+//
+void ContentionProfiler::removeSite (Site* site)
+{
+#if VF_USE_CONTENTION_PROFILER
+  SiteList& list = getSiteList ();
+
+  SpinLock::ScopedLockType lock (list.mutex);
+
+  for (Site** link = &list.first; *link != nullptr; link = &(*link)->m_next)
+  {
+    if (*link == site)
+    {
+      *link = site->m_next;
+      break;
+    }
+  }
+
+  if (site->m_acquisitions.get () != 0 || site->m_contentions.get () != 0)
+  {
+    Site* totals = list.first;
+
+    while (totals != nullptr && !(totals->m_isTotals && totals->m_name == site->m_name))
+      totals = totals->m_next;
+
+    if (totals == nullptr)
+    {
+      totals = new Site (site->m_name, true);
+
+      totals->m_next = list.first;
+      list.first = totals;
+    }
+
+    totals->m_acquisitions += site->m_acquisitions.get ();
+    totals->m_contentions += site->m_contentions.get ();
+    totals->m_spins += site->m_spins.get ();
+    totals->m_yields += site->m_yields.get ();
+    totals->m_ticksBlocked += site->m_ticksBlocked.get ();
+  }
+#else
+  (void) site;
+#endif
+}
+
+void ContentionProfiler::getReport (std::vector <Report>& report)
+{
+  report.clear ();
+
+#if VF_USE_CONTENTION_PROFILER
+  typedef std::map <String, Report> Map;
+
+  Map map;
+
+  SiteList& list = getSiteList ();
+
+  SpinLock::ScopedLockType lock (list.mutex);
+
+  for (Site* site = list.first; site != nullptr; site = site->m_next)
+  {
+    int64 const acquisitions = site->m_acquisitions.get ();
+    int64 const contentions = site->m_contentions.get ();
+
+    if (acquisitions == 0 && contentions == 0)
+      continue;
+
+    Map::iterator iter = map.find (site->m_name);
+
+    if (iter == map.end ())
+    {
+      Report r;
+
+      r.name = site->m_name;
+      r.acquisitions = 0;
+      r.contentions = 0;
+      r.spins = 0;
+      r.yields = 0;
+      r.secondsBlocked = 0;
+
+      iter = map.insert (Map::value_type (r.name, r)).first;
+    }
+
+    Report& r = iter->second;
+
+    r.acquisitions += acquisitions;
+    r.contentions += contentions;
+    r.spins += site->m_spins.get ();
+    r.yields += site->m_yields.get ();
+    r.secondsBlocked += CpuTicks::ticksToSeconds (site->m_ticksBlocked.get ());
+  }
+
+  for (Map::const_iterator iter = map.begin (); iter != map.end (); ++iter)
+    report.push_back (iter->second);
+
+  std::stable_sort (report.begin (), report.end (), &ContentionProfiler::isMoreBlocked);
+#endif
+}
+
+bool ContentionProfiler::isMoreBlocked (Report const& lhs, Report const& rhs)
+{
+  return lhs.secondsBlocked > rhs.secondsBlocked;
+}
+
+String ContentionProfiler::toString ()
+{
+  std::vector <Report> report;
+
+  getReport (report);
+
+  String s;
+
+  for (std::size_t i = 0; i < report.size (); ++i)
+  {
+    Report const& r = report [i];
+
+    double const percent = r.acquisitions > 0 ?
+      100.0 * r.contentions / r.acquisitions : 0;
+
+    s << r.name << ": "
+      << String (r.acquisitions) << " acquisitions, "
+      << String (r.contentions) << " contended (" << String (percent, 1) << "%), "
+      << String (r.spins) << " spins, "
+      << String (r.yields) << " yields, "
+      << String (r.secondsBlocked * 1000, 3) << " ms blocked\n";
+  }
+
+  return s;
+}
+
+void ContentionProfiler::reset ()
+{
+#if VF_USE_CONTENTION_PROFILER
+  SiteList& list = getSiteList ();
+
+  SpinLock::ScopedLockType lock (list.mutex);
+
+  for (Site* site = list.first; site != nullptr; site = site->m_next)
+  {
+    site->m_acquisitions.set (0);
+    site->m_contentions.set (0);
+    site->m_spins.set (0);
+    site->m_yields.set (0);
+    site->m_ticksBlocked.set (0);
+  }
+#endif
+}
+
+#if VF_USE_CONTENTION_PROFILER
+ContentionProfiler::Site& ContentionProfiler::getLockFreeQueueSite ()
+{
+  static Site* volatile s_instance;
+  static Static::Initializer s_initializer;
+
+  if (s_initializer.begin ())
+  {
+    static Site s_site ("LockFreeQueue::pop_front");
+    s_instance = &s_site;
+    s_initializer.end ();
+  }
+
+  return *s_instance;
+}
+
+ContentionProfiler::Site& ContentionProfiler::getLockFreeStackSite ()
+{
+  static Site* volatile s_instance;
+  static Static::Initializer s_initializer;
+
+  if (s_initializer.begin ())
+  {
+    static Site s_site ("LockFreeStack");
+    s_instance = &s_site;
+    s_initializer.end ();
+  }
+
+  return *s_instance;
+}
+
+#endif
+
+void ContentionProfiler::reportAtExit ()
+{
+  String const report = toString ();
+
+  if (report.isNotEmpty ())
+    Logger::outputDebugString ("[CONTENTION]\n" + report);
+}
@@ -0,0 +1,260 @@
+/*============================================================================*/
+/*
+  VFLib: https://github.com/vinniefalco/VFLib
+
+  Copyright (C) 2008 by Vinnie Falco <vinnie.falco@gmail.com>
+
+  This library contains portions of other open source products covered by
+  separate licenses. Please see the corresponding source files for specific
+  terms.
+  
+  VFLib is provided under the terms of The MIT License (MIT):
+
+  Permission is hereby granted, free of charge, to any person obtaining a copy
+  of this software and associated documentation files (the "Software"), to deal
+  in the Software without restriction, including without limitation the rights
+  to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+  copies of the Software, and to permit persons to whom the Software is
+  furnished to do so, subject to the following conditions:
+
+  The above copyright notice and this permission notice shall be included in
+  all copies or substantial portions of the Software.
+
+  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+  FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+  IN THE SOFTWARE.
+*/
+/*============================================================================*/
+
+#ifndef VF_CONTENTIONPROFILER_VFHEADER
+#define VF_CONTENTIONPROFILER_VFHEADER
+
+#include "vf_CpuTicks.h"
+
+/*============================================================================*/
+/**
+  Measures contention on synchronization primitives.
+
+  When VF_USE_CONTENTION_PROFILER is set to 1 in AppConfig.h, each place
+  where a thread can be held up by another thread counts:
+
+  - Acquisitions, the number of times the lock or resource was obtained.
+
+  - Contentions, the number of times a thread had to spin or block first.
+
+  - Spins and yields, the number of SpinDelay pauses, split into the busy
+    spins and the fallbacks to Thread::yield().
+
+  - The total time spent spinning or blocked.
+
+  The places measured are ReadWriteMutex::enterRead(),
+  ReadWriteMutex::enterWrite(), Semaphore::wait(), LockFreeQueue::pop_front()
+  and the compare and swap loops in LockFreeStack. Each of these objects
+  records into a default site shared by all objects of its type, unless it
+  is constructed with a site of its own. Giving the important shared
+  states their own sites separates them in the report:
+
+  @code
+
+  static ContentionProfiler::Site playlistRead ("Playlist read");
+  static ContentionProfiler::Site playlistWrite ("Playlist write");
+
+  ReadWriteMutex playlistMutex (playlistRead, playlistWrite);
+
+  @endcode
+
+  Each CallQueue and ThreadGroup owns the sites for its queue and
+  semaphore, named after the queue or the group, so that each one is
+  reported on its own line. Waits for a reader in db::session_pool have
+  a site of their own. Sites with the same name are combined in the
+  report.
+
+  An acquisition is counted as contended at most once, even when it waits
+  in more than one place.
+
+  The report is written to the debug output at exit, just before LeakChecked
+  reports leaks. It can also be retrieved at any time:
+
+  @code
+
+  std::vector <ContentionProfiler::Report> report;
+
+  ContentionProfiler::getReport (report);
+
+  if (! report.empty ())
+    DBG ("Most contended: " << report [0].name);
+
+  @endcode
+
+  The report is sorted with the most time blocked first, so the shared
+  states at the top are the ones that most need to be redesigned.
+
+  When the profiler is turned off, sites still exist but recording compiles
+  to nothing.
+
+  @ingroup vf_core
+*/
+class ContentionProfiler
+{
+public:
+  //============================================================================
+  /**
+    A place where threads contend.
+
+    A site may be static, or a member of the object it measures. When a
+    site is destroyed its counts are kept, under its name, for the report.
+  */
+  class Site : Uncopyable
+  {
+  public:
+    /** Create a site.
+
+        @param name The name identifying the site in the report.
+    */
+    explicit Site (String const& name);
+
+    ~Site ();
+
+    /** Retrieve the name of the site.
+    */
+    String const& getName () const
+    {
+      return m_name;
+    }
+
+    /** Record an acquisition.
+    */
+    inline void addAcquisition ()
+    {
+#if VF_USE_CONTENTION_PROFILER
+      ++m_acquisitions;
+#endif
+    }
+
+    /** Record a wait for another thread.
+
+        @param spins        The number of busy spins.
+        @param yields       The number of times the thread yielded.
+        @param ticksBlocked The time spent waiting, in CpuTicks.
+    */
+    inline void addContention (int spins, int yields, int64 ticksBlocked)
+    {
+#if VF_USE_CONTENTION_PROFILER
+      ++m_contentions;
+      m_spins += spins;
+      m_yields += yields;
+      m_ticksBlocked += ticksBlocked;
+#else
+      (void) spins;
+      (void) yields;
+      (void) ticksBlocked;
+#endif
+    }
+
+  private:
+    friend class ContentionProfiler;
+
+    // Creates the totals kept for destroyed sites.
+    Site (String const& name, bool isTotals);
+
+    String const m_name;
+    bool const m_isTotals;
+    Site* m_next;
+
+#if VF_USE_CONTENTION_PROFILER
+    Atomic <int64> m_acquisitions;
+    Atomic <int64> m_contentions;
+    Atomic <int64> m_spins;
+    Atomic <int64> m_yields;
+    Atomic <int64> m_ticksBlocked;
+#endif
+  };
+
+  //============================================================================
+  /**
+    Records the time a thread is blocked, from construction to destruction.
+  */
+  class ScopedBlock : Uncopyable
+  {
+  public:
+    explicit ScopedBlock (Site& site)
+#if VF_USE_CONTENTION_PROFILER
+      : m_site (site)
+      , m_startTicks (CpuTicks::getTicks ())
+#endif
+    {
+      (void) site;
+    }
+
+    ~ScopedBlock ()
+    {
+#if VF_USE_CONTENTION_PROFILER
+      m_site.addContention (0, 0, CpuTicks::getTicks () - m_startTicks);
+#endif
+    }
+
+  private:
+#if VF_USE_CONTENTION_PROFILER
+    Site& m_site;
+    int64 const m_startTicks;
+#endif
+  };
+
+  //============================================================================
+  /**
+    The totals for all sites with the same name.
+  */
+  struct Report
+  {
+    String name;
+    int64 acquisitions;
+    int64 contentions;
+    int64 spins;
+    int64 yields;
+    double secondsBlocked;
+  };
+
+  /** Retrieve the totals for every site.
+
+      Sites are sorted by the time blocked, from most to least. Nothing is
+      reported when the profiler is turned off.
+
+      @param report The vector to fill. Previous contents are discarded.
+  */
+  static void getReport (std::vector <Report>& report);
+
+  /** Format the report as text, one line per site.
+  */
+  static String toString ();
+
+  /** Set every counter back to zero.
+  */
+  static void reset ();
+
+#if VF_USE_CONTENTION_PROFILER
+  /** The site used by every LockFreeQueue without a site of its own.
+  */
+  static Site& getLockFreeQueueSite ();
+
+  /** The site used by every LockFreeStack without a site of its own.
+  */
+  static Site& getLockFreeStackSite ();
+#endif
+
+private:
+  friend class PerformedAtExit;
+
+  struct SiteList;
+
+  static void reportAtExit ();
+  static SiteList& getSiteList ();
+  static void addSite (Site* site);
+  static void removeSite (Site* site);
+  static bool isMoreBlocked (Report const& lhs, Report const& rhs);
+};
+
+#endif
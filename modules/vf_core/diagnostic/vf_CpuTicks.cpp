@@ -0,0 +1,81 @@
+/*============================================================================*/
+/*
+  VFLib: https://github.com/vinniefalco/VFLib
+
+  Copyright (C) 2008 by Vinnie Falco <vinnie.falco@gmail.com>
+
+  This library contains portions of other open source products covered by
+  separate licenses. Please see the corresponding source files for specific
+  terms.
+  
+  VFLib is provided under the terms of The MIT License (MIT):
+
+  Permission is hereby granted, free of charge, to any person obtaining a copy
+  of this software and associated documentation files (the "Software"), to deal
+  in the Software without restriction, including without limitation the rights
+  to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+  copies of the Software, and to permit persons to whom the Software is
+  furnished to do so, subject to the following conditions:
+
+  The above copyright notice and this permission notice shall be included in
+  all copies or substantial portions of the Software.
+
+  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+  FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+  IN THE SOFTWARE.
+*/
+/*============================================================================*/
+
+int64 CpuTicks::getTicksPerSecond ()
+{
+  // Zero until the first call. Concurrent first calls each
+  // calibrate, and store approximately the same value.
+  //
+  static Static::Storage <Atomic <int64>, CpuTicks> s_ticksPerSecond;
+
+  int64 ticksPerSecond = s_ticksPerSecond->get ();
+
+  if (ticksPerSecond == 0)
+  {
+    ticksPerSecond = calibrate ();
+
+    s_ticksPerSecond->set (ticksPerSecond);
+  }
+
+  return ticksPerSecond;
+}
+
+double CpuTicks::ticksToSeconds (int64 ticks)
+{
+  return double (ticks) / getTicksPerSecond ();
+}
+
+double CpuTicks::ticksToNanoseconds (int64 ticks)
+{
+  return double (ticks) * 1000000000.0 / getTicksPerSecond ();
+}
+
+int64 CpuTicks::calibrate ()
+{
+#if JUCE_INTEL && (JUCE_MSVC || JUCE_GCC || JUCE_CLANG)
+  // Count ticks over a short interval of the high resolution timer.
+  //
+  int64 const startTime = Time::getHighResolutionTicks ();
+  int64 const startTicks = getTicks ();
+
+  Thread::sleep (20);
+
+  int64 const elapsedTime = Time::getHighResolutionTicks () - startTime;
+  int64 const elapsedTicks = getTicks () - startTicks;
+
+  return jmax (int64 (1), int64 (elapsedTicks / Time::highResolutionTicksToSeconds (elapsedTime)));
+
+#else
+  return Time::getHighResolutionTicksPerSecond ();
+
+#endif
+}
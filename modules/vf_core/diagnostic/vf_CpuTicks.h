@@ -0,0 +1,94 @@
+/*============================================================================*/
+/*
+  VFLib: https://github.com/vinniefalco/VFLib
+
+  Copyright (C) 2008 by Vinnie Falco <vinnie.falco@gmail.com>
+
+  This library contains portions of other open source products covered by
+  separate licenses. Please see the corresponding source files for specific
+  terms.
+  
+  VFLib is provided under the terms of The MIT License (MIT):
+
+  Permission is hereby granted, free of charge, to any person obtaining a copy
+  of this software and associated documentation files (the "Software"), to deal
+  in the Software without restriction, including without limitation the rights
+  to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+  copies of the Software, and to permit persons to whom the Software is
+  furnished to do so, subject to the following conditions:
+
+  The above copyright notice and this permission notice shall be included in
+  all copies or substantial portions of the Software.
+
+  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+  FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+  IN THE SOFTWARE.
+*/
+/*============================================================================*/
+
+#ifndef VF_CPUTICKS_VFHEADER
+#define VF_CPUTICKS_VFHEADER
+
+/*============================================================================*/
+/**
+  A cheap, high resolution timestamp.
+
+  On Intel processors this reads the time stamp counter, which costs a few
+  nanoseconds and does not enter the kernel. Elsewhere it falls back to
+  Time::getHighResolutionTicks(). This is meant for instrumentation which
+  timestamps every event, where the cost of the clock matters.
+
+  Ticks are only useful as differences. The rate is measured once against
+  the high resolution timer, the first time it is needed.
+
+  @note The time stamp counter is assumed to be invariant, that is, to run at
+        a constant rate and be synchronized across processors. This is true
+        of every desktop processor made in recent years, but a difference
+        between two timestamps taken on different processors of an older
+        machine may be wrong.
+
+  @ingroup vf_core
+*/
+class CpuTicks
+{
+public:
+  /** Retrieve the current tick count.
+  */
+  static inline int64 getTicks () noexcept
+  {
+#if JUCE_INTEL && JUCE_MSVC
+    return int64 (__rdtsc ());
+
+#elif JUCE_INTEL && (JUCE_GCC || JUCE_CLANG)
+    uint32 lo;
+    uint32 hi;
+    __asm__ __volatile__ ("rdtsc" : "=a" (lo), "=d" (hi));
+    return int64 ((uint64 (hi) << 32) | lo);
+
+#else
+    return Time::getHighResolutionTicks ();
+
+#endif
+  }
+
+  /** Retrieve the number of ticks in one second.
+  */
+  static int64 getTicksPerSecond ();
+
+  /** Convert a number of ticks to seconds.
+  */
+  static double ticksToSeconds (int64 ticks);
+
+  /** Convert a number of ticks to nanoseconds.
+  */
+  static double ticksToNanoseconds (int64 ticks);
+
+private:
+  static int64 calibrate ();
+};
+
+#endif
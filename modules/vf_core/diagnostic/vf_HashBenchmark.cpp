@@ -0,0 +1,154 @@
+/*============================================================================*/
+/*
+  VFLib: https://github.com/vinniefalco/VFLib
+
+  Copyright (C) 2008 by Vinnie Falco <vinnie.falco@gmail.com>
+
+  This library contains portions of other open source products covered by
+  separate licenses. Please see the corresponding source files for specific
+  terms.
+  
+  VFLib is provided under the terms of The MIT License (MIT):
+
+  Permission is hereby granted, free of charge, to any person obtaining a copy
+  of this software and associated documentation files (the "Software"), to deal
+  in the Software without restriction, including without limitation the rights
+  to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+  copies of the Software, and to permit persons to whom the Software is
+  furnished to do so, subject to the following conditions:
+
+  The above copyright notice and this permission notice shall be included in
+  all copies or substantial portions of the Software.
+
+  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+  FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+  IN THE SOFTWARE.
+*/
+/*============================================================================*/
+
+class HashBenchmark::HashCase : public Benchmark::Case
+{
+public:
+  typedef uint64 (*HashFunction) (void const* data, size_t bytes);
+
+  HashCase (String name, HashFunction hashFunction)
+    : m_name (name)
+    , m_hashFunction (hashFunction)
+  {
+  }
+
+  String getName () const
+  {
+    return m_name;
+  }
+
+  void prepare (Benchmark::Parameters const& parameters)
+  {
+    m_payloadBytes = size_t (parameters.payloadBytes);
+
+    m_data.malloc (m_payloadBytes + 1);
+
+    Random random (1);
+    for (size_t i = 0; i < m_payloadBytes; ++i)
+      m_data [i] = uint8 (random.nextInt (256));
+
+    m_results.calloc (parameters.numberOfThreads);
+  }
+
+  void operation (int threadIndex)
+  {
+    m_results [threadIndex].value ^= m_hashFunction (m_data, m_payloadBytes);
+  }
+
+  void finish ()
+  {
+    m_data.free ();
+    m_results.free ();
+  }
+
+  //----------------------------------------------------------------------------
+
+  static uint64 murmurX86_32 (void const* data, size_t bytes)
+  {
+    uint32 hash;
+    Murmur::MurmurHash3_x86_32 (data, int (bytes), 0, &hash);
+    return hash;
+  }
+
+  static uint64 murmurX64_128 (void const* data, size_t bytes)
+  {
+    uint64 hash [2];
+    Murmur::MurmurHash3_x64_128 (data, int (bytes), 0, hash);
+    return hash [0];
+  }
+
+  static uint64 murmurStream128 (void const* data, size_t bytes)
+  {
+    Murmur::Stream128 stream;
+
+    for (size_t offset = 0; offset < bytes; offset += pieceBytes)
+      stream.update (static_cast <uint8 const*> (data) + offset, jmin (size_t (pieceBytes), bytes - offset));
+
+    uint64 hash [2];
+    stream.getHash (hash);
+    return hash [0];
+  }
+
+  template <XXHash3::Implementation implementation>
+  static uint64 xxHash3 (void const* data, size_t bytes)
+  {
+    return XXHash3::hash (implementation, data, bytes);
+  }
+
+  static uint64 xxHash3Stream (void const* data, size_t bytes)
+  {
+    XXHash3 stream;
+
+    for (size_t offset = 0; offset < bytes; offset += pieceBytes)
+      stream.update (static_cast <uint8 const*> (data) + offset, jmin (size_t (pieceBytes), bytes - offset));
+
+    return stream.getHash ();
+  }
+
+private:
+  enum
+  {
+    pieceBytes = 4096
+  };
+
+  // Keeps the results live, padded to avoid false sharing.
+  struct Result
+  {
+    uint64 value;
+    char pad [64 - sizeof (uint64)];
+  };
+
+  String const m_name;
+  HashFunction const m_hashFunction;
+  size_t m_payloadBytes;
+  HeapBlock <uint8> m_data;
+  HeapBlock <Result> m_results;
+};
+
+//------------------------------------------------------------------------------
+
+void HashBenchmark::addAllCases (Benchmark& benchmark)
+{
+  benchmark.add (new HashCase ("MurmurHash3_x86_32", &HashCase::murmurX86_32));
+  benchmark.add (new HashCase ("MurmurHash3_x64_128", &HashCase::murmurX64_128));
+  benchmark.add (new HashCase ("Murmur::Stream128", &HashCase::murmurStream128));
+
+  benchmark.add (new HashCase ("XXHash3 scalar", &HashCase::xxHash3 <XXHash3::implementationScalar>));
+
+  if (XXHash3::isSupported (XXHash3::implementationSSE2))
+    benchmark.add (new HashCase ("XXHash3 SSE2", &HashCase::xxHash3 <XXHash3::implementationSSE2>));
+
+  if (XXHash3::isSupported (XXHash3::implementationAVX2))
+    benchmark.add (new HashCase ("XXHash3 AVX2", &HashCase::xxHash3 <XXHash3::implementationAVX2>));
+
+  benchmark.add (new HashCase ("XXHash3 incremental", &HashCase::xxHash3Stream));
+}
@@ -0,0 +1,82 @@
+/*============================================================================*/
+/*
+  VFLib: https://github.com/vinniefalco/VFLib
+
+  Copyright (C) 2008 by Vinnie Falco <vinnie.falco@gmail.com>
+
+  This library contains portions of other open source products covered by
+  separate licenses. Please see the corresponding source files for specific
+  terms.
+  
+  VFLib is provided under the terms of The MIT License (MIT):
+
+  Permission is hereby granted, free of charge, to any person obtaining a copy
+  of this software and associated documentation files (the "Software"), to deal
+  in the Software without restriction, including without limitation the rights
+  to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+  copies of the Software, and to permit persons to whom the Software is
+  furnished to do so, subject to the following conditions:
+
+  The above copyright notice and this permission notice shall be included in
+  all copies or substantial portions of the Software.
+
+  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+  FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+  IN THE SOFTWARE.
+*/
+/*============================================================================*/
+
+#ifndef VF_HASHBENCHMARK_VFHEADER
+#define VF_HASHBENCHMARK_VFHEADER
+
+/*============================================================================*/
+/**
+  Benchmark cases for the hash functions.
+
+  Each case hashes a buffer of the payload size, so the throughput in bytes
+  per second is the operations per second multiplied by the payload size.
+  Use large payloads to compare the hashes for files and blobs:
+
+  @code
+
+  Benchmark benchmark;
+
+  Benchmark::Options options;
+  options.threadCounts.assign (1, 1);
+  options.payloadSizes.push_back (64);
+  options.payloadSizes.push_back (4096);
+  options.payloadSizes.push_back (1024 * 1024);
+  options.operationsPerThread = 1000;
+  benchmark.setOptions (options);
+
+  HashBenchmark::addAllCases (benchmark);
+
+  std::cout << Benchmark::toCSV (benchmark.run ());
+
+  @endcode
+
+  The cases are:
+
+  - MurmurHash3_x86_32 and MurmurHash3_x64_128, the one-shot Murmur hashes.
+  - Murmur::Stream128, fed in 4096 byte pieces.
+  - XXHash3 with each implementation the processor supports.
+  - XXHash3 incremental, fed in 4096 byte pieces.
+
+  @ingroup vf_core
+*/
+class HashBenchmark
+{
+public:
+  /** Add every case to a benchmark.
+  */
+  static void addAllCases (Benchmark& benchmark);
+
+private:
+  class HashCase;
+};
+
+#endif
@@ -0,0 +1,353 @@
+/*============================================================================*/
+/*
+  VFLib: https://github.com/vinniefalco/VFLib
+
+  Copyright (C) 2008 by Vinnie Falco <vinnie.falco@gmail.com>
+
+  This library contains portions of other open source products covered by
+  separate licenses. Please see the corresponding source files for specific
+  terms.
+  
+  VFLib is provided under the terms of The MIT License (MIT):
+
+  Permission is hereby granted, free of charge, to any person obtaining a copy
+  of this software and associated documentation files (the "Software"), to deal
+  in the Software without restriction, including without limitation the rights
+  to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+  copies of the Software, and to permit persons to whom the Software is
+  furnished to do so, subject to the following conditions:
+
+  The above copyright notice and this permission notice shall be included in
+  all copies or substantial portions of the Software.
+
+  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+  FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+  IN THE SOFTWARE.
+*/
+/*============================================================================*/
+
+#if VF_USE_REALTIME_CHECKER
+
+namespace
+{
+
+#if JUCE_WINDOWS
+extern "C" __declspec (dllimport) unsigned short __stdcall RtlCaptureStackBackTrace (
+  unsigned long framesToSkip, unsigned long framesToCapture, void** backTrace, unsigned long* backTraceHash);
+#endif
+
+enum
+{
+  maxRecords = 256,
+  maxFrames = 32
+};
+
+enum
+{
+  stateEmpty = 0, // must be zero
+  stateWriting,
+  stateReady
+};
+
+// Threads are marked with native thread local storage, because
+// ThreadLocalValue allocates memory the first time it is used.
+//
+#if JUCE_MSVC
+__declspec (thread) int s_realtimeDepth;
+__declspec (thread) int s_allowedDepth;
+#else
+__thread int s_realtimeDepth;
+__thread int s_allowedDepth;
+#endif
+
+struct Record
+{
+  Atomic <int> state;
+  Atomic <int64> count;
+  char const* what;
+  uint32 hash;
+  int numberOfFrames;
+  void* frames [maxFrames];
+};
+
+// Violations are recorded into a fixed size open addressed table,
+// so that recording never allocates memory. This lives in zero
+// initialized static storage, since operator new can be called
+// during static initialization.
+//
+struct Table
+{
+  Record records [maxRecords];
+  Atomic <int64> overflow;
+  Atomic <int> shouldTrap;
+};
+
+Static::Storage <Table, RealtimeChecker> s_table;
+
+}
+
+//------------------------------------------------------------------------------
+
+void RealtimeChecker::enterRealtime ()
+{
+  ++s_realtimeDepth;
+}
+
+void RealtimeChecker::exitRealtime ()
+{
+  jassert (s_realtimeDepth > 0);
+
+  --s_realtimeDepth;
+}
+
+void RealtimeChecker::enterAllowed ()
+{
+  ++s_allowedDepth;
+}
+
+void RealtimeChecker::exitAllowed ()
+{
+  jassert (s_allowedDepth > 0);
+
+  --s_allowedDepth;
+}
+
+void RealtimeChecker::checkRealtime (char const* what)
+{
+  if (s_realtimeDepth > 0 && s_allowedDepth == 0)
+  {
+    // Anything called from here on, such as the trap,
+    // is allowed so that we do not report ourselves.
+    //
+    ++s_allowedDepth;
+
+    void* frames [maxFrames];
+
+    int const numberOfFrames = captureStack (frames, maxFrames);
+
+    uint32 hash;
+
+    Murmur::MurmurHash3_x86_32 (frames,
+                                int (numberOfFrames * sizeof (void*)),
+                                uint32 (pointer_sized_int (what)),
+                                &hash);
+
+    Table& table = *s_table;
+
+    bool recorded = false;
+
+    for (int i = 0; i < maxRecords && ! recorded; ++i)
+    {
+      Record& record = table.records [(hash + i) % maxRecords];
+
+      int state = record.state.get ();
+
+      if (state == stateEmpty)
+      {
+        if (record.state.compareAndSetBool (stateWriting, stateEmpty))
+        {
+          record.what = what;
+          record.hash = hash;
+          record.numberOfFrames = numberOfFrames;
+          memcpy (record.frames, frames, numberOfFrames * sizeof (void*));
+          record.count.set (1);
+          record.state.set (stateReady);
+
+          recorded = true;
+        }
+        else
+        {
+          state = record.state.get ();
+        }
+      }
+
+      if (! recorded)
+      {
+        // Another thread is filling in this record.
+        if (state == stateWriting)
+        {
+          SpinDelay delay;
+
+          do
+          {
+            delay.pause ();
+          }
+          while (record.state.get () == stateWriting);
+        }
+
+        if (record.hash == hash &&
+            record.what == what &&
+            record.numberOfFrames == numberOfFrames &&
+            memcmp (record.frames, frames, numberOfFrames * sizeof (void*)) == 0)
+        {
+          ++record.count;
+
+          recorded = true;
+        }
+      }
+    }
+
+    if (! recorded)
+      ++table.overflow;
+
+    if (table.shouldTrap.get () != 0)
+    {
+      // An unsafe call was made on a real-time thread.
+      // Look at the call stack to see where it came from.
+      jassertfalse;
+    }
+
+    --s_allowedDepth;
+  }
+}
+
+int RealtimeChecker::captureStack (void** frames, int maxFrames)
+{
+#if JUCE_WINDOWS
+  return RtlCaptureStackBackTrace (0, maxFrames, frames, nullptr);
+
+#elif JUCE_LINUX || JUCE_MAC || JUCE_IOS
+  return backtrace (frames, maxFrames);
+
+#else
+  (void) frames;
+  (void) maxFrames;
+
+  return 0;
+
+#endif
+}
+
+StringArray RealtimeChecker::describeStack (void* const* frames, int numberOfFrames)
+{
+  StringArray stack;
+
+#if JUCE_LINUX || JUCE_MAC || JUCE_IOS
+  char** const symbols = backtrace_symbols (frames, numberOfFrames);
+
+  if (symbols != nullptr)
+  {
+    for (int i = 0; i < numberOfFrames; ++i)
+      stack.add (symbols [i]);
+
+    ::free (symbols);
+  }
+#endif
+
+  if (stack.size () == 0)
+  {
+    for (int i = 0; i < numberOfFrames; ++i)
+      stack.add ("0x" + String::toHexString (int64 (pointer_sized_int (frames [i]))));
+  }
+
+  return stack;
+}
+
+#endif
+
+//------------------------------------------------------------------------------
+
+bool RealtimeChecker::isRealtimeThread ()
+{
+#if VF_USE_REALTIME_CHECKER
+  return s_realtimeDepth > 0;
+#else
+  return false;
+#endif
+}
+
+void RealtimeChecker::setTrapEnabled (bool shouldTrap)
+{
+#if VF_USE_REALTIME_CHECKER
+  s_table->shouldTrap.set (shouldTrap ? 1 : 0);
+#else
+  (void) shouldTrap;
+#endif
+}
+
+void RealtimeChecker::getReport (std::vector <Report>& report)
+{
+  report.clear ();
+
+#if VF_USE_REALTIME_CHECKER
+  Table& table = *s_table;
+
+  for (int i = 0; i < maxRecords; ++i)
+  {
+    Record const& record = table.records [i];
+
+    if (record.state.get () == stateReady)
+    {
+      Report r;
+
+      r.what = record.what;
+      r.count = record.count.get ();
+      r.stack = describeStack (record.frames, record.numberOfFrames);
+
+      report.push_back (r);
+    }
+  }
+
+  std::stable_sort (report.begin (), report.end (), &RealtimeChecker::isMoreFrequent);
+#endif
+}
+
+bool RealtimeChecker::isMoreFrequent (Report const& lhs, Report const& rhs)
+{
+  return lhs.count > rhs.count;
+}
+
+String RealtimeChecker::toString ()
+{
+  std::vector <Report> report;
+
+  getReport (report);
+
+  String s;
+
+  for (std::size_t i = 0; i < report.size (); ++i)
+  {
+    Report const& r = report [i];
+
+    s << r.what << ": " << String (r.count) << " times\n";
+
+    for (int j = 0; j < r.stack.size (); ++j)
+      s << "    " << r.stack [j] << "\n";
+  }
+
+#if VF_USE_REALTIME_CHECKER
+  int64 const overflow = s_table->overflow.get ();
+
+  if (overflow > 0)
+    s << String (overflow) << " more were not recorded\n";
+#endif
+
+  return s;
+}
+
+void RealtimeChecker::reset ()
+{
+#if VF_USE_REALTIME_CHECKER
+  Table& table = *s_table;
+
+  for (int i = 0; i < maxRecords; ++i)
+  {
+    table.records [i].state.set (stateEmpty);
+    table.records [i].count.set (0);
+  }
+
+  table.overflow.set (0);
+#endif
+}
+
+void RealtimeChecker::reportAtExit ()
+{
+  String const report = toString ();
+
+  if (report.isNotEmpty ())
+    Logger::outputDebugString ("[REALTIME]\n" + report);
+}
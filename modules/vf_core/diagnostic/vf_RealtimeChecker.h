@@ -0,0 +1,237 @@
+/*============================================================================*/
+/*
+  VFLib: https://github.com/vinniefalco/VFLib
+
+  Copyright (C) 2008 by Vinnie Falco <vinnie.falco@gmail.com>
+
+  This library contains portions of other open source products covered by
+  separate licenses. Please see the corresponding source files for specific
+  terms.
+  
+  VFLib is provided under the terms of The MIT License (MIT):
+
+  Permission is hereby granted, free of charge, to any person obtaining a copy
+  of this software and associated documentation files (the "Software"), to deal
+  in the Software without restriction, including without limitation the rights
+  to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+  copies of the Software, and to permit persons to whom the Software is
+  furnished to do so, subject to the following conditions:
+
+  The above copyright notice and this permission notice shall be included in
+  all copies or substantial portions of the Software.
+
+  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+  FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+  IN THE SOFTWARE.
+*/
+/*============================================================================*/
+
+#ifndef VF_REALTIMECHECKER_VFHEADER
+#define VF_REALTIMECHECKER_VFHEADER
+
+/*============================================================================*/
+/**
+  Reports calls which are unsafe on a real-time thread.
+
+  Code running on the audio device thread must not allocate memory or wait
+  for another thread, since either one can take an unbounded amount of time.
+  CallQueue, ConcurrentState and AudioBufferPool are designed so that this
+  is never necessary, and this class verifies that it never happens.
+
+  A thread is real-time while it holds a ScopedRealtime:
+
+  @code
+
+  void audioDeviceIOCallback (const float** inputChannelData,
+                              int numInputChannels,
+                              float** outputChannelData,
+                              int numOutputChannels,
+                              int numSamples)
+  {
+    RealtimeChecker::ScopedRealtime realtime;
+
+    m_queue.synchronize ();
+
+    // do audio i/o
+  }
+
+  @endcode
+
+  When VF_USE_REALTIME_CHECKER is set to 1 in AppConfig.h, the following
+  are reported when called on a real-time thread:
+
+  - operator new and operator delete, which are replaced globally.
+
+  - Semaphore::wait(), ReadWriteMutex::enterRead() and
+    ReadWriteMutex::enterWrite(), InterruptibleThread::wait(),
+    Future::wait() and ParallelFor::loop().
+
+  - CheckedCriticalSection::enter(). JUCE's CriticalSection cannot be
+    hooked from outside, so use CheckedCriticalSection in its place for
+    locks that must be kept off the audio thread. It can be given to
+    templates such as AudioBufferPool as the lock type.
+
+  - Any other place marked with a call to check().
+
+  Each distinct combination of call and stack trace is counted once, with
+  the number of times it happened. The report is written to the debug
+  output at exit, before LeakChecked reports leaks. Recording a violation
+  does not allocate memory, so the report does not disturb the thread
+  being checked.
+
+  Stack traces are symbolized on Mac OS X, iOS and Linux. On Windows the
+  raw addresses are shown, to be looked up in the debugger.
+
+  When the checker is turned off, everything here compiles to nothing and
+  CheckedCriticalSection is a plain CriticalSection.
+
+  @ingroup vf_core
+*/
+class RealtimeChecker
+{
+public:
+  /** Marks the calling thread as real-time for the lifetime of the object.
+
+      These may be nested.
+  */
+  class ScopedRealtime : Uncopyable
+  {
+  public:
+    inline ScopedRealtime ()
+    {
+#if VF_USE_REALTIME_CHECKER
+      enterRealtime ();
+#endif
+    }
+
+    inline ~ScopedRealtime ()
+    {
+#if VF_USE_REALTIME_CHECKER
+      exitRealtime ();
+#endif
+    }
+  };
+
+  /** Permits unsafe calls on a real-time thread for the lifetime of the object.
+
+      This is for calls which are known to be harmless, for example an
+      allocation which only happens the first time through.
+  */
+  class ScopedAllowed : Uncopyable
+  {
+  public:
+    inline ScopedAllowed ()
+    {
+#if VF_USE_REALTIME_CHECKER
+      enterAllowed ();
+#endif
+    }
+
+    inline ~ScopedAllowed ()
+    {
+#if VF_USE_REALTIME_CHECKER
+      exitAllowed ();
+#endif
+    }
+  };
+
+  /** One distinct violation.
+  */
+  struct Report
+  {
+    String what;
+    int64 count;
+    StringArray stack;
+  };
+
+  /** Determine if the calling thread is real-time.
+  */
+  static bool isRealtimeThread ();
+
+  /** Report a call which is unsafe on a real-time thread.
+
+      Nothing happens unless the calling thread is real-time.
+
+      @param what A string literal naming the call.
+  */
+  static inline void check (char const* what)
+  {
+#if VF_USE_REALTIME_CHECKER
+    checkRealtime (what);
+#else
+    (void) what;
+#endif
+  }
+
+  /** Stop in the debugger on every violation.
+
+      By default violations are only counted.
+  */
+  static void setTrapEnabled (bool shouldTrap);
+
+  /** Retrieve every violation, the most frequent first.
+
+      @param report The vector to fill. Previous contents are discarded.
+  */
+  static void getReport (std::vector <Report>& report);
+
+  /** Format the report as text.
+  */
+  static String toString ();
+
+  /** Forget every violation.
+
+      This must not be called while other threads may be checked.
+  */
+  static void reset ();
+
+private:
+  friend class PerformedAtExit;
+
+  static void reportAtExit ();
+  static void enterRealtime ();
+  static void exitRealtime ();
+  static void enterAllowed ();
+  static void exitAllowed ();
+  static void checkRealtime (char const* what);
+  static int captureStack (void** frames, int maxFrames);
+  static StringArray describeStack (void* const* frames, int numberOfFrames);
+  static bool isMoreFrequent (Report const& lhs, Report const& rhs);
+};
+
+//------------------------------------------------------------------------------
+
+#if VF_USE_REALTIME_CHECKER
+
+/** A CriticalSection which is reported when entered on a real-time thread.
+
+    @see RealtimeChecker
+
+    @ingroup vf_core
+*/
+class CheckedCriticalSection : public CriticalSection
+{
+public:
+  typedef GenericScopedLock <CheckedCriticalSection> ScopedLockType;
+  typedef GenericScopedUnlock <CheckedCriticalSection> ScopedUnlockType;
+  typedef GenericScopedTryLock <CheckedCriticalSection> ScopedTryLockType;
+
+  inline void enter () const noexcept
+  {
+    RealtimeChecker::check ("CriticalSection::enter");
+
+    CriticalSection::enter ();
+  }
+};
+
+#else
+
+typedef CriticalSection CheckedCriticalSection;
+
+#endif
+
+#endif
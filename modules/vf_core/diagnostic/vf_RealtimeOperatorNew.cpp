@@ -0,0 +1,123 @@
+/*============================================================================*/
+/*
+  VFLib: https://github.com/vinniefalco/VFLib
+
+  Copyright (C) 2008 by Vinnie Falco <vinnie.falco@gmail.com>
+
+  This library contains portions of other open source products covered by
+  separate licenses. Please see the corresponding source files for specific
+  terms.
+  
+  VFLib is provided under the terms of The MIT License (MIT):
+
+  Permission is hereby granted, free of charge, to any person obtaining a copy
+  of this software and associated documentation files (the "Software"), to deal
+  in the Software without restriction, including without limitation the rights
+  to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+  copies of the Software, and to permit persons to whom the Software is
+  furnished to do so, subject to the following conditions:
+
+  The above copyright notice and this permission notice shall be included in
+  all copies or substantial portions of the Software.
+
+  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+  FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+  IN THE SOFTWARE.
+*/
+/*============================================================================*/
+
+// Replacements for the global operator new and operator delete,
+// which report calls made on a real-time thread. See RealtimeChecker.
+//
+// This is included outside of the vf namespace.
+
+// C++11 removed the exception specification from operator new.
+#if JUCE_COMPILER_SUPPORTS_NOEXCEPT
+# define VF_THROWS_BAD_ALLOC
+#else
+# define VF_THROWS_BAD_ALLOC throw (std::bad_alloc)
+#endif
+
+void* operator new (std::size_t bytes) VF_THROWS_BAD_ALLOC
+{
+  vf::RealtimeChecker::check ("operator new");
+
+  void* const p = ::malloc (bytes > 0 ? bytes : 1);
+
+  if (p == nullptr)
+    throw std::bad_alloc ();
+
+  return p;
+}
+
+void* operator new[] (std::size_t bytes) VF_THROWS_BAD_ALLOC
+{
+  vf::RealtimeChecker::check ("operator new[]");
+
+  void* const p = ::malloc (bytes > 0 ? bytes : 1);
+
+  if (p == nullptr)
+    throw std::bad_alloc ();
+
+  return p;
+}
+
+void* operator new (std::size_t bytes, std::nothrow_t const&) noexcept
+{
+  vf::RealtimeChecker::check ("operator new");
+
+  return ::malloc (bytes > 0 ? bytes : 1);
+}
+
+void* operator new[] (std::size_t bytes, std::nothrow_t const&) noexcept
+{
+  vf::RealtimeChecker::check ("operator new[]");
+
+  return ::malloc (bytes > 0 ? bytes : 1);
+}
+
+void operator delete (void* p) noexcept
+{
+  if (p != nullptr)
+  {
+    vf::RealtimeChecker::check ("operator delete");
+
+    ::free (p);
+  }
+}
+
+void operator delete[] (void* p) noexcept
+{
+  if (p != nullptr)
+  {
+    vf::RealtimeChecker::check ("operator delete[]");
+
+    ::free (p);
+  }
+}
+
+void operator delete (void* p, std::nothrow_t const&) noexcept
+{
+  if (p != nullptr)
+  {
+    vf::RealtimeChecker::check ("operator delete");
+
+    ::free (p);
+  }
+}
+
+void operator delete[] (void* p, std::nothrow_t const&) noexcept
+{
+  if (p != nullptr)
+  {
+    vf::RealtimeChecker::check ("operator delete[]");
+
+    ::free (p);
+  }
+}
+
+#undef VF_THROWS_BAD_ALLOC
@@ -0,0 +1,376 @@
+/*============================================================================*/
+/*
+  VFLib: https://github.com/vinniefalco/VFLib
+
+  Copyright (C) 2008 by Vinnie Falco <vinnie.falco@gmail.com>
+
+  This library contains portions of other open source products covered by
+  separate licenses. Please see the corresponding source files for specific
+  terms.
+  
+  VFLib is provided under the terms of The MIT License (MIT):
+
+  Permission is hereby granted, free of charge, to any person obtaining a copy
+  of this software and associated documentation files (the "Software"), to deal
+  in the Software without restriction, including without limitation the rights
+  to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+  copies of the Software, and to permit persons to whom the Software is
+  furnished to do so, subject to the following conditions:
+
+  The above copyright notice and this permission notice shall be included in
+  all copies or substantial portions of the Software.
+
+  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+  FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+  IN THE SOFTWARE.
+*/
+/*============================================================================*/
+
+struct Trace::Event
+{
+  enum Type
+  {
+    typeScope,
+    typeInstant,
+    typeFlowStart,
+    typeFlowEnd
+  };
+
+  char const* name;
+  int64 ticks;
+  int64 value; // duration for a scope, or the flow id
+  int type;
+};
+
+//------------------------------------------------------------------------------
+
+// A ring of events written by one thread.
+//
+// Only the owning thread writes, and it never waits for readers. The slot
+// at the write index may be half written, so a reader leaves it out, which
+// limits a copy to one event less than the size of the ring. A reader
+// copies the events and then discards any that were overwritten during
+// the copy, which can only happen when the buffer wraps while it is being
+// read.
+//
+class Trace::Buffer : Uncopyable
+{
+public:
+  Buffer (int size, int threadIndex, String const& threadName)
+    : m_size (size)
+    , m_threadIndex (threadIndex)
+    , m_threadName (threadName)
+  {
+    jassert (isPowerOfTwo (size));
+
+    m_events.malloc (size);
+  }
+
+  int getThreadIndex () const
+  {
+    return m_threadIndex;
+  }
+
+  String const& getThreadName () const
+  {
+    return m_threadName;
+  }
+
+  void add (int type, char const* name, int64 ticks, int64 value)
+  {
+    int64 const written = m_written.get ();
+
+    Event& event = m_events [int (written & (m_size - 1))];
+
+    event.name = name;
+    event.ticks = ticks;
+    event.value = value;
+    event.type = type;
+
+    m_written.set (written + 1);
+  }
+
+  void copyTo (std::vector <Event>& events) const
+  {
+    // The slot for event 'end' is the one for 'end - m_size'.
+    int64 const end = m_written.get ();
+    int64 const begin = jmax (m_cleared.get (), end - (m_size - 1));
+
+    std::size_t const first = events.size ();
+
+    for (int64 i = begin; i < end; ++i)
+      events.push_back (m_events [int (i & (m_size - 1))]);
+
+    // Events up to here were overwritten, or are being overwritten now.
+    int64 const overwritten = jmin (end, m_written.get () + 1 - m_size);
+
+    if (overwritten > begin)
+      events.erase (events.begin () + first, events.begin () + first + std::size_t (overwritten - begin));
+  }
+
+  void clear ()
+  {
+    m_cleared.set (m_written.get ());
+  }
+
+private:
+  int const m_size;
+  int const m_threadIndex;
+  String const m_threadName;
+  HeapBlock <Event> m_events;
+  Atomic <int64> m_written;
+  Atomic <int64> m_cleared;
+};
+
+//------------------------------------------------------------------------------
+
+class Trace::State : Uncopyable
+{
+public:
+  State ()
+  {
+    m_enabled.set (1);
+    m_bufferSize.set (defaultBufferSize);
+  }
+
+  Buffer* getBuffer ()
+  {
+    Buffer*& buffer = m_buffer.get ();
+
+    if (buffer == nullptr)
+      buffer = createBuffer ();
+
+    return buffer;
+  }
+
+  void getBuffers (Array <Buffer*>& buffers)
+  {
+    CriticalSection::ScopedLockType lock (m_mutex);
+
+    buffers.addArray (m_buffers);
+  }
+
+  char const* intern (String const& name)
+  {
+    CriticalSection::ScopedLockType lock (m_mutex);
+
+    for (int i = 0; i < m_names.size (); ++i)
+      if (*m_names [i] == name)
+        return m_names [i]->toRawUTF8 ();
+
+    return m_names.add (new String (name))->toRawUTF8 ();
+  }
+
+  Atomic <int> m_enabled;
+  Atomic <int> m_bufferSize;
+  Atomic <int64> m_nextFlowId;
+
+private:
+  Buffer* createBuffer ()
+  {
+    CriticalSection::ScopedLockType lock (m_mutex);
+
+    int const threadIndex = m_buffers.size () + 1;
+
+    Thread* const thread = Thread::getCurrentThread ();
+
+    String const threadName = (thread != nullptr) ?
+      thread->getThreadName () : (String ("Thread ") + String (threadIndex));
+
+    Buffer* const buffer = new Buffer (m_bufferSize.get (), threadIndex, threadName);
+
+    m_buffers.add (buffer);
+
+    return buffer;
+  }
+
+private:
+  ThreadLocalValue <Buffer*> m_buffer;
+  CriticalSection m_mutex;
+  Array <Buffer*> m_buffers;
+  OwnedArray <String> m_names;
+};
+
+//------------------------------------------------------------------------------
+
+// The state is never destroyed, so that threads can still record
+// events during the destruction of objects with static storage duration.
+// Each thread's buffer is kept until exit, since the trace is most useful
+// when it includes threads which have already finished.
+//
+Trace::State& Trace::getState ()
+{
+  static Static::Initializer s_initializer;
+  static Static::Storage <State, Trace> s_state;
+
+  if (s_initializer.begin ())
+  {
+    s_state.construct ();
+
+    s_initializer.end ();
+  }
+
+  return *s_state;
+}
+
+void Trace::setEnabled (bool shouldBeEnabled)
+{
+  getState ().m_enabled.set (shouldBeEnabled ? 1 : 0);
+}
+
+bool Trace::isEnabled ()
+{
+  return getState ().m_enabled.get () != 0;
+}
+
+void Trace::setBufferSize (int numberOfEvents)
+{
+  jassert (numberOfEvents > 0);
+
+  getState ().m_bufferSize.set (nextPowerOfTwo (numberOfEvents));
+}
+
+char const* Trace::intern (String const& name)
+{
+  return getState ().intern (name);
+}
+
+int64 Trace::createFlowId ()
+{
+  return ++getState ().m_nextFlowId;
+}
+
+void Trace::addScope (char const* name, int64 startTicks, int64 endTicks)
+{
+  add (Event::typeScope, name, startTicks, endTicks - startTicks);
+}
+
+void Trace::addInstant (char const* name)
+{
+  add (Event::typeInstant, name, CpuTicks::getTicks (), 0);
+}
+
+void Trace::addFlowStart (char const* name, int64 flowId)
+{
+  add (Event::typeFlowStart, name, CpuTicks::getTicks (), flowId);
+}
+
+void Trace::addFlowEnd (char const* name, int64 flowId)
+{
+  add (Event::typeFlowEnd, name, CpuTicks::getTicks (), flowId);
+}
+
+void Trace::add (int type, char const* name, int64 ticks, int64 value)
+{
+  State& state = getState ();
+
+  if (state.m_enabled.get () != 0)
+    state.getBuffer ()->add (type, name, ticks, value);
+}
+
+void Trace::clear ()
+{
+  Array <Buffer*> buffers;
+
+  getState ().getBuffers (buffers);
+
+  for (int i = 0; i < buffers.size (); ++i)
+    buffers [i]->clear ();
+}
+
+String Trace::toChromeJSON ()
+{
+  Array <Buffer*> buffers;
+
+  getState ().getBuffers (buffers);
+
+  // Copy the events first, so the earliest timestamp can be found.
+  //
+  OwnedArray <std::vector <Event> > events;
+
+  int64 startTicks = 0;
+  bool first = true;
+
+  for (int i = 0; i < buffers.size (); ++i)
+  {
+    std::vector <Event>& e = *events.add (new std::vector <Event>);
+
+    buffers [i]->copyTo (e);
+
+    for (std::size_t j = 0; j < e.size (); ++j)
+    {
+      if (first || e [j].ticks < startTicks)
+      {
+        startTicks = e [j].ticks;
+        first = false;
+      }
+    }
+  }
+
+  double const microsecondsPerTick = CpuTicks::ticksToNanoseconds (1) / 1000;
+
+  String s ("{\"traceEvents\":[\n");
+
+  for (int i = 0; i < buffers.size (); ++i)
+  {
+    String const tid (buffers [i]->getThreadIndex ());
+
+    s << "{\"ph\":\"M\",\"name\":\"thread_name\",\"pid\":1,\"tid\":" << tid
+      << ",\"args\":{\"name\":\""
+      << buffers [i]->getThreadName ().replace ("\\", "\\\\").replace ("\"", "\\\"")
+      << "\"}}";
+
+    std::vector <Event> const& e = *events [i];
+
+    for (std::size_t j = 0; j < e.size (); ++j)
+    {
+      Event const& event = e [j];
+
+      s << ",\n{\"name\":\""
+        << String (event.name).replace ("\\", "\\\\").replace ("\"", "\\\"")
+        << "\",\"pid\":1,\"tid\":" << tid
+        << ",\"ts\":" << String ((event.ticks - startTicks) * microsecondsPerTick, 3);
+
+      switch (event.type)
+      {
+      case Event::typeScope:
+        s << ",\"ph\":\"X\",\"dur\":" << String (event.value * microsecondsPerTick, 3);
+        break;
+
+      case Event::typeInstant:
+        s << ",\"ph\":\"i\",\"s\":\"t\"";
+        break;
+
+      case Event::typeFlowStart:
+        s << ",\"ph\":\"s\",\"cat\":\"flow\",\"id\":" << String (event.value);
+        break;
+
+      case Event::typeFlowEnd:
+        s << ",\"ph\":\"f\",\"bp\":\"e\",\"cat\":\"flow\",\"id\":" << String (event.value);
+        break;
+
+      default:
+        jassertfalse;
+        break;
+      }
+
+      s << "}";
+    }
+
+    if (i + 1 < buffers.size ())
+      s << ",\n";
+  }
+
+  s << "\n],\"displayTimeUnit\":\"ns\"}\n";
+
+  return s;
+}
+
+bool Trace::saveChromeJSON (File const& file)
+{
+  return file.replaceWithText (toChromeJSON ());
+}
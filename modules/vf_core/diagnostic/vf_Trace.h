@@ -0,0 +1,208 @@
+/*============================================================================*/
+/*
+  VFLib: https://github.com/vinniefalco/VFLib
+
+  Copyright (C) 2008 by Vinnie Falco <vinnie.falco@gmail.com>
+
+  This library contains portions of other open source products covered by
+  separate licenses. Please see the corresponding source files for specific
+  terms.
+  
+  VFLib is provided under the terms of The MIT License (MIT):
+
+  Permission is hereby granted, free of charge, to any person obtaining a copy
+  of this software and associated documentation files (the "Software"), to deal
+  in the Software without restriction, including without limitation the rights
+  to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+  copies of the Software, and to permit persons to whom the Software is
+  furnished to do so, subject to the following conditions:
+
+  The above copyright notice and this permission notice shall be included in
+  all copies or substantial portions of the Software.
+
+  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+  FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+  IN THE SOFTWARE.
+*/
+/*============================================================================*/
+
+#ifndef VF_TRACE_VFHEADER
+#define VF_TRACE_VFHEADER
+
+/*============================================================================*/
+/**
+  Records a timeline of events from every thread.
+
+  Each thread which records an event gets its own ring buffer, so recording
+  takes no locks and costs a timestamp and a few stores. When a buffer fills
+  up the oldest events are overwritten, which makes the trace a flight
+  recorder: after a late GUI frame or audio block, the last few seconds of
+  activity are still available. Save them as a Chrome trace and open them
+  in chrome://tracing or the Perfetto UI.
+
+  The events are:
+
+  - Scopes, which cover the lifetime of an object on the stack.
+
+  - Instants, which mark a single point in time.
+
+  - Flows, which connect a scope on one thread to a scope on another. A flow
+    starts inside the scope where work is posted, and ends inside the scope
+    where it executes, so the viewer draws an arrow between them.
+
+  Events are recorded with the VF_TRACE macros, which compile to nothing
+  unless VF_USE_TRACE is set to 1 in AppConfig.h:
+
+  @code
+
+  void AudioEngine::processBlock ()
+  {
+    VF_TRACE_SCOPE ("processBlock");
+
+    m_callQueue.synchronize ();
+
+    // ...
+  }
+
+  void MainWindow::saveTrace ()
+  {
+    Trace::saveChromeJSON (File ("~/trace.json"));
+  }
+
+  @endcode
+
+  CallQueue, ThreadGroup, ParallelFor and Listeners record their own scopes,
+  with a flow from each posted functor to its execution.
+
+  Event names are stored as pointers, so they must remain valid for the life
+  of the program. String literals are fine. Use intern() for anything else.
+
+  @ingroup vf_core
+*/
+class Trace
+{
+public:
+  enum
+  {
+    /** The default number of events held for each thread.
+    */
+    defaultBufferSize = 16384
+  };
+
+  /** Turn recording on or off.
+
+      Recording is on by default when VF_USE_TRACE is set.
+  */
+  static void setEnabled (bool shouldBeEnabled);
+
+  /** Determine if events are being recorded.
+  */
+  static bool isEnabled ();
+
+  /** Change the number of events held for each thread.
+
+      This only affects threads which have not yet recorded an event.
+      The size is rounded up to a power of two. An export holds at most one
+      event less than this, since the slot being written is left out.
+  */
+  static void setBufferSize (int numberOfEvents);
+
+  /** Get a permanent copy of a name.
+
+      The same pointer is returned for equal strings. This takes a lock,
+      so call it once and keep the result.
+  */
+  static char const* intern (String const& name);
+
+  /** Create a unique flow identifier.
+  */
+  static int64 createFlowId ();
+
+  /** Record a scope which has already finished.
+  */
+  static void addScope (char const* name, int64 startTicks, int64 endTicks);
+
+  /** Record an instant.
+  */
+  static void addInstant (char const* name);
+
+  /** Record the start of a flow.
+
+      This should be called inside a scope.
+  */
+  static void addFlowStart (char const* name, int64 flowId);
+
+  /** Record the end of a flow.
+
+      This should be called inside a scope.
+  */
+  static void addFlowEnd (char const* name, int64 flowId);
+
+  /** Discard the events recorded so far.
+  */
+  static void clear ();
+
+  /** Format the recorded events in the Chrome trace event format.
+  */
+  static String toChromeJSON ();
+
+  /** Write the recorded events to a file in the Chrome trace event format.
+
+      @return `true` if the file was written.
+  */
+  static bool saveChromeJSON (File const& file);
+
+  //============================================================================
+  /**
+    Records a scope, from construction to destruction.
+
+    Normally this is used through VF_TRACE_SCOPE.
+  */
+  class Scope : Uncopyable
+  {
+  public:
+    explicit Scope (char const* name)
+      : m_name (name)
+      , m_startTicks (CpuTicks::getTicks ())
+    {
+    }
+
+    ~Scope ()
+    {
+      addScope (m_name, m_startTicks, CpuTicks::getTicks ());
+    }
+
+  private:
+    char const* const m_name;
+    int64 const m_startTicks;
+  };
+
+private:
+  struct Event;
+  class Buffer;
+  class State;
+
+  static void add (int type, char const* name, int64 ticks, int64 value);
+  static State& getState ();
+};
+
+#define VF_TRACE_JOIN2_(a, b) a##b
+#define VF_TRACE_JOIN_(a, b) VF_TRACE_JOIN2_(a, b)
+
+#if VF_USE_TRACE
+# define VF_TRACE_SCOPE(name) vf::Trace::Scope VF_TRACE_JOIN_(vfTraceScope_, __LINE__) (name)
+# define VF_TRACE_INSTANT(name) vf::Trace::addInstant (name)
+# define VF_TRACE_FLOW_START(name, flowId) vf::Trace::addFlowStart (name, flowId)
+# define VF_TRACE_FLOW_END(name, flowId) vf::Trace::addFlowEnd (name, flowId)
+#else
+# define VF_TRACE_SCOPE(name)
+# define VF_TRACE_INSTANT(name)
+# define VF_TRACE_FLOW_START(name, flowId)
+# define VF_TRACE_FLOW_END(name, flowId)
+#endif
+
+#endif
@@ -33,8 +33,6 @@
 #ifndef VF_ONCEPERSECOND_VFHEADER
 #define VF_ONCEPERSECOND_VFHEADER
 
-#include "../containers/vf_List.h"
-
 /*============================================================================*/
 /** 
     Provides a once per second notification.
@@ -43,6 +41,10 @@
     call startOncePerSecond() to begin receiving the notifications. No clean-up
     or other actions are required.
 
+    Notifications are delivered by the TimerWheel thread.
+
+    @see TimerWheel
+
     @ingroup vf_core
 */
 class OncePerSecond : Uncopyable
@@ -62,16 +64,18 @@ protected:
   virtual void doOncePerSecond () = 0;
 
 private:
-  class TimerSingleton;
-  typedef ReferenceCountedObjectPtr <TimerSingleton> TimerPtr;
-
-  struct Elem : List <Elem>::Node
+  class TimerType : public TimerWheel::Timer
   {
-    TimerPtr instance;
-    OncePerSecond* object;
+  public:
+    explicit TimerType (OncePerSecond& owner) : m_owner (owner) { }
+
+  private:
+    void timerExpired ();
+
+    OncePerSecond& m_owner;
   };
 
-  Elem m_elem;
+  TimerType m_timer;
 };
 
 #endif
@@ -47,6 +47,10 @@ private:
       object = s_list->pop_front ();
     }
 
+    ContentionProfiler::reportAtExit ();
+
+    RealtimeChecker::reportAtExit ();
+
     LeakCheckedBase::detectAllLeaks ();
   }
 
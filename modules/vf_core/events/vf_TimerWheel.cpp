@@ -0,0 +1,321 @@
+/*============================================================================*/
+/*
+  VFLib: https://github.com/vinniefalco/VFLib
+
+  Copyright (C) 2008 by Vinnie Falco <vinnie.falco@gmail.com>
+
+  This library contains portions of other open source products covered by
+  separate licenses. Please see the corresponding source files for specific
+  terms.
+  
+  VFLib is provided under the terms of The MIT License (MIT):
+
+  Permission is hereby granted, free of charge, to any person obtaining a copy
+  of this software and associated documentation files (the "Software"), to deal
+  in the Software without restriction, including without limitation the rights
+  to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+  copies of the Software, and to permit persons to whom the Software is
+  furnished to do so, subject to the following conditions:
+
+  The above copyright notice and this permission notice shall be included in
+  all copies or substantial portions of the Software.
+
+  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+  FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+  IN THE SOFTWARE.
+*/
+/*============================================================================*/
+
+/*
+
+Implementation notes
+
+- The wheel has a root level of 256 one millisecond slots, followed by four
+  levels of 64 slots, each slot spanning the whole of the level below it.
+
+- A timer is placed in the root level if it expires within 256ms of the
+  current tick, otherwise in the level whose span covers its expiration.
+
+- Every time the root level wraps around, the next slot of the first level
+  is cascaded: its timers are re-inserted and fall into the root level.
+  When that level wraps around the next level is cascaded, and so on.
+
+- The thread sleeps until the first non empty root slot, or until the next
+  cascade if the root level is empty. With no timers, it sleeps until one
+  is started.
+
+*/
+
+TimerWheel::Timer::Timer ()
+  : m_wheel (TimerWheel::getInstance ())
+  , m_slot (nullptr)
+  , m_expiration (0)
+  , m_period (0)
+{
+}
+
+TimerWheel::Timer::~Timer ()
+{
+  stopTimer ();
+}
+
+void TimerWheel::Timer::startOneShotTimer (int milliseconds)
+{
+  m_wheel->start (this, jmax (milliseconds, 0), 0);
+}
+
+void TimerWheel::Timer::startPeriodicTimer (int milliseconds)
+{
+  jassert (milliseconds > 0);
+
+  m_wheel->start (this, jmax (milliseconds, 1), jmax (milliseconds, 1));
+}
+
+void TimerWheel::Timer::stopTimer ()
+{
+  m_wheel->stop (this);
+}
+
+bool TimerWheel::Timer::isTimerRunning () const
+{
+  CriticalSection::ScopedLockType lock (m_wheel->m_mutex);
+
+  return m_slot != nullptr;
+}
+
+//------------------------------------------------------------------------------
+
+TimerWheel::TimerWheel ()
+  : RefCountedSingleton <TimerWheel> (SingletonLifetime::persistAfterCreation)
+  , m_thread ("TimerWheel")
+  , m_now (getCurrentTime ())
+  , m_wakeup (std::numeric_limits <int64>::max ())
+  , m_numberOfTimers (0)
+  , m_shouldStop (false)
+{
+  m_thread.start (vf::bind (&TimerWheel::run, this));
+}
+
+TimerWheel::~TimerWheel ()
+{
+  {
+    CriticalSection::ScopedLockType lock (m_mutex);
+
+    m_shouldStop = true;
+  }
+
+  m_thread.interrupt ();
+
+  m_thread.join ();
+
+  // Someone forgot to stop a timer.
+  jassert (m_numberOfTimers == 0);
+}
+
+TimerWheel* TimerWheel::createInstance ()
+{
+  return new TimerWheel;
+}
+
+int64 TimerWheel::getCurrentTime ()
+{
+  return int64 (Time::getMillisecondCounterHiRes ());
+}
+
+void TimerWheel::start (Timer* timer, int milliseconds, int period)
+{
+  CriticalSection::ScopedLockType lock (m_mutex);
+
+  if (timer->m_slot != nullptr)
+    remove (timer);
+
+  int64 const now = getCurrentTime ();
+
+  // Nothing is pending, so the wheel can skip ahead
+  // instead of stepping through every idle tick.
+  if (m_numberOfTimers == 0)
+    m_now = now;
+
+  timer->m_expiration = now + milliseconds;
+  timer->m_period = period;
+
+  insert (timer);
+
+  // Wake the thread if it would sleep past this expiration.
+  if (timer->m_expiration < m_wakeup)
+  {
+    m_wakeup = timer->m_expiration;
+
+    m_thread.interrupt ();
+  }
+}
+
+void TimerWheel::stop (Timer* timer)
+{
+  CriticalSection::ScopedLockType lock (m_mutex);
+
+  if (timer->m_slot != nullptr)
+    remove (timer);
+}
+
+void TimerWheel::insert (Timer* timer)
+{
+  int64 const expiration = timer->m_expiration;
+  int64 const delta = expiration - m_now;
+
+  Slot* slot;
+
+  if (delta < 0)
+  {
+    // Already due, process it on the next tick.
+    slot = &m_root [m_now & rootMask];
+  }
+  else if (delta < rootSize)
+  {
+    slot = &m_root [expiration & rootMask];
+  }
+  else
+  {
+    int level = 0;
+    int shift = rootBits;
+
+    while (level < numberOfLevels - 1 && delta >= (int64 (1) << (shift + levelBits)))
+    {
+      ++level;
+      shift += levelBits;
+    }
+
+    slot = &m_levels [level][(expiration >> shift) & levelMask];
+  }
+
+  slot->push_back (*timer);
+  timer->m_slot = slot;
+
+  ++m_numberOfTimers;
+}
+
+void TimerWheel::remove (Timer* timer)
+{
+  timer->m_slot->erase (timer->m_slot->iterator_to (*timer));
+  timer->m_slot = nullptr;
+
+  --m_numberOfTimers;
+}
+
+void TimerWheel::cascade (int level)
+{
+  int const shift = rootBits + level * levelBits;
+
+  Slot& slot = m_levels [level][(m_now >> shift) & levelMask];
+
+  while (! slot.empty ())
+  {
+    Timer& timer = slot.front ();
+
+    remove (&timer);
+    insert (&timer);
+  }
+}
+
+void TimerWheel::advance (int64 now)
+{
+  if (m_numberOfTimers == 0)
+  {
+    m_now = now + 1;
+    return;
+  }
+
+  while (m_now <= now)
+  {
+    int const index = int (m_now & rootMask);
+
+    if (index == 0)
+    {
+      // Each level cascades when the level below it wraps around.
+      for (int level = 0; level < numberOfLevels; ++level)
+      {
+        cascade (level);
+
+        if (((m_now >> (rootBits + level * levelBits)) & levelMask) != 0)
+          break;
+      }
+    }
+
+    // Take the expired timers out first, since callbacks
+    // may start and stop timers, including these ones.
+    Slot expired;
+    expired.insert (expired.end (), m_root [index]);
+
+    for (Slot::iterator iter = expired.begin (); iter != expired.end (); ++iter)
+      iter->m_slot = &expired;
+
+    ++m_now;
+
+    while (! expired.empty ())
+    {
+      Timer& timer = expired.front ();
+
+      remove (&timer);
+
+      if (timer.m_period > 0)
+      {
+        // Keep the phase, but skip periods that were missed entirely.
+        timer.m_expiration += timer.m_period;
+
+        if (timer.m_expiration <= now)
+          timer.m_expiration += ((now - timer.m_expiration) / timer.m_period + 1) * timer.m_period;
+
+        insert (&timer);
+      }
+
+      timer.timerExpired ();
+    }
+  }
+}
+
+int64 TimerWheel::getNextWakeup () const
+{
+  if (m_numberOfTimers == 0)
+    return std::numeric_limits <int64>::max ();
+
+  // The next cascade happens when the root level wraps around.
+  int64 const boundary = (m_now | rootMask) + 1;
+
+  for (int64 tick = m_now; tick < boundary; ++tick)
+  {
+    if (! m_root [tick & rootMask].empty ())
+      return tick;
+  }
+
+  return boundary;
+}
+
+void TimerWheel::run ()
+{
+  for (;;)
+  {
+    int timeout;
+
+    {
+      CriticalSection::ScopedLockType lock (m_mutex);
+
+      if (m_shouldStop)
+        break;
+
+      advance (getCurrentTime ());
+
+      m_wakeup = getNextWakeup ();
+
+      if (m_wakeup == std::numeric_limits <int64>::max ())
+        timeout = -1;
+      else
+        timeout = int (jmax (m_wakeup - getCurrentTime (), int64 (0)));
+    }
+
+    m_thread.wait (timeout);
+  }
+}
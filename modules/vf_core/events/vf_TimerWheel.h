@@ -0,0 +1,184 @@
+/*============================================================================*/
+/*
+  VFLib: https://github.com/vinniefalco/VFLib
+
+  Copyright (C) 2008 by Vinnie Falco <vinnie.falco@gmail.com>
+
+  This library contains portions of other open source products covered by
+  separate licenses. Please see the corresponding source files for specific
+  terms.
+  
+  VFLib is provided under the terms of The MIT License (MIT):
+
+  Permission is hereby granted, free of charge, to any person obtaining a copy
+  of this software and associated documentation files (the "Software"), to deal
+  in the Software without restriction, including without limitation the rights
+  to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+  copies of the Software, and to permit persons to whom the Software is
+  furnished to do so, subject to the following conditions:
+
+  The above copyright notice and this permission notice shall be included in
+  all copies or substantial portions of the Software.
+
+  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+  FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+  IN THE SOFTWARE.
+*/
+/*============================================================================*/
+
+#ifndef VF_TIMERWHEEL_VFHEADER
+#define VF_TIMERWHEEL_VFHEADER
+
+#include "../containers/vf_List.h"
+
+/*============================================================================*/
+/**
+  A hierarchical timer wheel with millisecond resolution.
+
+  The wheel is a process wide service with a single thread. Timers are kept
+  in intrusive lists bucketed by expiration time, so starting and stopping a
+  timer takes constant time regardless of how many timers exist. The thread
+  sleeps until the next expiration instead of polling at a fixed rate.
+
+  Derive from TimerWheel::Timer and override timerExpired():
+
+  @code
+
+  class Poller : private TimerWheel::Timer
+  {
+  public:
+    Poller ()
+    {
+      startPeriodicTimer (250);
+    }
+
+    ~Poller ()
+    {
+      stopTimer ();
+    }
+
+  private:
+    void timerExpired ()
+    {
+      // Called every 250ms on the timer thread
+    }
+  };
+
+  @endcode
+
+  Expirations are delivered on the timer thread, with the wheel locked. This
+  means that once stopTimer() returns, the timer is not running and will
+  not run again until it is restarted. The callback should be short; use
+  CallQueueTimer to deliver expirations onto a CallQueue instead.
+
+  @see OncePerSecond, CallQueueTimer
+
+  @ingroup vf_core
+*/
+class TimerWheel : public RefCountedSingleton <TimerWheel>
+{
+public:
+  //============================================================================
+  /**
+    A timer in the TimerWheel.
+
+    @note Derived classes must call stopTimer() in their destructor if the
+          timer might still be running, otherwise timerExpired() could be
+          called on a partially destroyed object.
+  */
+  class Timer : public List <Timer>::Node
+  {
+  public:
+    Timer ();
+
+    virtual ~Timer ();
+
+    /** Start or restart the timer so that it expires once.
+
+        @param milliseconds The time from now until the timer expires.
+    */
+    void startOneShotTimer (int milliseconds);
+
+    /** Start or restart the timer so that it expires repeatedly.
+
+        Expirations are scheduled relative to the previous expiration, so
+        the period does not drift when callbacks are delayed.
+
+        @param milliseconds The time between expirations. This must be
+                            greater than zero.
+    */
+    void startPeriodicTimer (int milliseconds);
+
+    /** Stop the timer.
+
+        It is safe to call this on a timer which is not running, and from
+        inside timerExpired().
+    */
+    void stopTimer ();
+
+    /** Determine if the timer is running.
+    */
+    bool isTimerRunning () const;
+
+  protected:
+    /** Called on the timer thread when the timer expires.
+    */
+    virtual void timerExpired () = 0;
+
+  private:
+    friend class TimerWheel;
+
+    Ptr m_wheel;
+    List <Timer>* m_slot;
+    int64 m_expiration;
+    int m_period;
+  };
+
+  //============================================================================
+
+  static TimerWheel* createInstance ();
+
+private:
+  enum
+  {
+    rootBits   = 8,
+    levelBits  = 6,
+    rootSize   = 1 << rootBits,
+    levelSize  = 1 << levelBits,
+    rootMask   = rootSize - 1,
+    levelMask  = levelSize - 1,
+    numberOfLevels = 4
+  };
+
+  typedef List <Timer> Slot;
+
+  TimerWheel ();
+  ~TimerWheel ();
+
+  static int64 getCurrentTime ();
+
+  void start (Timer* timer, int milliseconds, int period);
+  void stop (Timer* timer);
+  void insert (Timer* timer);
+  void remove (Timer* timer);
+  void cascade (int level);
+  void advance (int64 now);
+  int64 getNextWakeup () const;
+  void run ();
+
+private:
+  InterruptibleThread m_thread;
+  CriticalSection m_mutex;
+  Slot m_root [rootSize];
+  Slot m_levels [numberOfLevels][levelSize];
+  int64 m_now;           // next tick to process
+  int64 m_wakeup;        // when the thread will next wake up
+  int m_numberOfTimers;
+  bool m_shouldStop;
+};
+
+#endif
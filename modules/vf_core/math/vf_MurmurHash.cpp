@@ -356,4 +356,215 @@ void MurmurHash3_x64_128 ( const void * key, const int len,
   ((uint64_t*)out)[1] = h2;
 }
 
+
+//-----------------------------------------------------------------------------
+// Incremental versions. The block and tail processing are the same as above,
+// with the partial block carried over between calls to update().
+
+static FORCE_INLINE uint32_t mixBlock32 ( uint32_t h1, uint32_t k1 )
+{
+  k1 *= 0xcc9e2d51;
+  k1 = ROTL32(k1,15);
+  k1 *= 0x1b873593;
+
+  h1 ^= k1;
+  h1 = ROTL32(h1,13);
+  h1 = h1*5+0xe6546b64;
+
+  return h1;
+}
+
+static FORCE_INLINE uint32_t readBlock32 ( const uint8_t * p )
+{
+  uint32 k;
+  memcpy (&k, p, sizeof (k));
+  return ByteOrder::swapIfBigEndian (k);
+}
+
+Stream32::Stream32 (uint32 seed)
+{
+  reset (seed);
+}
+
+void Stream32::reset (uint32 seed)
+{
+  m_h1 = seed;
+  m_tailBytes = 0;
+  m_totalBytes = 0;
+}
+
+void Stream32::update (const void* data, size_t bytes)
+{
+  const uint8_t * p = (const uint8_t*)data;
+
+  m_totalBytes += bytes;
+
+  if (m_tailBytes > 0)
+  {
+    while (m_tailBytes < 4 && bytes > 0)
+    {
+      m_tail [m_tailBytes++] = *p++;
+      --bytes;
+    }
+
+    if (m_tailBytes < 4)
+      return;
+
+    m_h1 = mixBlock32 (m_h1, readBlock32 (m_tail));
+    m_tailBytes = 0;
+  }
+
+  uint32_t h1 = m_h1;
+
+  for (; bytes >= 4; bytes -= 4, p += 4)
+    h1 = mixBlock32 (h1, readBlock32 (p));
+
+  m_h1 = h1;
+
+  while (bytes-- > 0)
+    m_tail [m_tailBytes++] = *p++;
+}
+
+uint32 Stream32::getHash () const
+{
+  uint32_t h1 = m_h1;
+  uint32_t k1 = 0;
+
+  switch (m_tailBytes)
+  {
+  case 3: k1 ^= m_tail[2] << 16;
+  case 2: k1 ^= m_tail[1] << 8;
+  case 1: k1 ^= m_tail[0];
+          k1 *= 0xcc9e2d51; k1 = ROTL32(k1,15); k1 *= 0x1b873593; h1 ^= k1;
+  };
+
+  h1 ^= uint32_t (m_totalBytes);
+
+  return fmix (h1);
+}
+
+//-----------------------------------------------------------------------------
+
+static FORCE_INLINE uint64_t readBlock64 ( const uint8_t * p )
+{
+  uint64 k;
+  memcpy (&k, p, sizeof (k));
+  return ByteOrder::swapIfBigEndian (k);
+}
+
+Stream128::Stream128 (uint32 seed)
+{
+  reset (seed);
+}
+
+void Stream128::reset (uint32 seed)
+{
+  m_h1 = seed;
+  m_h2 = seed;
+  m_tailBytes = 0;
+  m_totalBytes = 0;
+}
+
+void Stream128::update (const void* data, size_t bytes)
+{
+  const uint64_t c1 = BIG_CONSTANT(0x87c37b91114253d5);
+  const uint64_t c2 = BIG_CONSTANT(0x4cf5ad432745937f);
+
+  const uint8_t * p = (const uint8_t*)data;
+
+  m_totalBytes += bytes;
+
+  uint64_t h1 = m_h1;
+  uint64_t h2 = m_h2;
+
+  for (;;)
+  {
+    const uint8_t * block;
+
+    if (m_tailBytes > 0 || bytes < 16)
+    {
+      while (m_tailBytes < 16 && bytes > 0)
+      {
+        m_tail [m_tailBytes++] = *p++;
+        --bytes;
+      }
+
+      if (m_tailBytes < 16)
+        break;
+
+      block = m_tail;
+      m_tailBytes = 0;
+    }
+    else
+    {
+      block = p;
+      p += 16;
+      bytes -= 16;
+    }
+
+    uint64_t k1 = readBlock64 (block);
+    uint64_t k2 = readBlock64 (block + 8);
+
+    k1 *= c1; k1  = ROTL64(k1,31); k1 *= c2; h1 ^= k1;
+
+    h1 = ROTL64(h1,27); h1 += h2; h1 = h1*5+0x52dce729;
+
+    k2 *= c2; k2  = ROTL64(k2,33); k2 *= c1; h2 ^= k2;
+
+    h2 = ROTL64(h2,31); h2 += h1; h2 = h2*5+0x38495ab5;
+  }
+
+  m_h1 = h1;
+  m_h2 = h2;
+}
+
+void Stream128::getHash (void* out) const
+{
+  const uint64_t c1 = BIG_CONSTANT(0x87c37b91114253d5);
+  const uint64_t c2 = BIG_CONSTANT(0x4cf5ad432745937f);
+
+  const uint8_t * tail = m_tail;
+
+  uint64_t h1 = m_h1;
+  uint64_t h2 = m_h2;
+  uint64_t k1 = 0;
+  uint64_t k2 = 0;
+
+  switch (m_tailBytes)
+  {
+  case 15: k2 ^= uint64_t(tail[14]) << 48;
+  case 14: k2 ^= uint64_t(tail[13]) << 40;
+  case 13: k2 ^= uint64_t(tail[12]) << 32;
+  case 12: k2 ^= uint64_t(tail[11]) << 24;
+  case 11: k2 ^= uint64_t(tail[10]) << 16;
+  case 10: k2 ^= uint64_t(tail[ 9]) << 8;
+  case  9: k2 ^= uint64_t(tail[ 8]) << 0;
+           k2 *= c2; k2  = ROTL64(k2,33); k2 *= c1; h2 ^= k2;
+
+  case  8: k1 ^= uint64_t(tail[ 7]) << 56;
+  case  7: k1 ^= uint64_t(tail[ 6]) << 48;
+  case  6: k1 ^= uint64_t(tail[ 5]) << 40;
+  case  5: k1 ^= uint64_t(tail[ 4]) << 32;
+  case  4: k1 ^= uint64_t(tail[ 3]) << 24;
+  case  3: k1 ^= uint64_t(tail[ 2]) << 16;
+  case  2: k1 ^= uint64_t(tail[ 1]) << 8;
+  case  1: k1 ^= uint64_t(tail[ 0]) << 0;
+           k1 *= c1; k1  = ROTL64(k1,31); k1 *= c2; h1 ^= k1;
+  };
+
+  h1 ^= m_totalBytes; h2 ^= m_totalBytes;
+
+  h1 += h2;
+  h2 += h1;
+
+  h1 = fmix(h1);
+  h2 = fmix(h2);
+
+  h1 += h2;
+  h2 += h1;
+
+  ((uint64_t*)out)[0] = h1;
+  ((uint64_t*)out)[1] = h2;
+}
+
 }
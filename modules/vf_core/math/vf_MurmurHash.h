@@ -43,28 +43,108 @@ extern void MurmurHash3_x86_32  (const void *key, int len, uint32 seed, void* ou
 extern void MurmurHash3_x86_128 (const void *key, int len, uint32 seed, void* out);
 extern void MurmurHash3_x64_128 (const void *key, int len, uint32 seed, void* out);
 
-// Uses Juce to choose an appropriate routine
+// Selects the routine for a hash size at compile time. Only 32 and 128 bit
+// hashes are provided, other sizes fail to compile.
+template <int Bytes>
+struct HashOfSize;
 
-// This handy template deduces which size hash is desired
-template <typename HashType>
-inline void Hash (const void* key, int len, uint32 seed, HashType* out)
+template <>
+struct HashOfSize <4>
 {
-  switch (8*sizeof(HashType))
+  static inline void hash (const void* key, int len, uint32 seed, void* out)
   {
-  case 32:  MurmurHash3_x86_32 (key, len, seed, out); break;
+    MurmurHash3_x86_32 (key, len, seed, out);
+  }
+};
 
+template <>
+struct HashOfSize <16>
+{
+  static inline void hash (const void* key, int len, uint32 seed, void* out)
+  {
 #if JUCE_64BIT
-  case 128: MurmurHash3_x64_128 (key, len, seed, out); break;
+    MurmurHash3_x64_128 (key, len, seed, out);
 #else
-  case 128: MurmurHash3_x86_128 (key, len, seed, out); break;
+    MurmurHash3_x86_128 (key, len, seed, out);
 #endif
+  }
+};
 
-  default:
-    Throw (std::runtime_error ("invalid key size in MurmurHash"));
-    break;
-  };
+// This handy template deduces which size hash is desired
+template <typename HashType>
+inline void Hash (const void* key, int len, uint32 seed, HashType* out)
+{
+  HashOfSize <sizeof (HashType)>::hash (key, len, seed, out);
 }
 
+//------------------------------------------------------------------------------
+
+/** Incremental MurmurHash3_x86_32.
+
+    The data may be supplied in pieces of any size, and the result is the
+    same as MurmurHash3_x86_32 over all of it at once. This is useful for
+    hashing files and streams without holding them in memory.
+
+    @ingroup vf_core
+*/
+class Stream32
+{
+public:
+  explicit Stream32 (uint32 seed = 0);
+
+  /** Start a new hash. */
+  void reset (uint32 seed = 0);
+
+  /** Add data to the hash. */
+  void update (const void* data, size_t bytes);
+
+  /** Retrieve the hash of everything added so far.
+
+      More data may still be added afterwards.
+  */
+  uint32 getHash () const;
+
+private:
+  uint32 m_h1;
+  uint8 m_tail [4];
+  int m_tailBytes;
+  uint64 m_totalBytes;
+};
+
+//------------------------------------------------------------------------------
+
+/** Incremental MurmurHash3_x64_128.
+
+    Unlike Hash(), this always produces the x64 variant, so that results
+    may be stored and compared across platforms.
+
+    @ingroup vf_core
+*/
+class Stream128
+{
+public:
+  explicit Stream128 (uint32 seed = 0);
+
+  /** Start a new hash. */
+  void reset (uint32 seed = 0);
+
+  /** Add data to the hash. */
+  void update (const void* data, size_t bytes);
+
+  /** Retrieve the 16 byte hash of everything added so far.
+
+      More data may still be added afterwards.
+  */
+  void getHash (void* out) const;
+
+private:
+  uint64 m_h1;
+  uint64 m_h2;
+  uint8 m_tail [16];
+  int m_tailBytes;
+  uint64 m_totalBytes;
+};
+
 }
 
 #endif
@@ -0,0 +1,767 @@
+/*============================================================================*/
+/*
+  VFLib: https://github.com/vinniefalco/VFLib
+
+  Copyright (C) 2008 by Vinnie Falco <vinnie.falco@gmail.com>
+
+  This library contains portions of other open source products covered by
+  separate licenses. Please see the corresponding source files for specific
+  terms.
+  
+  VFLib is provided under the terms of The MIT License (MIT):
+
+  Permission is hereby granted, free of charge, to any person obtaining a copy
+  of this software and associated documentation files (the "Software"), to deal
+  in the Software without restriction, including without limitation the rights
+  to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+  copies of the Software, and to permit persons to whom the Software is
+  furnished to do so, subject to the following conditions:
+
+  The above copyright notice and this permission notice shall be included in
+  all copies or substantial portions of the Software.
+
+  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+  FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+  IN THE SOFTWARE.
+*/
+/*============================================================================*/
+
+// Based on the reference implementation at https://github.com/Cyan4973/xxHash
+
+#if VF_COMPILER_SUPPORTS_AVX2 && JUCE_GCC
+#define VF_XXHASH3_AVX2 __attribute__ ((target ("avx2")))
+#else
+#define VF_XXHASH3_AVX2
+#endif
+
+struct XXHash3::Kernels
+{
+  typedef void (*Accumulate) (uint64* acc, uint8 const* input, uint8 const* secret, size_t stripes);
+  typedef void (*Scramble) (uint64* acc, uint8 const* secret);
+
+  Accumulate accumulate;
+  Scramble scramble;
+
+  enum
+  {
+    secretConsumeRate = 8,
+    stripesPerBlock = (secretBytes - stripeBytes) / secretConsumeRate,
+    blockBytes = stripesPerBlock * stripeBytes,
+    secretLastAccStart = 7,
+    secretMergeAccsStart = 11,
+    midSizeMax = 240,
+    midSizeStartOffset = 3,
+    midSizeLastOffset = 17,
+    secretSizeMin = 136
+  };
+
+  static uint32 const prime32_1;
+  static uint32 const prime32_2;
+  static uint32 const prime32_3;
+  static uint64 const prime64_1;
+  static uint64 const prime64_2;
+  static uint64 const prime64_3;
+  static uint64 const prime64_4;
+  static uint64 const prime64_5;
+  static uint64 const primeMx1;
+  static uint64 const primeMx2;
+
+  static uint8 const defaultSecret [secretBytes];
+
+  //----------------------------------------------------------------------------
+
+  static inline uint32 readLE32 (uint8 const* p)
+  {
+    uint32 v;
+    memcpy (&v, p, sizeof (v));
+    return ByteOrder::swapIfBigEndian (v);
+  }
+
+  static inline uint64 readLE64 (uint8 const* p)
+  {
+    uint64 v;
+    memcpy (&v, p, sizeof (v));
+    return ByteOrder::swapIfBigEndian (v);
+  }
+
+  static inline void writeLE64 (uint8* p, uint64 v)
+  {
+    v = ByteOrder::swapIfBigEndian (v);
+    memcpy (p, &v, sizeof (v));
+  }
+
+  static inline uint64 rotl64 (uint64 v, int bits)
+  {
+    return (v << bits) | (v >> (64 - bits));
+  }
+
+  // Multiplies to 128 bits and folds the halves together.
+  static inline uint64 mul128Fold64 (uint64 lhs, uint64 rhs)
+  {
+#if JUCE_GCC && JUCE_64BIT
+    __uint128_t const product = __uint128_t (lhs) * rhs;
+    return uint64 (product) ^ uint64 (product >> 64);
+
+#elif JUCE_MSVC && JUCE_64BIT
+    uint64 high;
+    uint64 const low = _umul128 (lhs, rhs, &high);
+    return low ^ high;
+
+#else
+    uint64 const loLo = (lhs & 0xFFFFFFFF) * (rhs & 0xFFFFFFFF);
+    uint64 const hiLo = (lhs >> 32) * (rhs & 0xFFFFFFFF);
+    uint64 const loHi = (lhs & 0xFFFFFFFF) * (rhs >> 32);
+    uint64 const hiHi = (lhs >> 32) * (rhs >> 32);
+    uint64 const cross = (loLo >> 32) + (hiLo & 0xFFFFFFFF) + loHi;
+    uint64 const upper = (hiLo >> 32) + (cross >> 32) + hiHi;
+    uint64 const lower = (cross << 32) | (loLo & 0xFFFFFFFF);
+    return lower ^ upper;
+
+#endif
+  }
+
+  static inline uint64 xxh64Avalanche (uint64 h)
+  {
+    h ^= h >> 33;
+    h *= prime64_2;
+    h ^= h >> 29;
+    h *= prime64_3;
+    h ^= h >> 32;
+    return h;
+  }
+
+  static inline uint64 avalanche (uint64 h)
+  {
+    h ^= h >> 37;
+    h *= primeMx1;
+    h ^= h >> 32;
+    return h;
+  }
+
+  static inline uint64 rrmxmx (uint64 h, uint64 len)
+  {
+    h ^= rotl64 (h, 49) ^ rotl64 (h, 24);
+    h *= primeMx2;
+    h ^= (h >> 35) + len;
+    h *= primeMx2;
+    return h ^ (h >> 28);
+  }
+
+  static inline uint64 mix16 (uint8 const* input, uint8 const* secret, uint64 seed)
+  {
+    return mul128Fold64 (readLE64 (input) ^ (readLE64 (secret) + seed),
+                         readLE64 (input + 8) ^ (readLE64 (secret + 8) - seed));
+  }
+
+  //----------------------------------------------------------------------------
+
+  // Inputs of up to midSizeMax bytes are hashed directly from the default
+  // secret and the seed, without the accumulators.
+  static uint64 hashShort (uint8 const* input, size_t len, uint64 seed)
+  {
+    uint8 const* const secret = defaultSecret;
+
+    if (len <= 16)
+    {
+      if (len > 8)
+      {
+        uint64 const bitflip1 = (readLE64 (secret + 24) ^ readLE64 (secret + 32)) + seed;
+        uint64 const bitflip2 = (readLE64 (secret + 40) ^ readLE64 (secret + 48)) - seed;
+        uint64 const inputLo = readLE64 (input) ^ bitflip1;
+        uint64 const inputHi = readLE64 (input + len - 8) ^ bitflip2;
+        uint64 const acc = len + ByteOrder::swap (inputLo) + inputHi + mul128Fold64 (inputLo, inputHi);
+
+        return avalanche (acc);
+      }
+      else if (len >= 4)
+      {
+        seed ^= uint64 (ByteOrder::swap (uint32 (seed))) << 32;
+
+        uint32 const input1 = readLE32 (input);
+        uint32 const input2 = readLE32 (input + len - 4);
+        uint64 const bitflip = (readLE64 (secret + 8) ^ readLE64 (secret + 16)) - seed;
+        uint64 const input64 = input2 + (uint64 (input1) << 32);
+
+        return rrmxmx (input64 ^ bitflip, len);
+      }
+      else if (len > 0)
+      {
+        uint32 const combined = (uint32 (input [0]) << 16)
+                              | (uint32 (input [len >> 1]) << 24)
+                              | (uint32 (input [len - 1]))
+                              | (uint32 (len) << 8);
+        uint64 const bitflip = (readLE32 (secret) ^ readLE32 (secret + 4)) + seed;
+
+        return xxh64Avalanche (uint64 (combined) ^ bitflip);
+      }
+      else
+      {
+        return xxh64Avalanche (seed ^ (readLE64 (secret + 56) ^ readLE64 (secret + 64)));
+      }
+    }
+    else if (len <= 128)
+    {
+      uint64 acc = len * prime64_1;
+
+      if (len > 32)
+      {
+        if (len > 64)
+        {
+          if (len > 96)
+          {
+            acc += mix16 (input + 48, secret + 96, seed);
+            acc += mix16 (input + len - 64, secret + 112, seed);
+          }
+
+          acc += mix16 (input + 32, secret + 64, seed);
+          acc += mix16 (input + len - 48, secret + 80, seed);
+        }
+
+        acc += mix16 (input + 16, secret + 32, seed);
+        acc += mix16 (input + len - 32, secret + 48, seed);
+      }
+
+      acc += mix16 (input, secret, seed);
+      acc += mix16 (input + len - 16, secret + 16, seed);
+
+      return avalanche (acc);
+    }
+    else
+    {
+      jassert (len <= midSizeMax);
+
+      int const rounds = int (len / 16);
+
+      uint64 acc = len * prime64_1;
+
+      for (int i = 0; i < 8; ++i)
+        acc += mix16 (input + 16 * i, secret + 16 * i, seed);
+
+      acc = avalanche (acc);
+
+      uint64 accEnd = mix16 (input + len - 16, secret + secretSizeMin - midSizeLastOffset, seed);
+
+      for (int i = 8; i < rounds; ++i)
+        accEnd += mix16 (input + 16 * i, secret + 16 * (i - 8) + midSizeStartOffset, seed);
+
+      return avalanche (acc + accEnd);
+    }
+  }
+
+  //----------------------------------------------------------------------------
+
+  static void initAccumulators (uint64* acc)
+  {
+    acc [0] = prime32_3;
+    acc [1] = prime64_1;
+    acc [2] = prime64_2;
+    acc [3] = prime64_3;
+    acc [4] = prime64_4;
+    acc [5] = prime32_2;
+    acc [6] = prime64_5;
+    acc [7] = prime32_1;
+  }
+
+  // Derives the secret used for long inputs from the seed.
+  static void initSecret (uint8* secret, uint64 seed)
+  {
+    for (int i = 0; i < secretBytes / 16; ++i)
+    {
+      writeLE64 (secret + 16 * i, readLE64 (defaultSecret + 16 * i) + seed);
+      writeLE64 (secret + 16 * i + 8, readLE64 (defaultSecret + 16 * i + 8) - seed);
+    }
+  }
+
+  static uint64 mergeAccumulators (uint64 const* acc, uint8 const* secret, uint64 start)
+  {
+    uint64 result = start;
+
+    for (int i = 0; i < 4; ++i)
+      result += mul128Fold64 (acc [2 * i] ^ readLE64 (secret + 16 * i),
+                              acc [2 * i + 1] ^ readLE64 (secret + 16 * i + 8));
+
+    return avalanche (result);
+  }
+
+  uint64 hashLong (uint8 const* input, size_t len, uint8 const* secret) const
+  {
+    uint64 acc [8];
+
+    initAccumulators (acc);
+
+    size_t const blocks = (len - 1) / blockBytes;
+
+    for (size_t n = 0; n < blocks; ++n)
+    {
+      accumulate (acc, input + n * blockBytes, secret, stripesPerBlock);
+      scramble (acc, secret + secretBytes - stripeBytes);
+    }
+
+    size_t const stripes = ((len - 1) - blockBytes * blocks) / stripeBytes;
+
+    accumulate (acc, input + blocks * blockBytes, secret, stripes);
+    accumulate (acc, input + len - stripeBytes, secret + secretBytes - stripeBytes - secretLastAccStart, 1);
+
+    return mergeAccumulators (acc, secret + secretMergeAccsStart, len * prime64_1);
+  }
+
+  // Accumulates whole stripes, scrambling at each block boundary. This is
+  // the streaming equivalent of the loop in hashLong().
+  uint8 const* consumeStripes (uint64* acc,
+                               size_t& stripesSoFar,
+                               uint8 const* input,
+                               size_t stripes,
+                               uint8 const* secret) const
+  {
+    uint8 const* stripeSecret = secret + stripesSoFar * secretConsumeRate;
+
+    if (stripes >= stripesPerBlock - stripesSoFar)
+    {
+      size_t stripesThisBlock = stripesPerBlock - stripesSoFar;
+
+      do
+      {
+        accumulate (acc, input, stripeSecret, stripesThisBlock);
+        scramble (acc, secret + secretBytes - stripeBytes);
+
+        input += stripesThisBlock * stripeBytes;
+        stripes -= stripesThisBlock;
+        stripesThisBlock = stripesPerBlock;
+        stripeSecret = secret;
+        stripesSoFar = 0;
+      }
+      while (stripes >= stripesPerBlock);
+    }
+
+    if (stripes > 0)
+    {
+      accumulate (acc, input, stripeSecret, stripes);
+      input += stripes * stripeBytes;
+      stripesSoFar += stripes;
+    }
+
+    return input;
+  }
+
+  //----------------------------------------------------------------------------
+
+  static void accumulateScalar (uint64* acc, uint8 const* input, uint8 const* secret, size_t stripes)
+  {
+    for (size_t n = 0; n < stripes; ++n)
+    {
+      uint8 const* const in = input + n * stripeBytes;
+      uint8 const* const key = secret + n * secretConsumeRate;
+
+      for (int lane = 0; lane < 8; ++lane)
+      {
+        uint64 const data = readLE64 (in + 8 * lane);
+        uint64 const dataKey = data ^ readLE64 (key + 8 * lane);
+
+        acc [lane ^ 1] += data;
+        acc [lane] += (dataKey & 0xFFFFFFFF) * (dataKey >> 32);
+      }
+    }
+  }
+
+  static void scrambleScalar (uint64* acc, uint8 const* secret)
+  {
+    for (int lane = 0; lane < 8; ++lane)
+    {
+      uint64 v = acc [lane];
+      v ^= v >> 47;
+      v ^= readLE64 (secret + 8 * lane);
+      v *= prime32_1;
+      acc [lane] = v;
+    }
+  }
+
+  //----------------------------------------------------------------------------
+
+#if VF_COMPILER_SUPPORTS_SSE2
+  static inline __m128i roundSSE2 (__m128i acc, uint8 const* input, uint8 const* secret)
+  {
+    __m128i const data = _mm_loadu_si128 (reinterpret_cast <__m128i const*> (input));
+    __m128i const key = _mm_loadu_si128 (reinterpret_cast <__m128i const*> (secret));
+    __m128i const dataKey = _mm_xor_si128 (data, key);
+    __m128i const dataKeyHi = _mm_shuffle_epi32 (dataKey, _MM_SHUFFLE (0, 3, 0, 1));
+    __m128i const product = _mm_mul_epu32 (dataKey, dataKeyHi);
+    __m128i const swapped = _mm_shuffle_epi32 (data, _MM_SHUFFLE (1, 0, 3, 2));
+
+    return _mm_add_epi64 (product, _mm_add_epi64 (acc, swapped));
+  }
+
+  static void accumulateSSE2 (uint64* acc, uint8 const* input, uint8 const* secret, size_t stripes)
+  {
+    __m128i* const v = reinterpret_cast <__m128i*> (acc);
+
+    __m128i a0 = _mm_loadu_si128 (v);
+    __m128i a1 = _mm_loadu_si128 (v + 1);
+    __m128i a2 = _mm_loadu_si128 (v + 2);
+    __m128i a3 = _mm_loadu_si128 (v + 3);
+
+    for (size_t n = 0; n < stripes; ++n)
+    {
+      uint8 const* const in = input + n * stripeBytes;
+      uint8 const* const key = secret + n * secretConsumeRate;
+
+      a0 = roundSSE2 (a0, in, key);
+      a1 = roundSSE2 (a1, in + 16, key + 16);
+      a2 = roundSSE2 (a2, in + 32, key + 32);
+      a3 = roundSSE2 (a3, in + 48, key + 48);
+    }
+
+    _mm_storeu_si128 (v, a0);
+    _mm_storeu_si128 (v + 1, a1);
+    _mm_storeu_si128 (v + 2, a2);
+    _mm_storeu_si128 (v + 3, a3);
+  }
+
+  static void scrambleSSE2 (uint64* acc, uint8 const* secret)
+  {
+    __m128i const prime = _mm_set1_epi32 (int (prime32_1));
+    __m128i* const v = reinterpret_cast <__m128i*> (acc);
+
+    for (int i = 0; i < 4; ++i)
+    {
+      __m128i a = _mm_loadu_si128 (v + i);
+      a = _mm_xor_si128 (a, _mm_srli_epi64 (a, 47));
+      a = _mm_xor_si128 (a, _mm_loadu_si128 (reinterpret_cast <__m128i const*> (secret) + i));
+
+      __m128i const hi = _mm_shuffle_epi32 (a, _MM_SHUFFLE (0, 3, 0, 1));
+      __m128i const productLo = _mm_mul_epu32 (a, prime);
+      __m128i const productHi = _mm_mul_epu32 (hi, prime);
+
+      _mm_storeu_si128 (v + i, _mm_add_epi64 (productLo, _mm_slli_epi64 (productHi, 32)));
+    }
+  }
+#endif
+
+  //----------------------------------------------------------------------------
+
+#if VF_COMPILER_SUPPORTS_AVX2
+  static inline VF_XXHASH3_AVX2 __m256i roundAVX2 (__m256i acc, uint8 const* input, uint8 const* secret)
+  {
+    __m256i const data = _mm256_loadu_si256 (reinterpret_cast <__m256i const*> (input));
+    __m256i const key = _mm256_loadu_si256 (reinterpret_cast <__m256i const*> (secret));
+    __m256i const dataKey = _mm256_xor_si256 (data, key);
+    __m256i const dataKeyHi = _mm256_shuffle_epi32 (dataKey, _MM_SHUFFLE (0, 3, 0, 1));
+    __m256i const product = _mm256_mul_epu32 (dataKey, dataKeyHi);
+    __m256i const swapped = _mm256_shuffle_epi32 (data, _MM_SHUFFLE (1, 0, 3, 2));
+
+    return _mm256_add_epi64 (product, _mm256_add_epi64 (acc, swapped));
+  }
+
+  static VF_XXHASH3_AVX2 void accumulateAVX2 (uint64* acc, uint8 const* input, uint8 const* secret, size_t stripes)
+  {
+    __m256i* const v = reinterpret_cast <__m256i*> (acc);
+
+    __m256i a0 = _mm256_loadu_si256 (v);
+    __m256i a1 = _mm256_loadu_si256 (v + 1);
+
+    for (size_t n = 0; n < stripes; ++n)
+    {
+      uint8 const* const in = input + n * stripeBytes;
+      uint8 const* const key = secret + n * secretConsumeRate;
+
+      a0 = roundAVX2 (a0, in, key);
+      a1 = roundAVX2 (a1, in + 32, key + 32);
+    }
+
+    _mm256_storeu_si256 (v, a0);
+    _mm256_storeu_si256 (v + 1, a1);
+  }
+
+  static VF_XXHASH3_AVX2 void scrambleAVX2 (uint64* acc, uint8 const* secret)
+  {
+    __m256i const prime = _mm256_set1_epi32 (int (prime32_1));
+    __m256i* const v = reinterpret_cast <__m256i*> (acc);
+
+    for (int i = 0; i < 2; ++i)
+    {
+      __m256i a = _mm256_loadu_si256 (v + i);
+      a = _mm256_xor_si256 (a, _mm256_srli_epi64 (a, 47));
+      a = _mm256_xor_si256 (a, _mm256_loadu_si256 (reinterpret_cast <__m256i const*> (secret) + i));
+
+      __m256i const hi = _mm256_shuffle_epi32 (a, _MM_SHUFFLE (0, 3, 0, 1));
+      __m256i const productLo = _mm256_mul_epu32 (a, prime);
+      __m256i const productHi = _mm256_mul_epu32 (hi, prime);
+
+      _mm256_storeu_si256 (v + i, _mm256_add_epi64 (productLo, _mm256_slli_epi64 (productHi, 32)));
+    }
+  }
+
+  // AVX2 needs support from both the processor and the operating
+  // system, which must save the upper halves of the registers.
+  static bool hasAVX2 ()
+  {
+#if JUCE_MSVC
+    int info [4];
+
+    __cpuid (info, 0);
+    if (info [0] < 7)
+      return false;
+
+    __cpuid (info, 1);
+    if ((info [2] & (1 << 27)) == 0 || (info [2] & (1 << 28)) == 0)
+      return false;
+
+    if ((_xgetbv (0) & 6) != 6)
+      return false;
+
+    __cpuidex (info, 7, 0);
+    return (info [1] & (1 << 5)) != 0;
+
+#else
+    unsigned int a, b, c, d;
+
+    if (__get_cpuid_max (0, nullptr) < 7)
+      return false;
+
+    __cpuid (1, a, b, c, d);
+    if ((c & (1 << 27)) == 0 || (c & (1 << 28)) == 0)
+      return false;
+
+    // xgetbv, encoded for older assemblers
+    __asm__ __volatile__ (".byte 0x0f, 0x01, 0xd0" : "=a" (a), "=d" (d) : "c" (0));
+    if ((a & 6) != 6)
+      return false;
+
+    __cpuid_count (7, 0, a, b, c, d);
+    return (b & (1 << 5)) != 0;
+
+#endif
+  }
+#endif
+
+  //----------------------------------------------------------------------------
+
+  static Kernels const& get (Implementation implementation)
+  {
+    static Kernels const scalar = { &accumulateScalar, &scrambleScalar };
+#if VF_COMPILER_SUPPORTS_SSE2
+    static Kernels const sse2 = { &accumulateSSE2, &scrambleSSE2 };
+#endif
+#if VF_COMPILER_SUPPORTS_AVX2
+    static Kernels const avx2 = { &accumulateAVX2, &scrambleAVX2 };
+#endif
+
+    jassert (isSupported (implementation));
+
+    switch (implementation)
+    {
+#if VF_COMPILER_SUPPORTS_SSE2
+    case implementationSSE2: return sse2;
+#endif
+#if VF_COMPILER_SUPPORTS_AVX2
+    case implementationAVX2: return avx2;
+#endif
+    default:
+      break;
+    };
+
+    return scalar;
+  }
+
+  static Kernels const& getBest ()
+  {
+    static Kernels const& best = get (getBestImplementation ());
+
+    return best;
+  }
+};
+
+uint32 const XXHash3::Kernels::prime32_1 = 0x9E3779B1U;
+uint32 const XXHash3::Kernels::prime32_2 = 0x85EBCA77U;
+uint32 const XXHash3::Kernels::prime32_3 = 0xC2B2AE3DU;
+uint64 const XXHash3::Kernels::prime64_1 = 0x9E3779B185EBCA87ULL;
+uint64 const XXHash3::Kernels::prime64_2 = 0xC2B2AE3D27D4EB4FULL;
+uint64 const XXHash3::Kernels::prime64_3 = 0x165667B19E3779F9ULL;
+uint64 const XXHash3::Kernels::prime64_4 = 0x85EBCA77C2B2AE63ULL;
+uint64 const XXHash3::Kernels::prime64_5 = 0x27D4EB2F165667C5ULL;
+uint64 const XXHash3::Kernels::primeMx1 = 0x165667919E3779F9ULL;
+uint64 const XXHash3::Kernels::primeMx2 = 0x9FB21C651E98DF25ULL;
+
+uint8 const XXHash3::Kernels::defaultSecret [XXHash3::secretBytes] =
+{
+  0xb8, 0xfe, 0x6c, 0x39, 0x23, 0xa4, 0x4b, 0xbe, 0x7c, 0x01, 0x81, 0x2c, 0xf7, 0x21, 0xad, 0x1c,
+  0xde, 0xd4, 0x6d, 0xe9, 0x83, 0x90, 0x97, 0xdb, 0x72, 0x40, 0xa4, 0xa4, 0xb7, 0xb3, 0x67, 0x1f,
+  0xcb, 0x79, 0xe6, 0x4e, 0xcc, 0xc0, 0xe5, 0x78, 0x82, 0x5a, 0xd0, 0x7d, 0xcc, 0xff, 0x72, 0x21,
+  0xb8, 0x08, 0x46, 0x74, 0xf7, 0x43, 0x24, 0x8e, 0xe0, 0x35, 0x90, 0xe6, 0x81, 0x3a, 0x26, 0x4c,
+  0x3c, 0x28, 0x52, 0xbb, 0x91, 0xc3, 0x00, 0xcb, 0x88, 0xd0, 0x65, 0x8b, 0x1b, 0x53, 0x2e, 0xa3,
+  0x71, 0x64, 0x48, 0x97, 0xa2, 0x0d, 0xf9, 0x4e, 0x38, 0x19, 0xef, 0x46, 0xa9, 0xde, 0xac, 0xd8,
+  0xa8, 0xfa, 0x76, 0x3f, 0xe3, 0x9c, 0x34, 0x3f, 0xf9, 0xdc, 0xbb, 0xc7, 0xc7, 0x0b, 0x4f, 0x1d,
+  0x8a, 0x51, 0xe0, 0x4b, 0xcd, 0xb4, 0x59, 0x31, 0xc8, 0x9f, 0x7e, 0xc9, 0xd9, 0x78, 0x73, 0x64,
+  0xea, 0xc5, 0xac, 0x83, 0x34, 0xd3, 0xeb, 0xc3, 0xc5, 0x81, 0xa0, 0xff, 0xfa, 0x13, 0x63, 0xeb,
+  0x17, 0x0d, 0xdd, 0x51, 0xb7, 0xf0, 0xda, 0x49, 0xd3, 0x16, 0x55, 0x26, 0x29, 0xd4, 0x68, 0x9e,
+  0x2b, 0x16, 0xbe, 0x58, 0x7d, 0x47, 0xa1, 0xfc, 0x8f, 0xf8, 0xb8, 0xd1, 0x7a, 0xd0, 0x31, 0xce,
+  0x45, 0xcb, 0x3a, 0x8f, 0x95, 0x16, 0x04, 0x28, 0xaf, 0xd7, 0xfb, 0xca, 0xbb, 0x4b, 0x40, 0x7e
+};
+
+#undef VF_XXHASH3_AVX2
+
+//------------------------------------------------------------------------------
+
+bool XXHash3::isSupported (Implementation implementation)
+{
+  switch (implementation)
+  {
+  case implementationScalar:
+    return true;
+
+  case implementationSSE2:
+    return VF_COMPILER_SUPPORTS_SSE2 != 0;
+
+  case implementationAVX2:
+#if VF_COMPILER_SUPPORTS_AVX2
+    {
+      static bool const supported = Kernels::hasAVX2 ();
+      return supported;
+    }
+#else
+    return false;
+#endif
+  };
+
+  return false;
+}
+
+XXHash3::Implementation XXHash3::getBestImplementation ()
+{
+  if (isSupported (implementationAVX2))
+    return implementationAVX2;
+
+  if (isSupported (implementationSSE2))
+    return implementationSSE2;
+
+  return implementationScalar;
+}
+
+uint64 XXHash3::hash (void const* data, size_t bytes, uint64 seed)
+{
+  uint8 const* const input = static_cast <uint8 const*> (data);
+
+  if (bytes <= Kernels::midSizeMax)
+    return Kernels::hashShort (input, bytes, seed);
+
+  return hash (getBestImplementation (), data, bytes, seed);
+}
+
+uint64 XXHash3::hash (Implementation implementation, void const* data, size_t bytes, uint64 seed)
+{
+  uint8 const* const input = static_cast <uint8 const*> (data);
+
+  if (bytes <= Kernels::midSizeMax)
+    return Kernels::hashShort (input, bytes, seed);
+
+  Kernels const& kernels = Kernels::get (implementation);
+
+  if (seed == 0)
+    return kernels.hashLong (input, bytes, Kernels::defaultSecret);
+
+  uint8 secret [secretBytes];
+  Kernels::initSecret (secret, seed);
+
+  return kernels.hashLong (input, bytes, secret);
+}
+
+//------------------------------------------------------------------------------
+
+XXHash3::XXHash3 (uint64 seed)
+  : m_kernels (&Kernels::getBest ())
+{
+  reset (seed);
+}
+
+void XXHash3::reset (uint64 seed)
+{
+  Kernels::initAccumulators (m_acc);
+  Kernels::initSecret (m_secret, seed);
+
+  m_bufferedBytes = 0;
+  m_stripesSoFar = 0;
+  m_totalBytes = 0;
+  m_seed = seed;
+}
+
+void XXHash3::update (void const* data, size_t bytes)
+{
+  uint8 const* input = static_cast <uint8 const*> (data);
+  uint8 const* const end = input + bytes;
+
+  m_totalBytes += bytes;
+
+  if (bytes <= bufferBytes - m_bufferedBytes)
+  {
+    memcpy (m_buffer + m_bufferedBytes, input, bytes);
+    m_bufferedBytes += bytes;
+    return;
+  }
+
+  // The last stripe is always held back in the buffer, since
+  // getHash() treats the final stripe of the input differently.
+
+  if (m_bufferedBytes > 0)
+  {
+    size_t const loadBytes = bufferBytes - m_bufferedBytes;
+
+    memcpy (m_buffer + m_bufferedBytes, input, loadBytes);
+    input += loadBytes;
+
+    m_kernels->consumeStripes (m_acc, m_stripesSoFar, m_buffer, bufferBytes / stripeBytes, m_secret);
+    m_bufferedBytes = 0;
+  }
+
+  if (size_t (end - input) > bufferBytes)
+  {
+    size_t const stripes = size_t (end - 1 - input) / stripeBytes;
+
+    input = m_kernels->consumeStripes (m_acc, m_stripesSoFar, input, stripes, m_secret);
+
+    // Keep the previous stripe for getHash(), in case less than a
+    // whole stripe remains.
+    memcpy (m_buffer + bufferBytes - stripeBytes, input - stripeBytes, stripeBytes);
+  }
+
+  m_bufferedBytes = size_t (end - input);
+  memcpy (m_buffer, input, m_bufferedBytes);
+}
+
+uint64 XXHash3::getHash () const
+{
+  if (m_totalBytes <= Kernels::midSizeMax)
+    return Kernels::hashShort (m_buffer, size_t (m_totalBytes), m_seed);
+
+  uint64 acc [8];
+  memcpy (acc, m_acc, sizeof (acc));
+
+  uint8 const* lastStripe;
+  uint8 catchup [stripeBytes];
+
+  if (m_bufferedBytes >= stripeBytes)
+  {
+    size_t const stripes = (m_bufferedBytes - 1) / stripeBytes;
+    size_t stripesSoFar = m_stripesSoFar;
+
+    m_kernels->consumeStripes (acc, stripesSoFar, m_buffer, stripes, m_secret);
+
+    lastStripe = m_buffer + m_bufferedBytes - stripeBytes;
+  }
+  else
+  {
+    // Complete the last stripe from the end of the previous one.
+    size_t const catchupBytes = stripeBytes - m_bufferedBytes;
+
+    memcpy (catchup, m_buffer + bufferBytes - catchupBytes, catchupBytes);
+    memcpy (catchup + catchupBytes, m_buffer, m_bufferedBytes);
+
+    lastStripe = catchup;
+  }
+
+  m_kernels->accumulate (acc, lastStripe, m_secret + secretBytes - stripeBytes - Kernels::secretLastAccStart, 1);
+
+  return Kernels::mergeAccumulators (acc, m_secret + Kernels::secretMergeAccsStart, m_totalBytes * Kernels::prime64_1);
+}
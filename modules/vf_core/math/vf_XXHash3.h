@@ -0,0 +1,148 @@
+/*============================================================================*/
+/*
+  VFLib: https://github.com/vinniefalco/VFLib
+
+  Copyright (C) 2008 by Vinnie Falco <vinnie.falco@gmail.com>
+
+  This library contains portions of other open source products covered by
+  separate licenses. Please see the corresponding source files for specific
+  terms.
+  
+  VFLib is provided under the terms of The MIT License (MIT):
+
+  Permission is hereby granted, free of charge, to any person obtaining a copy
+  of this software and associated documentation files (the "Software"), to deal
+  in the Software without restriction, including without limitation the rights
+  to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+  copies of the Software, and to permit persons to whom the Software is
+  furnished to do so, subject to the following conditions:
+
+  The above copyright notice and this permission notice shall be included in
+  all copies or substantial portions of the Software.
+
+  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+  FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+  IN THE SOFTWARE.
+*/
+/*============================================================================*/
+
+#ifndef VF_XXHASH3_VFHEADER
+#define VF_XXHASH3_VFHEADER
+
+/*============================================================================*/
+/**
+  The XXH3 64 bit hash.
+
+  This is a much faster hash than Murmur for large inputs, and the result
+  is identical to XXH3_64bits_withSeed() from the reference implementation,
+  so hashes may be stored and compared with those produced by other tools.
+  It is suited to caching and deduplicating audio files and blobs.
+
+  The inner loop is provided in scalar, SSE2 and AVX2 versions. The fastest
+  one the processor supports is chosen the first time it is needed. AVX2 is
+  compiled in when VF_COMPILER_SUPPORTS_AVX2 is set, which does not require
+  building the whole program for AVX2.
+
+  Data may be hashed all at once:
+
+  @code
+
+  uint64 const hash = XXHash3::hash (data, bytes);
+
+  @endcode
+
+  or in pieces, which gives the same result:
+
+  @code
+
+  XXHash3 hasher;
+
+  while (! stream.isExhausted ())
+  {
+    char buffer [65536];
+    int const bytesRead = stream.read (buffer, sizeof (buffer));
+    hasher.update (buffer, bytesRead);
+  }
+
+  uint64 const hash = hasher.getHash ();
+
+  @endcode
+
+  @see Murmur::Stream32, Murmur::Stream128
+
+  @ingroup vf_core
+*/
+class XXHash3 : Uncopyable
+{
+public:
+  /** The versions of the inner loop. */
+  enum Implementation
+  {
+    implementationScalar,
+    implementationSSE2,
+    implementationAVX2
+  };
+
+  /** Determine if an implementation may be used on this processor. */
+  static bool isSupported (Implementation implementation);
+
+  /** Retrieve the fastest implementation for this processor. */
+  static Implementation getBestImplementation ();
+
+  /** Hash a buffer using the fastest implementation. */
+  static uint64 hash (void const* data, size_t bytes, uint64 seed = 0);
+
+  /** Hash a buffer using a specific implementation.
+
+      The result is the same for all implementations. This is meant for
+      testing and benchmarks.
+
+      @param implementation An implementation for which isSupported() is true.
+  */
+  static uint64 hash (Implementation implementation,
+                      void const* data,
+                      size_t bytes,
+                      uint64 seed = 0);
+
+  //----------------------------------------------------------------------------
+
+  /** Create an incremental hash. */
+  explicit XXHash3 (uint64 seed = 0);
+
+  /** Start a new hash. */
+  void reset (uint64 seed = 0);
+
+  /** Add data to the hash. */
+  void update (void const* data, size_t bytes);
+
+  /** Retrieve the hash of everything added so far.
+
+      More data may still be added afterwards.
+  */
+  uint64 getHash () const;
+
+private:
+  enum
+  {
+    stripeBytes = 64,
+    secretBytes = 192,
+    bufferBytes = 256
+  };
+
+  struct Kernels;
+
+  uint64 m_acc [8];
+  uint8 m_buffer [bufferBytes];
+  uint8 m_secret [secretBytes];
+  size_t m_bufferedBytes;
+  size_t m_stripesSoFar;
+  uint64 m_totalBytes;
+  uint64 m_seed;
+  Kernels const* m_kernels;
+};
+
+#endif
@@ -108,6 +108,9 @@ bool InterruptibleThread::wait (int milliSeconds)
 
   if (!interrupted)
   {
+    if (milliSeconds != 0)
+      RealtimeChecker::check ("InterruptibleThread::wait");
+
     interrupted = m_thread.wait (milliSeconds);
 
     if (!interrupted)
@@ -174,6 +177,11 @@ bool InterruptibleThread::interruptionPoint ()
   return interrupted;
 }
 
+bool InterruptibleThread::isInterrupted () const
+{
+  return m_state == stateInterrupt;
+}
+
 InterruptibleThread::id InterruptibleThread::getId () const
 {
   return m_threadId;
@@ -107,6 +107,16 @@ public:
   */
   bool interruptionPoint ();
 
+  /** Determine if an interruption is pending, without clearing it.
+
+      This is cheaper than interruptionPoint() when polling in a loop, since
+      it only reads the state. Any thread may call this, but the result is
+      only meaningful on the thread of execution.
+
+      @return `true` if interruptionPoint() would return `true`.
+  */
+  bool isInterrupted () const;
+
   /** Get the ID of the associated thread.
 
       @return The ID of the thread.
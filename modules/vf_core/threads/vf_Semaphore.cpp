@@ -30,6 +30,15 @@
 */
 /*============================================================================*/
 
+namespace
+{
+
+// Used by every Semaphore without a site of its own.
+//
+ContentionProfiler::Site waitSite ("Semaphore::wait");
+
+}
+
 Semaphore::WaitingThread::WaitingThread ()
   : m_event (false) // auto-reset
 {
@@ -48,7 +57,14 @@ void Semaphore::WaitingThread::signal ()
 //==============================================================================
 
 Semaphore::Semaphore (int initialCount)
-  : m_counter (initialCount)
+  : m_waitSite (waitSite)
+  , m_counter (initialCount)
+{
+}
+
+Semaphore::Semaphore (int initialCount, ContentionProfiler::Site& waitSite)
+  : m_waitSite (waitSite)
+  , m_counter (initialCount)
 {
 }
 
@@ -90,6 +106,8 @@ void Semaphore::signal (int amount)
 
 void Semaphore::wait ()
 {
+  RealtimeChecker::check ("Semaphore::wait");
+
   // Always prepare the WaitingThread object first, either
   // from the delete list or through a new allocation.
   //
@@ -115,11 +133,17 @@ void Semaphore::wait ()
     }
   }
 
+  m_waitSite.addAcquisition ();
+
   // Do we need to wait?
   if (waitingThread != nullptr)
   {
     // Yes so do it.
-    waitingThread->wait ();
+    {
+      ContentionProfiler::ScopedBlock block (m_waitSite);
+
+      waitingThread->wait ();
+    }
 
     // If the wait is satisfied, then we've been taken off the
     // waiting list so put waitingThread back in the delete list.
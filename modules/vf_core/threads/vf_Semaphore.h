@@ -53,6 +53,15 @@ public:
   */
   explicit Semaphore (int initialCount);
 
+  /** Create a semaphore which records contention in its own site.
+
+      The site must outlive the semaphore. See ContentionProfiler.
+
+      @param initialCount The starting number of resources.
+      @param waitSite     The site for wait().
+  */
+  Semaphore (int initialCount, ContentionProfiler::Site& waitSite);
+
   ~Semaphore ();
 
   /** Increase the number of available resources.
@@ -82,6 +91,7 @@ private:
 
   typedef SpinLock LockType;
 
+  ContentionProfiler::Site& m_waitSite;
   LockType m_mutex;
   Atomic <int> m_counter;
   LockFreeStack <WaitingThread> m_waitingThreads;
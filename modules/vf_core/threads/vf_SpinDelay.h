@@ -33,25 +33,72 @@
 #ifndef VF_SPINDELAY_VFHEADER
 #define VF_SPINDELAY_VFHEADER
 
+#include "../diagnostic/vf_ContentionProfiler.h"
+
 //
 // Synchronization element
 //
+// When constructed with a ContentionProfiler::Site, the
+// spins, yields and elapsed time are recorded there.
+//
 
 class SpinDelay
 {
 public:
   SpinDelay () : m_count (0)
+#if VF_USE_CONTENTION_PROFILER
+    , m_site (nullptr)
+    , m_startTicks (0)
+#endif
+  {
+  }
+
+  explicit SpinDelay (ContentionProfiler::Site& site) : m_count (0)
+#if VF_USE_CONTENTION_PROFILER
+    , m_site (&site)
+    , m_startTicks (CpuTicks::getTicks ())
+#endif
+  {
+    (void) site;
+  }
+
+#if VF_USE_CONTENTION_PROFILER
+  /** Record in a site, measuring the time from an earlier start.
+  */
+  SpinDelay (ContentionProfiler::Site& site, int64 startTicks) : m_count (0)
+    , m_site (&site)
+    , m_startTicks (startTicks)
   {
   }
+#endif
+
+#if VF_USE_CONTENTION_PROFILER
+  ~SpinDelay ()
+  {
+    if (m_site != nullptr)
+      m_site->addContention (jmin (m_count, int (spinsBeforeYield)),
+                             jmax (0, m_count - spinsBeforeYield),
+                             CpuTicks::getTicks () - m_startTicks);
+  }
+#endif
 
   inline void pause ()
   {
-    if (++m_count > 20)
+    if (++m_count > spinsBeforeYield)
       Thread::yield ();
   }
 
 private:
+  enum
+  {
+    spinsBeforeYield = 20
+  };
+
   int m_count;
+#if VF_USE_CONTENTION_PROFILER
+  ContentionProfiler::Site* const m_site;
+  int64 const m_startTicks;
+#endif
 };
 
 #endif
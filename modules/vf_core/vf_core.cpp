@@ -55,16 +55,24 @@
 namespace vf
 {
 
+#include "diagnostic/vf_Benchmark.cpp"
 #include "diagnostic/vf_CatchAny.cpp"
+#include "diagnostic/vf_ContentionProfiler.cpp"
+#include "diagnostic/vf_CpuTicks.cpp"
 #include "diagnostic/vf_Debug.cpp"
 #include "diagnostic/vf_Error.cpp"
 #include "diagnostic/vf_FPUFlags.cpp"
+#include "diagnostic/vf_HashBenchmark.cpp"
 #include "diagnostic/vf_LeakChecked.cpp"
+#include "diagnostic/vf_RealtimeChecker.cpp"
+#include "diagnostic/vf_Trace.cpp"
 
 #include "events/vf_OncePerSecond.cpp"
 #include "events/vf_PerformedAtExit.cpp"
+#include "events/vf_TimerWheel.cpp"
 
 #include "math/vf_MurmurHash.cpp"
+#include "math/vf_XXHash3.cpp"
 
 #include "threads/vf_InterruptibleThread.cpp"
 #include "threads/vf_Semaphore.cpp"
@@ -81,6 +89,10 @@ namespace vf
 
 }
 
+#if VF_USE_REALTIME_CHECKER
+#include "diagnostic/vf_RealtimeOperatorNew.cpp"
+#endif
+
 #if JUCE_MSVC
 #pragma warning (pop)
 #endif
@@ -277,9 +277,46 @@
 #define VF_USE_LEAKCHECKED JUCE_CHECK_MEMORY_LEAKS
 #endif
 
+#ifndef VF_USE_CALLQUEUE_METRICS
+#define VF_USE_CALLQUEUE_METRICS 0
+#endif
+
+#ifndef VF_USE_TRACE
+#define VF_USE_TRACE 0
+#endif
+
+#ifndef VF_USE_CONTENTION_PROFILER
+#define VF_USE_CONTENTION_PROFILER 0
+#endif
+
+#ifndef VF_USE_REALTIME_CHECKER
+#define VF_USE_REALTIME_CHECKER 0
+#endif
+
 /* Get this early so we can use it. */
 #include "modules/juce_core/system/juce_TargetPlatform.h"
 
+/* SSE2 is detected from the compiler's target architecture. */
+#ifndef VF_COMPILER_SUPPORTS_SSE2
+# if JUCE_INTEL && (defined (__SSE2__) || defined (_M_X64) || (defined (_M_IX86_FP) && _M_IX86_FP >= 2))
+#  define VF_COMPILER_SUPPORTS_SSE2 1
+# else
+#  define VF_COMPILER_SUPPORTS_SSE2 0
+# endif
+#endif
+
+/* AVX2 code is compiled for individual functions and chosen at run time,
+   so it only needs a compiler which knows the instructions.
+*/
+#ifndef VF_COMPILER_SUPPORTS_AVX2
+# if JUCE_INTEL && ((JUCE_MSVC && _MSC_VER >= 1700) || \
+                    (JUCE_GCC && (defined (__clang__) || __GNUC__ > 4 || (__GNUC__ == 4 && __GNUC_MINOR__ >= 9))))
+#  define VF_COMPILER_SUPPORTS_AVX2 1
+# else
+#  define VF_COMPILER_SUPPORTS_AVX2 0
+# endif
+#endif
+
 // Handy macro that lets pragma warnings be clicked in the output window
 // Usage: #pragma message(VF_LOC_"Advertise here!")
 #define VF_STR2_(x) #x
@@ -299,6 +336,7 @@
 #if JUCE_MSVC
 # include <crtdbg.h>
 # include <functional>
+# include <intrin.h>
 #elif JUCE_IOS
 # if VF_USE_BOOST
 #  include <boost/bind.hpp>
@@ -334,6 +372,21 @@
 #include <typeinfo>
 #include <vector>
 
+#if VF_COMPILER_SUPPORTS_SSE2
+#include <emmintrin.h>
+#endif
+
+#if VF_COMPILER_SUPPORTS_AVX2
+#include <immintrin.h>
+# if JUCE_GCC
+#  include <cpuid.h>
+# endif
+#endif
+
+#if VF_USE_REALTIME_CHECKER && (JUCE_LINUX || JUCE_MAC || JUCE_IOS)
+#include <execinfo.h>
+#endif
+
 #include <assert.h>
 #include <ctype.h>
 #include <errno.h>
@@ -425,22 +478,30 @@ using namespace juce;
 
 // This group must come first since other files need it
 #include "memory/vf_Uncopyable.h"
+#include "diagnostic/vf_Benchmark.h"
 #include "diagnostic/vf_CatchAny.h"
+#include "diagnostic/vf_ContentionProfiler.h"
+#include "diagnostic/vf_CpuTicks.h"
 #include "diagnostic/vf_Debug.h"
 #include "diagnostic/vf_Error.h"
 #include "diagnostic/vf_FPUFlags.h"
+#include "diagnostic/vf_HashBenchmark.h"
 #include "diagnostic/vf_LeakChecked.h"
+#include "diagnostic/vf_RealtimeChecker.h"
 #include "diagnostic/vf_SafeBool.h"
 #include "diagnostic/vf_Throw.h"
+#include "diagnostic/vf_Trace.h"
 
+#include "containers/vf_ConcurrentHashMap.h"
+#include "containers/vf_FlatHashMap.h"
 #include "containers/vf_List.h"
 #include "containers/vf_LockFreeStack.h"
 #include "containers/vf_LockFreeQueue.h"
 #include "containers/vf_Map2D.h"
 #include "containers/vf_SharedTable.h"
+#include "containers/vf_StaticBTree.h"
 #include "containers/vf_SortedLookupTable.h"
 
-#include "events/vf_OncePerSecond.h"
 #include "events/vf_PerformedAtExit.h"
 
 #include "functor/vf_Bind.h"
@@ -450,6 +511,7 @@ using namespace juce;
 #include "math/vf_Math.h"
 #include "math/vf_MurmurHash.h"
 #include "math/vf_Vec3.h"
+#include "math/vf_XXHash3.h"
 
 #include "memory/vf_AtomicCounter.h"
 #include "memory/vf_AtomicFlag.h"
@@ -466,6 +528,7 @@ using namespace juce;
 #pragma warning (pop)
 #endif
 
+#include "memory/vf_HeapAllocator.h"
 #include "memory/vf_MemoryAlignment.h"
 #include "memory/vf_RefCountedSingleton.h"
 #include "memory/vf_StaticObject.h"
@@ -475,6 +538,9 @@ using namespace juce;
 #include "threads/vf_SpinDelay.h"
 #include "threads/vf_InterruptibleThread.h"
 
+#include "events/vf_TimerWheel.h"
+#include "events/vf_OncePerSecond.h"
+
 }
 
 #endif
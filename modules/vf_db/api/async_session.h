@@ -0,0 +1,228 @@
+/*============================================================================*/
+/*
+  VFLib: https://github.com/vinniefalco/VFLib
+
+  Copyright (C) 2008 by Vinnie Falco <vinnie.falco@gmail.com>
+
+  This library contains portions of other open source products covered by
+  separate licenses. Please see the corresponding source files for specific
+  terms.
+  
+  VFLib is provided under the terms of The MIT License (MIT):
+
+  Permission is hereby granted, free of charge, to any person obtaining a copy
+  of this software and associated documentation files (the "Software"), to deal
+  in the Software without restriction, including without limitation the rights
+  to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+  copies of the Software, and to permit persons to whom the Software is
+  furnished to do so, subject to the following conditions:
+
+  The above copyright notice and this permission notice shall be included in
+  all copies or substantial portions of the Software.
+
+  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+  FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+  IN THE SOFTWARE.
+*/
+/*============================================================================*/
+
+#ifndef VF_DB_ASYNC_SESSION_VFHEADER
+#define VF_DB_ASYNC_SESSION_VFHEADER
+
+namespace db {
+
+/*============================================================================*/
+/**
+  A session which runs queries on a thread of its own.
+
+  Every call on a session blocks the calling thread until SQLite returns,
+  which with an infinite busy timeout can take as long as another process
+  holds the write lock. This class owns a session on a ThreadWithCallQueue
+  instead. Queries are posted to it as functors which receive the session,
+  and their results are delivered as functors called on a CallQueue chosen
+  by the caller, usually the one belonging to the thread that posted them:
+
+  @code
+
+  class Catalog
+  {
+  public:
+    Catalog ()
+    {
+      Error error = m_db.open (File ("catalog.db").getFullPathName ());
+      ...
+    }
+
+    void rename (int id, String name)
+    {
+      m_db.write (vf::bind (&Catalog::doRename, _1, id, name),
+                  m_guiQueue, vf::bind (&Catalog::onRenamed, this, _1));
+    }
+
+  private:
+    static Error doRename (db::session& s, int id, String name)
+    {
+      Error error;
+      s.once (error) << "UPDATE tracks SET name = ? WHERE id = ?",
+                        db::use (name), db::use (id);
+      return error;
+    }
+
+    void onRenamed (Error error)
+    {
+      // called on the message thread
+    }
+
+    GuiCallQueue m_guiQueue;
+    db::async_session m_db;
+  };
+
+  @endcode
+
+  Consecutive writes are grouped into a single transaction, so that the cost
+  of a commit is shared between them. The transaction is committed when it
+  holds the batch size number of writes, or when the commit latency has
+  passed since the first of them, whichever comes first. Each write runs
+  inside a savepoint, so a write which fails is rolled back on its own
+  without affecting the others in the group. The reply to a write is not
+  delivered until its transaction is committed, and if the commit fails
+  every write in the group receives the error.
+
+  Reads run in the order they were posted relative to the writes, on the
+  same connection, so they see every write posted before them even if it
+  is not yet committed.
+
+  Query functors must not begin, commit or roll back a transaction.
+
+  @ingroup vf_db
+*/
+class async_session : Uncopyable
+{
+public:
+  enum
+  {
+    defaultCommitLatency = 10,
+    defaultBatchSize = 256
+  };
+
+  /** A query, called on the database thread.
+
+      The returned error is passed to the reply. An Error or other
+      exception thrown by the query is passed to the reply in the same way,
+      and a write which throws is undone like one which fails.
+  */
+  typedef Function <Error (session&)> query_t;
+
+  /** The reply to a query, called on the reply queue.
+  */
+  typedef Function <void (Error)> reply_t;
+
+  /** Counters for tuning the commit latency and batch size.
+  */
+  struct stats
+  {
+    int64 reads;
+    int64 writes;
+    int64 failed_writes;
+    int64 transactions;
+
+    /** The number of transactions committed because they were full. */
+    int64 full_transactions;
+  };
+
+  explicit async_session (String threadName = "vf::db::async_session");
+
+  /** Destroy the session.
+
+      Pending writes are committed, and the thread is stopped.
+  */
+  ~async_session ();
+
+  /** Open the database on the thread.
+
+      This blocks until the database is open.
+
+      @param fileName The path to the database.
+      @param options  The connect string passed to session::open().
+  */
+  Error open (String fileName, std::string options = "");
+
+  /** Commit pending writes and close the database.
+
+      This blocks until the database is closed. Queries must not be posted
+      while the database is closed.
+  */
+  void close ();
+
+  /** Set the longest time, in milliseconds, that a write waits for
+      others to share its transaction.
+  */
+  void set_commit_latency (int milliseconds);
+
+  /** Set the largest number of writes grouped into one transaction.
+  */
+  void set_batch_size (int writes);
+
+  /** Post a query which only reads.
+  */
+  void read (query_t const& query);
+
+  /** Post a query which only reads, and deliver its result.
+  */
+  void read (query_t const& query, CallQueue& replyQueue, reply_t const& reply);
+
+  /** Post a query which writes.
+  */
+  void write (query_t const& query);
+
+  /** Post a query which writes, and deliver its result once committed.
+  */
+  void write (query_t const& query, CallQueue& replyQueue, reply_t const& reply);
+
+  /** Commit pending writes without waiting for the latency or batch size.
+  */
+  void flush ();
+
+  /** Retrieve the counters.
+  */
+  stats get_stats () const;
+
+private:
+  struct pending_reply
+  {
+    CallQueue* queue;
+    reply_t reply;
+    Error error;
+  };
+
+  void do_open (String fileName, std::string options, Error* error, WaitableEvent* done);
+  void do_close (WaitableEvent* done);
+  Error run_query (query_t& query);
+  void do_read (query_t query, CallQueue* replyQueue, reply_t reply);
+  void do_write (query_t query, CallQueue* replyQueue, reply_t reply);
+  void do_commit (bool full);
+  void set_latency_on_thread (int milliseconds);
+  void set_batch_size_on_thread (int writes);
+
+private:
+  ThreadWithCallQueue m_thread;
+  CallQueueTimer m_commitTimer;
+  ScopedPointer <session> m_session;
+
+  // only touched on the database thread
+  int m_commitLatency;
+  int m_batchSize;
+  int m_writesInTransaction;
+  std::vector <pending_reply> m_replies;
+
+  CriticalSection mutable m_mutex;  // protects m_stats
+  stats m_stats;
+};
+
+}
+
+#endif
@@ -88,6 +88,15 @@ public:
                 rowid id,
                 bool readAndWrite = false) noexcept;
 
+  // Moves to another row of the same table and column without
+  // opening a new handle. This is faster than calling select again.
+  Error reopen (rowid id);
+
+  bool is_open () const
+  {
+    return m_blob != 0;
+  }
+
   std::size_t get_len();
   Error read (std::size_t offset, void* buf, std::size_t toRead);
   Error write (std::size_t offset, void const* buf, std::size_t toWrite);
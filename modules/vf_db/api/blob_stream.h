@@ -0,0 +1,173 @@
+/*============================================================================*/
+/*
+  VFLib: https://github.com/vinniefalco/VFLib
+
+  Copyright (C) 2008 by Vinnie Falco <vinnie.falco@gmail.com>
+
+  This library contains portions of other open source products covered by
+  separate licenses. Please see the corresponding source files for specific
+  terms.
+  
+  VFLib is provided under the terms of The MIT License (MIT):
+
+  Permission is hereby granted, free of charge, to any person obtaining a copy
+  of this software and associated documentation files (the "Software"), to deal
+  in the Software without restriction, including without limitation the rights
+  to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+  copies of the Software, and to permit persons to whom the Software is
+  furnished to do so, subject to the following conditions:
+
+  The above copyright notice and this permission notice shall be included in
+  all copies or substantial portions of the Software.
+
+  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+  FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+  IN THE SOFTWARE.
+*/
+/*============================================================================*/
+
+#ifndef VF_DB_BLOB_STREAM_VFHEADER
+#define VF_DB_BLOB_STREAM_VFHEADER
+
+namespace db {
+
+/*============================================================================*/
+/**
+  A seekable InputStream which reads a blob.
+
+  Large assets such as audio and waveform caches can be decoded straight
+  from the database, without first reading the whole blob into memory:
+
+  @code
+
+  db::blob b;
+  Error error = b.select (s, "samples", "data", id);
+
+  if (!error)
+  {
+    db::blob_input_stream* stream = new db::blob_input_stream (b);
+
+    ScopedPointer <AudioFormatReader> reader (
+      WavAudioFormat ().createReaderFor (stream, true));
+    ...
+  }
+
+  @endcode
+
+  Reads are served from a buffer which is filled a block at a time, so
+  that the many small reads made by parsers do not each go through
+  SQLite. Reads larger than the buffer go straight to the blob.
+
+  To read the same column of many rows, call reopen() to move the stream
+  and its blob handle to the next row instead of selecting a new blob.
+
+  If the row is changed while the stream is open, SQLite aborts the blob
+  and the stream becomes exhausted.
+
+  The blob must outlive the stream.
+
+  @ingroup vf_db
+*/
+class blob_input_stream : public InputStream
+{
+public:
+  enum
+  {
+    defaultBufferSize = 32768
+  };
+
+  explicit blob_input_stream (blob& source, int bufferSize = defaultBufferSize);
+  ~blob_input_stream ();
+
+  /** Move to another row of the same table and column.
+
+      The position returns to the start.
+  */
+  Error reopen (rowid id);
+
+  int64 getTotalLength ();
+  bool isExhausted ();
+  int read (void* destBuffer, int maxBytesToRead);
+  int64 getPosition ();
+  bool setPosition (int64 newPosition);
+
+private:
+  bool read_blob (int64 offset, void* dest, int bytes);
+
+  blob& m_blob;
+  HeapBlock <char> m_buffer;
+  int const m_bufferSize;
+  int64 m_bufferStart;
+  int m_bufferBytes;
+  int64 m_position;
+  int64 m_length;
+};
+
+//==============================================================================
+/**
+  A seekable OutputStream which writes into a blob.
+
+  A blob cannot change size once its row is written, so space must be
+  reserved with zeroblob() when the row is inserted, and the blob selected
+  for writing. Writes past the end of the blob fail.
+
+  @code
+
+  s.once (error) << "INSERT INTO samples (data) VALUES (zeroblob(?))", db::use (bytes);
+
+  db::blob b;
+  error = b.select (s, "samples", "data", s.last_insert_rowid (), true);
+
+  db::blob_output_stream stream (b);
+  stream.write (data, bytes);
+
+  @endcode
+
+  Small writes are gathered in a buffer which is written to the blob when
+  it fills, when the position changes, or when the stream is flushed or
+  destroyed.
+
+  The blob must outlive the stream.
+
+  @ingroup vf_db
+*/
+class blob_output_stream : public OutputStream
+{
+public:
+  enum
+  {
+    defaultBufferSize = 32768
+  };
+
+  explicit blob_output_stream (blob& dest, int bufferSize = defaultBufferSize);
+  ~blob_output_stream ();
+
+  /** Move to another row of the same table and column.
+
+      Buffered data is written first, and the position returns to the start.
+  */
+  Error reopen (rowid id);
+
+  void flush ();
+  bool setPosition (int64 newPosition);
+  int64 getPosition ();
+  bool write (const void* dataToWrite, size_t numberOfBytes);
+
+private:
+  bool write_buffer ();
+
+  blob& m_blob;
+  HeapBlock <char> m_buffer;
+  int const m_bufferSize;
+  int m_bufferBytes;
+  int64 m_position;
+  int64 m_length;
+};
+
+}
+
+#endif
@@ -0,0 +1,92 @@
+/*============================================================================*/
+/*
+  VFLib: https://github.com/vinniefalco/VFLib
+
+  Copyright (C) 2008 by Vinnie Falco <vinnie.falco@gmail.com>
+
+  This library contains portions of other open source products covered by
+  separate licenses. Please see the corresponding source files for specific
+  terms.
+  
+  VFLib is provided under the terms of The MIT License (MIT):
+
+  Permission is hereby granted, free of charge, to any person obtaining a copy
+  of this software and associated documentation files (the "Software"), to deal
+  in the Software without restriction, including without limitation the rights
+  to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+  copies of the Software, and to permit persons to whom the Software is
+  furnished to do so, subject to the following conditions:
+
+  The above copyright notice and this permission notice shall be included in
+  all copies or substantial portions of the Software.
+
+  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+  FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+  IN THE SOFTWARE.
+*/
+/*============================================================================*/
+
+#ifndef VF_DB_BULK_BENCHMARK_VFHEADER
+#define VF_DB_BULK_BENCHMARK_VFHEADER
+
+namespace db {
+
+/*============================================================================*/
+/**
+  Benchmark cases for inserting and scanning rows.
+
+  Each case works on a table of three columns in a temporary database, and
+  the payload size is the number of rows. A single operation inserts or
+  scans every row, so rows per second are the operations per second
+  multiplied by the payload size:
+
+  @code
+
+  Benchmark benchmark;
+
+  Benchmark::Options options;
+  options.threadCounts.assign (1, 1);
+  options.payloadSizes.assign (1, 1000000);
+  options.operationsPerThread = 3;
+  options.warmupOperations = 1;
+  benchmark.setOptions (options);
+
+  db::bulk_benchmark::add_all_cases (benchmark);
+
+  std::cout << Benchmark::toCSV (benchmark.run ());
+
+  @endcode
+
+  The cases are:
+
+  - insert row by row: a prepared insert executed once per row with
+    single value uses, inside one transaction.
+  - insert bulk: the same insert with vector uses.
+  - scan row by row: a select fetching one row at a time into single
+    values.
+  - scan bulk: the same select fetching 1024 rows at a time into vectors.
+
+  @ingroup vf_db
+*/
+class bulk_benchmark
+{
+public:
+  /** Add every case to a benchmark.
+  */
+  static void add_all_cases (Benchmark& benchmark);
+
+private:
+  class table_case;
+  class insert_case;
+  class insert_bulk_case;
+  class scan_case;
+  class scan_bulk_case;
+};
+
+}
+
+#endif
@@ -0,0 +1,225 @@
+/*============================================================================*/
+/*
+  VFLib: https://github.com/vinniefalco/VFLib
+
+  Copyright (C) 2008 by Vinnie Falco <vinnie.falco@gmail.com>
+
+  This library contains portions of other open source products covered by
+  separate licenses. Please see the corresponding source files for specific
+  terms.
+  
+  VFLib is provided under the terms of The MIT License (MIT):
+
+  Permission is hereby granted, free of charge, to any person obtaining a copy
+  of this software and associated documentation files (the "Software"), to deal
+  in the Software without restriction, including without limitation the rights
+  to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+  copies of the Software, and to permit persons to whom the Software is
+  furnished to do so, subject to the following conditions:
+
+  The above copyright notice and this permission notice shall be included in
+  all copies or substantial portions of the Software.
+
+  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+  FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+  IN THE SOFTWARE.
+*/
+/*============================================================================*/
+
+#ifndef VF_DB_BULK_LOADER_VFHEADER
+#define VF_DB_BULK_LOADER_VFHEADER
+
+namespace db {
+
+/*============================================================================*/
+/**
+  Puts a session into a mode for loading many rows quickly.
+
+  Importing rows one transaction at a time, with the default settings,
+  spends most of its time syncing the journal. While a load is in progress
+  the loader relaxes the durability settings, enlarges the page cache, and
+  groups the inserted rows into large transactions. Secondary indexes on
+  the table being loaded can be dropped first and rebuilt at the end, which
+  is much faster than updating them for every row:
+
+  @code
+
+  db::bulk_loader loader (s);
+
+  Error error = loader.begin ("tracks");
+
+  std::string name;
+  int album;
+  db::statement st = (s.prepare << "INSERT INTO tracks (name, album) VALUES (?, ?)",
+                      db::use (name), db::use (album));
+
+  while (!error && source.next (name, album))
+    error = loader.execute (st);
+
+  // finish even if the load failed, to put back the settings and indexes
+  Error finishError = loader.finish ();
+
+  if (!error)
+    error = finishError;
+
+  Logger::outputDebugString (String (loader.get_stats ().rows_per_second));
+
+  @endcode
+
+  The settings in force before the load are put back by finish(), which
+  then rebuilds the dropped indexes one at a time, even if the load failed.
+  An index which can't be rebuilt, such as a UNIQUE index over rows which
+  are no longer unique, is left out, and the table is without it until the
+  caller creates it again from get_failed_indexes().
+
+  If the process dies during the load with the journal turned off the
+  database may be corrupt, so this is meant for imports which can be
+  started over.
+
+  mmap_size is only honored by SQLite 3.7.17 and later, and is ignored by
+  older versions.
+
+  @ingroup vf_db
+*/
+class bulk_loader : Uncopyable
+{
+public:
+  /** Settings used during the load.
+  */
+  struct options
+  {
+    options ();
+
+    /** The journal_mode pragma. The default is "OFF". */
+    std::string journal_mode;
+
+    /** The synchronous pragma. The default is "OFF". */
+    std::string synchronous;
+
+    /** The cache_size pragma. Negative numbers are in KiB. The default
+        is -262144, or 256 MiB.
+    */
+    int cache_size;
+
+    /** The mmap_size pragma in bytes. The default is 256 MiB. */
+    int64 mmap_size;
+
+    /** The temp_store pragma. The default is "MEMORY". */
+    std::string temp_store;
+
+    /** The number of rows in each transaction. The default is 100000. */
+    int batch_size;
+
+    /** Drop the table's secondary indexes during the load. The default
+        is `true`.
+    */
+    bool drop_indexes;
+  };
+
+  /** Measurements of a load.
+
+      Times are in seconds.
+  */
+  struct stats
+  {
+    int64 rows;
+    int64 transactions;
+    double seconds;
+    double rows_per_second;
+
+    /** The number of indexes dropped. */
+    int indexes;
+
+    /** The number of dropped indexes which could not be rebuilt. */
+    int failed_indexes;
+
+    /** The time spent rebuilding indexes, included in seconds. */
+    double index_seconds;
+  };
+
+  explicit bulk_loader (session& s, options const& opts = options ());
+
+  /** Destroy the loader.
+
+      A load still in progress is finished.
+  */
+  ~bulk_loader ();
+
+  /** Start loading.
+
+      @param table The table being loaded, whose indexes are dropped if
+                   requested. This may be empty when loading several
+                   tables, in which case no indexes are dropped.
+  */
+  Error begin (std::string const& table = "");
+
+  /** Execute a prepared insert, and count the rows it changed.
+  */
+  Error execute (statement& st);
+
+  /** Count rows inserted by other means since the last call.
+
+      The transaction is committed and a new one begun when it holds
+      the batch size number of rows.
+  */
+  Error update ();
+
+  /** Commit the last rows, restore the settings and rebuild the indexes.
+
+      If the last rows can't be committed they are rolled back, except
+      that without a journal, where a rollback is undefined, the commit is
+      tried once more first. The settings are put back and the indexes
+      rebuilt in either case.
+  */
+  Error finish ();
+
+  /** Determine if a load is in progress.
+  */
+  bool is_loading () const
+  {
+    return m_loading;
+  }
+
+  /** Retrieve the measurements, which are updated as rows are loaded.
+  */
+  stats get_stats () const;
+
+  /** Retrieve the SQL of the indexes which finish() could not rebuild.
+  */
+  std::vector <std::string> const& get_failed_indexes () const
+  {
+    return m_failedIndexes;
+  }
+
+private:
+  struct saved_pragma
+  {
+    std::string name;
+    std::string value;
+  };
+
+  Error set_pragma (std::string const& name, std::string const& value);
+  Error drop_indexes (std::string const& table);
+  Error rebuild_indexes ();
+  Error restore ();
+
+private:
+  session& m_session;
+  options const m_options;
+  bool m_loading;
+  int64 m_startTicks;
+  int m_totalChanges;
+  int64 m_rowsInTransaction;
+  std::vector <saved_pragma> m_savedPragmas;
+  std::vector <std::string> m_indexes;
+  std::vector <std::string> m_failedIndexes;
+  stats m_stats;
+};
+
+}
+
+#endif
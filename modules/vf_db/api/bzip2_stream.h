@@ -0,0 +1,128 @@
+/*============================================================================*/
+/*
+  VFLib: https://github.com/vinniefalco/VFLib
+
+  Copyright (C) 2008 by Vinnie Falco <vinnie.falco@gmail.com>
+
+  This library contains portions of other open source products covered by
+  separate licenses. Please see the corresponding source files for specific
+  terms.
+  
+  VFLib is provided under the terms of The MIT License (MIT):
+
+  Permission is hereby granted, free of charge, to any person obtaining a copy
+  of this software and associated documentation files (the "Software"), to deal
+  in the Software without restriction, including without limitation the rights
+  to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+  copies of the Software, and to permit persons to whom the Software is
+  furnished to do so, subject to the following conditions:
+
+  The above copyright notice and this permission notice shall be included in
+  all copies or substantial portions of the Software.
+
+  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+  FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+  IN THE SOFTWARE.
+*/
+/*============================================================================*/
+
+#ifndef VF_DB_BZIP2_STREAM_VFHEADER
+#define VF_DB_BZIP2_STREAM_VFHEADER
+
+namespace db {
+
+/*============================================================================*/
+/**
+  An InputStream which decompresses bZip2 data from another stream.
+
+  This is used with blob_input_stream to store assets compressed in the
+  database, and decompress them as they are read:
+
+  @code
+
+  InputStream* stream = new db::bzip2_input_stream (
+    new db::blob_input_stream (b), true);
+
+  @endcode
+
+  The uncompressed length is not known, so getTotalLength() returns -1.
+  Seeking forward decompresses and discards the data in between, and
+  seeking backward starts again from the beginning, so the source must be
+  seekable for that to work.
+
+  This requires VF_USE_BZIP2 and the @ref vf_bzip2 external module.
+
+  @ingroup vf_db
+*/
+class bzip2_input_stream : public InputStream
+{
+public:
+  bzip2_input_stream (InputStream* source, bool deleteSourceWhenDestroyed);
+  ~bzip2_input_stream ();
+
+  int64 getTotalLength ();
+  bool isExhausted ();
+  int read (void* destBuffer, int maxBytesToRead);
+  int64 getPosition ();
+  bool setPosition (int64 newPosition);
+
+private:
+  class Decompressor;
+
+  OptionalScopedPointer <InputStream> m_source;
+  int64 const m_sourceStart;
+  ScopedPointer <Decompressor> m_decompressor;
+  int64 m_position;
+};
+
+//==============================================================================
+/**
+  An OutputStream which compresses data with bZip2 into another stream.
+
+  A blob has a fixed size, so compressed data is usually gathered in a
+  MemoryOutputStream and then stored with a use() binding, or written into
+  a blob of the compressed size with blob_output_stream.
+
+  The compressed stream is completed when this object is destroyed.
+  Calling flush() ends the current bZip2 block, which costs some
+  compression, and flushes the destination.
+
+  This requires VF_USE_BZIP2 and the @ref vf_bzip2 external module.
+
+  @ingroup vf_db
+*/
+class bzip2_output_stream : public OutputStream
+{
+public:
+  /** Create the stream.
+
+      @param blockSize100k The bZip2 block size, from 1 to 9, in units of
+                           100,000 bytes. Larger blocks compress better and
+                           use more memory.
+  */
+  bzip2_output_stream (OutputStream* dest,
+                       bool deleteDestWhenDestroyed,
+                       int blockSize100k = 9);
+
+  ~bzip2_output_stream ();
+
+  void flush ();
+  bool setPosition (int64 newPosition);
+  int64 getPosition ();
+  bool write (const void* dataToWrite, size_t numberOfBytes);
+
+private:
+  class Compressor;
+
+  OptionalScopedPointer <OutputStream> m_dest;
+  ScopedPointer <Compressor> m_compressor;
+  int64 m_position;
+};
+
+}
+
+#endif
@@ -0,0 +1,417 @@
+/*============================================================================*/
+/*
+  VFLib: https://github.com/vinniefalco/VFLib
+
+  Copyright (C) 2008 by Vinnie Falco <vinnie.falco@gmail.com>
+
+  This library contains portions of other open source products covered by
+  separate licenses. Please see the corresponding source files for specific
+  terms.
+  
+  VFLib is provided under the terms of The MIT License (MIT):
+
+  Permission is hereby granted, free of charge, to any person obtaining a copy
+  of this software and associated documentation files (the "Software"), to deal
+  in the Software without restriction, including without limitation the rights
+  to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+  copies of the Software, and to permit persons to whom the Software is
+  furnished to do so, subject to the following conditions:
+
+  The above copyright notice and this permission notice shall be included in
+  all copies or substantial portions of the Software.
+
+  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+  FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+  IN THE SOFTWARE.
+*/
+/*============================================================================*/
+
+#ifndef VF_DB_CURSOR_VFHEADER
+#define VF_DB_CURSOR_VFHEADER
+
+namespace db {
+
+/** A view of the text in a column of the current row.
+
+    The characters are UTF-8 and are not terminated.
+*/
+struct text_view
+{
+  text_view () : data (0), size (0) { }
+
+  char const* begin () const { return data; }
+  char const* end () const { return data + size; }
+  bool empty () const { return size == 0; }
+
+  char const* data;
+  int size;
+};
+
+/** A view of the bytes in a column of the current row.
+*/
+struct blob_view
+{
+  blob_view () : data (0), size (0) { }
+
+  void const* data;
+  int size;
+};
+
+namespace detail {
+
+// Views point into the statement and are valid until it steps again.
+extern bool get_column (sqlite3_stmt* stmt, int iCol, text_view& value);
+extern bool get_column (sqlite3_stmt* stmt, int iCol, blob_view& value);
+
+}
+
+/*============================================================================*/
+/**
+  A forward-only cursor over the rows of a query.
+
+  A statement with into() bindings copies every column of every row into
+  the bound variables, choosing the conversion with a switch on the column
+  type. A cursor instead leaves the row in SQLite and reads columns on
+  demand. Text and blobs are exposed as views of SQLite's own memory, with
+  no allocation or copy, and typed fetches pick the conversion for each
+  column at compile time:
+
+  @code
+
+  db::cursor c (s);
+
+  Error error = c.prepare ("SELECT id, name, waveform FROM tracks WHERE album = ?");
+
+  c.bind (albumId);
+
+  while (c.next (error))
+  {
+    int id;
+    db::text_view name;
+    db::blob_view waveform;
+
+    c.fetch (id, name, waveform);
+
+    ...
+  }
+
+  @endcode
+
+  Views are valid until the next call to next(), reset() or prepare(), or
+  until the cursor is destroyed. Statements come from the session's
+  statement_cache and go back to it.
+
+  Structs whose fields are declared with row_fields can be bound and
+  fetched whole with bind_row() and fetch_row(), or in bulk with
+  execute_rows() and fetch_rows().
+
+  @ingroup vf_db
+*/
+class cursor : Uncopyable
+{
+public:
+  explicit cursor (session& s);
+  ~cursor ();
+
+  /** Prepare a query, replacing any previous one.
+  */
+  Error prepare (std::string const& query);
+
+  /** Bind the next parameter.
+
+      Parameters are bound in order starting from the first. Text is bound
+      without a copy, so the string must outlive the query.
+  */
+  template <class T>
+  cursor& bind (T const& value)
+  {
+    check_bind (detail::bind_param (m_stmt, ++m_iParam, value));
+    return *this;
+  }
+
+  /** Bind NULL to the next parameter.
+  */
+  cursor& bind_null ();
+
+  /** Step to the next row.
+
+      @return `true` if there is a row, or `false` at the end of the
+              results or on an error.
+  */
+  bool next (Error& error);
+
+  /** Rewind the query so that it can run again.
+
+      When `rebind` is `true` the bindings are cleared, and binding begins
+      again from the first parameter.
+  */
+  void reset (bool rebind = false);
+
+  /** Retrieve the number of columns in the current row.
+  */
+  int get_column_count () const;
+
+  /** Determine if a column of the current row is NULL.
+  */
+  bool is_null (int iCol) const;
+
+  int get_int (int iCol) const;
+  int64 get_int64 (int iCol) const;
+  double get_double (int iCol) const;
+  text_view get_text (int iCol) const;
+  blob_view get_blob (int iCol) const;
+
+  /** Read a column into a variable.
+
+      The conversion is chosen at compile time. User types are converted
+      through type_conversion.
+
+      @return `false` if the column is NULL, in which case a built-in type
+              is left unchanged.
+  */
+  template <class T>
+  bool get (int iCol, T& value) const
+  {
+    return get (iCol, value, typename detail::exchange_traits <T>::type_family ());
+  }
+
+  bool get (int iCol, text_view& value) const
+  {
+    return detail::get_column (m_stmt, iCol, value);
+  }
+
+  bool get (int iCol, blob_view& value) const
+  {
+    return detail::get_column (m_stmt, iCol, value);
+  }
+
+  /** Read the leading columns of the current row.
+
+      Each variable receives the column at its position. Every column is
+      read, even after one that is NULL.
+
+      @return `false` if any of the columns is NULL.
+  */
+  template <class T1>
+  bool fetch (T1& v1) const
+  {
+    return get (0, v1);
+  }
+
+  template <class T1, class T2>
+  bool fetch (T1& v1, T2& v2) const
+  {
+    return get (0, v1) &
+           get (1, v2);
+  }
+
+  template <class T1, class T2, class T3>
+  bool fetch (T1& v1, T2& v2, T3& v3) const
+  {
+    return get (0, v1) &
+           get (1, v2) &
+           get (2, v3);
+  }
+
+  template <class T1, class T2, class T3, class T4>
+  bool fetch (T1& v1, T2& v2, T3& v3, T4& v4) const
+  {
+    return get (0, v1) &
+           get (1, v2) &
+           get (2, v3) &
+           get (3, v4);
+  }
+
+  template <class T1, class T2, class T3, class T4, class T5>
+  bool fetch (T1& v1, T2& v2, T3& v3, T4& v4, T5& v5) const
+  {
+    return get (0, v1) &
+           get (1, v2) &
+           get (2, v3) &
+           get (3, v4) &
+           get (4, v5);
+  }
+
+  template <class T1, class T2, class T3, class T4, class T5, class T6>
+  bool fetch (T1& v1, T2& v2, T3& v3, T4& v4, T5& v5, T6& v6) const
+  {
+    return get (0, v1) &
+           get (1, v2) &
+           get (2, v3) &
+           get (3, v4) &
+           get (4, v5) &
+           get (5, v6);
+  }
+
+  template <class T1, class T2, class T3, class T4, class T5, class T6, class T7>
+  bool fetch (T1& v1, T2& v2, T3& v3, T4& v4, T5& v5, T6& v6, T7& v7) const
+  {
+    return get (0, v1) &
+           get (1, v2) &
+           get (2, v3) &
+           get (3, v4) &
+           get (4, v5) &
+           get (5, v6) &
+           get (6, v7);
+  }
+
+  template <class T1, class T2, class T3, class T4, class T5, class T6, class T7, class T8>
+  bool fetch (T1& v1, T2& v2, T3& v3, T4& v4, T5& v5, T6& v6, T7& v7, T8& v8) const
+  {
+    return get (0, v1) &
+           get (1, v2) &
+           get (2, v3) &
+           get (3, v4) &
+           get (4, v5) &
+           get (5, v6) &
+           get (6, v7) &
+           get (7, v8);
+  }
+
+  /** Bind the fields of a row to the parameters, starting from the first.
+
+      The fields are listed by a row_fields specialization. Binding with
+      bind() continues after the last field. Text is bound without a copy,
+      so the row must outlive the query.
+  */
+  template <class Row>
+  cursor& bind_row (Row const& row)
+  {
+    detail::row_binder binder (m_stmt);
+
+    row_fields <Row>::map (binder, row);
+
+    check_bind (binder.get_result ());
+
+    m_iParam = binder.get_count ();
+
+    return *this;
+  }
+
+  /** Read the fields of a row from the leading columns of the current row.
+
+      The fields are listed by a row_fields specialization. NULL columns
+      are handled as in get().
+
+      @return `false` if any of the columns is NULL.
+  */
+  template <class Row>
+  bool fetch_row (Row& row) const
+  {
+    detail::row_fetcher fetcher (m_stmt);
+
+    row_fields <Row>::map (fetcher, row);
+
+    jassert (fetcher.get_count () <= get_column_count ());
+
+    return !fetcher.got_null ();
+  }
+
+  /** Step through the remaining rows, appending each to a vector.
+
+      @param maxRows The most rows to append, or zero for no limit.
+
+      @return The number of rows appended.
+  */
+  template <class Row>
+  std::size_t fetch_rows (std::vector <Row>& rows, Error& error, std::size_t maxRows = 0)
+  {
+    std::size_t count = 0;
+
+    while ((maxRows == 0 || count < maxRows) && next (error))
+    {
+      rows.push_back (Row ());
+
+      fetch_row (rows.back ());
+
+      ++count;
+    }
+
+    return count;
+  }
+
+  /** Run the query once for each row in a range.
+
+      This is meant for INSERT, UPDATE and DELETE statements, where each
+      row supplies the parameters. Any rows the query returns are skipped.
+      For speed, run it inside a transaction.
+
+      @code
+
+      std::vector <track> tracks;
+
+      ...
+
+      db::transaction tr (s);
+
+      db::cursor c (s);
+
+      Error error = c.prepare ("INSERT INTO tracks VALUES (?, ?, ?, ?)");
+
+      if (!error)
+        error = c.execute_rows (tracks.begin (), tracks.end ());
+
+      if (!error)
+        error = tr.commit ();
+
+      @endcode
+
+      @return The first error, after which the remaining rows are not run.
+  */
+  template <class Iterator>
+  Error execute_rows (Iterator first, Iterator last)
+  {
+    Error error;
+
+    for (; first != last && !error; ++first)
+    {
+      reset ();
+
+      bind_row (*first);
+
+      while (next (error))
+      {
+      }
+    }
+
+    reset ();
+
+    return error;
+  }
+
+private:
+  template <class T>
+  bool get (int iCol, T& value, detail::basic_type_tag) const
+  {
+    return detail::get_column (m_stmt, iCol, value);
+  }
+
+  template <class T>
+  bool get (int iCol, T& value, detail::user_type_tag) const
+  {
+    typename type_conversion <T>::base_type base;
+
+    indicator const ind = detail::get_column (m_stmt, iCol, base) ? i_ok : i_null;
+
+    type_conversion <T>::from_base (base, ind, value);
+
+    return ind == i_ok;
+  }
+
+  void check_bind (int result);
+  void release ();
+
+private:
+  session& m_session;
+  sqlite3_stmt* m_stmt;
+  std::string m_key;
+  int m_iParam;
+};
+
+}
+
+#endif
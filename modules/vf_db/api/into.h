@@ -89,6 +89,20 @@ detail::into_type_ptr into(T& t, indicator& ind)
                          typename detail::exchange_traits<T>::type_family());
 }
 
+// Bulk output. Each fetch fills up to the size of the vector
+// at execute time, and resizes it to the number of rows fetched.
+template <typename T>
+detail::into_type_ptr into (std::vector <T>& v)
+{
+  return detail::do_into (v);
+}
+
+template <typename T>
+detail::into_type_ptr into (std::vector <T>& v, std::vector <indicator>& ind)
+{
+  return detail::do_into (v, ind);
+}
+
 }
 
 #endif
\ No newline at end of file
@@ -0,0 +1,218 @@
+/*============================================================================*/
+/*
+  VFLib: https://github.com/vinniefalco/VFLib
+
+  Copyright (C) 2008 by Vinnie Falco <vinnie.falco@gmail.com>
+
+  This library contains portions of other open source products covered by
+  separate licenses. Please see the corresponding source files for specific
+  terms.
+  
+  VFLib is provided under the terms of The MIT License (MIT):
+
+  Permission is hereby granted, free of charge, to any person obtaining a copy
+  of this software and associated documentation files (the "Software"), to deal
+  in the Software without restriction, including without limitation the rights
+  to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+  copies of the Software, and to permit persons to whom the Software is
+  furnished to do so, subject to the following conditions:
+
+  The above copyright notice and this permission notice shall be included in
+  all copies or substantial portions of the Software.
+
+  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+  FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+  IN THE SOFTWARE.
+*/
+/*============================================================================*/
+
+#ifndef VF_DB_ROW_FIELDS_VFHEADER
+#define VF_DB_ROW_FIELDS_VFHEADER
+
+namespace db {
+
+/*============================================================================*/
+/**
+  Declares the fields of a struct, in column order.
+
+  Specialize this for a struct to read and write whole rows with a cursor.
+  The fields are listed once, and the same list serves for binding
+  parameters and for fetching columns:
+
+  @code
+
+  struct track
+  {
+    int64 id;
+    std::string title;
+    double seconds;
+    Time added;
+  };
+
+  namespace vf { namespace db {
+
+  template <>
+  struct row_fields <track>
+  {
+    template <class Fields, class Row>
+    static void map (Fields& f, Row& row)
+    {
+      f (row.id) (row.title) (row.seconds) (row.added);
+    }
+  };
+
+  } }
+
+  @endcode
+
+  `Row` is `track` when fetching and `track const` when binding. Fields of
+  user types go through their type_conversion.
+
+  The mapping is a template, so cursor::bind_row() and cursor::fetch_row()
+  expand into a direct call to the typed bind or column function for each
+  field. Unlike into() and use(), there is no virtual call or switch on the
+  type for each value.
+
+  @see cursor
+
+  @ingroup vf_db
+*/
+template <class Row>
+struct row_fields;
+
+namespace detail {
+
+// User types are converted to a temporary, so text must be copied.
+template <class T>
+inline int bind_param_copy (sqlite3_stmt* stmt, int iParam, T const& value)
+{
+  return bind_param (stmt, iParam, value);
+}
+
+// Binds each field to the next parameter, starting from the first.
+class row_binder
+{
+public:
+  explicit row_binder (sqlite3_stmt* stmt)
+    : m_stmt (stmt)
+    , m_iParam (0)
+    , m_result (0)
+  {
+  }
+
+  template <class T>
+  row_binder& operator() (T const& value)
+  {
+    bind (value, typename exchange_traits <T>::type_family ());
+    return *this;
+  }
+
+  int get_count () const
+  {
+    return m_iParam;
+  }
+
+  // the first failure, or SQLITE_OK
+  int get_result () const
+  {
+    return m_result;
+  }
+
+private:
+  template <class T>
+  void bind (T const& value, basic_type_tag)
+  {
+    check (bind_param (m_stmt, ++m_iParam, value));
+  }
+
+  template <class T>
+  void bind (T const& value, user_type_tag)
+  {
+    typename type_conversion <T>::base_type base;
+    indicator ind;
+
+    type_conversion <T>::to_base (value, base, ind);
+
+    if (ind != i_null)
+      check (bind_param_copy (m_stmt, ++m_iParam, base));
+    else
+      check (bind_null (m_stmt, ++m_iParam));
+  }
+
+  // SQLITE_OK is zero
+  void check (int result)
+  {
+    if (result != 0 && m_result == 0)
+      m_result = result;
+  }
+
+private:
+  sqlite3_stmt* const m_stmt;
+  int m_iParam;
+  int m_result;
+};
+
+// Reads each field from the next column, starting from the first.
+class row_fetcher
+{
+public:
+  explicit row_fetcher (sqlite3_stmt* stmt)
+    : m_stmt (stmt)
+    , m_iCol (0)
+    , m_bNull (false)
+  {
+  }
+
+  template <class T>
+  row_fetcher& operator() (T& value)
+  {
+    if (!get (m_iCol++, value, typename exchange_traits <T>::type_family ()))
+      m_bNull = true;
+
+    return *this;
+  }
+
+  int get_count () const
+  {
+    return m_iCol;
+  }
+
+  bool got_null () const
+  {
+    return m_bNull;
+  }
+
+private:
+  template <class T>
+  bool get (int iCol, T& value, basic_type_tag)
+  {
+    return get_column (m_stmt, iCol, value);
+  }
+
+  template <class T>
+  bool get (int iCol, T& value, user_type_tag)
+  {
+    typename type_conversion <T>::base_type base;
+
+    indicator const ind = get_column (m_stmt, iCol, base) ? i_ok : i_null;
+
+    type_conversion <T>::from_base (base, ind, value);
+
+    return ind == i_ok;
+  }
+
+private:
+  sqlite3_stmt* const m_stmt;
+  int m_iCol;
+  bool m_bNull;
+};
+
+}
+
+}
+
+#endif
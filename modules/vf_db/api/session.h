@@ -79,15 +79,42 @@ namespace db {
 /**
   @brief A session for the embedded database.
 
+  Statements prepared through the session are kept in its statement_cache
+  after use, so that repeated queries are not compiled again.
+
   @ingroup vf_db
 */
 class session
 {
 public:
+  /** Counters from sqlite3_db_status.
+
+      Memory is in bytes.
+  */
+  struct stats
+  {
+    /** Page cache hits, misses and writes. */
+    int cache_hits;
+    int cache_misses;
+    int cache_writes;
+
+    /** Memory used by the page cache. */
+    int cache_used;
+
+    /** Memory used by the schema. */
+    int schema_used;
+
+    /** Memory used by prepared statements. */
+    int statement_used;
+
+    /** Lookaside slots in use. */
+    int lookaside_used;
+  };
+
   session ();
   ~session ();
 
-  // DEPRECATED!
+  // DEPRECATED! Use session_pool instead.
   // opens the deferred clone
   explicit session (session const& deferredClone);
   Error clone ();
@@ -109,7 +136,23 @@ public:
 
   threads = "single" || "multi"
 
+  page_size          = (number)
+
+  journal_mode       = "delete" || "truncate" || "persist" || "memory" || "wal" || "off"
+
+  cache_size         = (number)
+
+  mmap_size          = (number)
+
+  wal_autocheckpoint = (number)
+
   @endcode
+
+  The last five are applied as pragmas after the database is opened, see
+  the SQLite documentation for their meaning. A negative cache_size is in
+  KiB instead of pages. The page size of an existing database only changes
+  after a VACUUM, and never while it is in WAL mode. Versions of SQLite
+  before 3.7.17 ignore mmap_size.
 */
   Error open (String fileName,
               std::string options = "timeout=infinite|mode=create|threads=multi");
@@ -142,6 +185,34 @@ public:
     return m_connection;
   }
 
+  /** Retrieve the counters for the connection.
+
+      These help to size the page cache from real use. When `reset` is
+      `true` the hit, miss and write counters start again from zero.
+  */
+  stats get_stats (bool reset = false);
+
+  /** Attach a profiler, or detach it by passing nullptr.
+
+      The profiler must outlive its attachment.
+  */
+  void set_profiler (statement_profiler* profiler)
+  {
+    m_profiler = profiler;
+  }
+
+  statement_profiler* get_profiler () const
+  {
+    return m_profiler;
+  }
+
+  /** Retrieve the cache of prepared statements.
+  */
+  statement_cache& get_statement_cache ()
+  {
+    return m_statement_cache;
+  }
+
 private:
   Error hard_exec (std::string const& query);
 
@@ -155,6 +226,8 @@ private:
   bool m_bInTransaction;
   std::ostringstream m_query_stream;
   bool m_bGotData;
+  statement_cache m_statement_cache;
+  statement_profiler* m_profiler;
 };
 
 }
@@ -0,0 +1,205 @@
+/*============================================================================*/
+/*
+  VFLib: https://github.com/vinniefalco/VFLib
+
+  Copyright (C) 2008 by Vinnie Falco <vinnie.falco@gmail.com>
+
+  This library contains portions of other open source products covered by
+  separate licenses. Please see the corresponding source files for specific
+  terms.
+  
+  VFLib is provided under the terms of The MIT License (MIT):
+
+  Permission is hereby granted, free of charge, to any person obtaining a copy
+  of this software and associated documentation files (the "Software"), to deal
+  in the Software without restriction, including without limitation the rights
+  to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+  copies of the Software, and to permit persons to whom the Software is
+  furnished to do so, subject to the following conditions:
+
+  The above copyright notice and this permission notice shall be included in
+  all copies or substantial portions of the Software.
+
+  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+  FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+  IN THE SOFTWARE.
+*/
+/*============================================================================*/
+
+#ifndef VF_DB_SESSION_POOL_VFHEADER
+#define VF_DB_SESSION_POOL_VFHEADER
+
+namespace db {
+
+/*============================================================================*/
+/**
+  A pool of sessions for using one database from many threads.
+
+  The database is put into write-ahead logging mode, which lets readers
+  proceed while a write is in progress. Each reader gets a connection of
+  its own, and all writes go through a single writer connection, so
+  writers never wait on each other's locks inside SQLite.
+
+  Connections are borrowed with a lease, which returns them to the pool
+  when it goes out of scope:
+
+  @code
+
+  db::session_pool pool;
+
+  Error error = pool.open (File ("catalog.db").getFullPathName ());
+
+  // on any thread
+  {
+    db::session_pool::read_lease lease (pool);
+
+    int count;
+    lease->once (error) << "SELECT COUNT(*) FROM tracks", db::into (count);
+  }
+
+  // on any thread
+  {
+    db::session_pool::write_lease lease (pool);
+
+    lease->once (error) << "DELETE FROM tracks WHERE missing = 1";
+  }
+
+  @endcode
+
+  Read connections are opened as they are needed, up to the maximum. When
+  they are all leased, further read leases wait. A thread is given the
+  connection it used last when that one is free, so that its page cache
+  stays warm. Write leases wait for each other.
+
+  @ingroup vf_db
+*/
+class session_pool : Uncopyable
+{
+public:
+  /** Counters for sizing the pool.
+
+      Times are in seconds.
+  */
+  struct stats
+  {
+    /** The number of read connections currently open. */
+    int readers;
+
+    int64 read_leases;
+    int64 read_waits;
+    double read_wait_seconds;
+    double read_wait_max_seconds;
+
+    int64 write_leases;
+    int64 write_waits;
+    double write_wait_seconds;
+    double write_wait_max_seconds;
+  };
+
+  //============================================================================
+  /**
+    Borrows a read connection for the lifetime of the object.
+
+    The connection is opened read only.
+  */
+  class read_lease : Uncopyable
+  {
+  public:
+    explicit read_lease (session_pool& pool);
+    ~read_lease ();
+
+    session& get_session () const noexcept { return *m_session; }
+    session& operator* () const noexcept { return *m_session; }
+    session* operator-> () const noexcept { return m_session; }
+
+  private:
+    session_pool& m_pool;
+    session* m_session;
+  };
+
+  //============================================================================
+  /**
+    Borrows the writer connection for the lifetime of the object.
+
+    Only one write lease exists at a time.
+  */
+  class write_lease : Uncopyable
+  {
+  public:
+    explicit write_lease (session_pool& pool);
+    ~write_lease ();
+
+    session& get_session () const noexcept { return *m_session; }
+    session& operator* () const noexcept { return *m_session; }
+    session* operator-> () const noexcept { return m_session; }
+
+  private:
+    session_pool& m_pool;
+    session* m_session;
+  };
+
+  //============================================================================
+
+  session_pool ();
+  ~session_pool ();
+
+  /** Open the database.
+
+      The writer connection is opened immediately, and the database is
+      switched to write-ahead logging.
+
+      @param fileName    The path to the database.
+      @param max_readers The largest number of read connections.
+      @param shared_cache `true` to have the read connections share one
+                          page cache, which saves memory at the cost of
+                          table level locking between them.
+  */
+  Error open (String fileName, int max_readers = 4, bool shared_cache = false);
+
+  /** Close every connection.
+
+      There must be no outstanding leases.
+  */
+  void close ();
+
+  /** Retrieve the counters.
+  */
+  stats get_stats () const;
+
+private:
+  struct reader
+  {
+    session* s;
+    Thread::ThreadID last_thread;
+  };
+
+  session* acquire_reader ();
+  void release_reader (session* s);
+  session* acquire_writer ();
+  void release_writer ();
+
+  static void record_wait (int64 startTicks, int64& waits, double& total, double& longest);
+
+  String m_fileName;
+  std::string m_readerOptions;
+  int m_maxReaders;
+
+  CriticalSection mutable m_mutex;  // protects everything below
+  OwnedArray <session> m_readers;
+  std::vector <reader> m_idle;
+  stats m_stats;
+
+  Semaphore m_readerSlots;
+  Atomic <int> m_freeReaderSlots;
+
+  CriticalSection m_writeMutex;
+  ScopedPointer <session> m_writer;
+};
+
+}
+
+#endif
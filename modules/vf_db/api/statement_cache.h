@@ -0,0 +1,157 @@
+/*============================================================================*/
+/*
+  VFLib: https://github.com/vinniefalco/VFLib
+
+  Copyright (C) 2008 by Vinnie Falco <vinnie.falco@gmail.com>
+
+  This library contains portions of other open source products covered by
+  separate licenses. Please see the corresponding source files for specific
+  terms.
+  
+  VFLib is provided under the terms of The MIT License (MIT):
+
+  Permission is hereby granted, free of charge, to any person obtaining a copy
+  of this software and associated documentation files (the "Software"), to deal
+  in the Software without restriction, including without limitation the rights
+  to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+  copies of the Software, and to permit persons to whom the Software is
+  furnished to do so, subject to the following conditions:
+
+  The above copyright notice and this permission notice shall be included in
+  all copies or substantial portions of the Software.
+
+  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+  FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+  IN THE SOFTWARE.
+*/
+/*============================================================================*/
+
+#ifndef VF_DB_STATEMENT_CACHE_VFHEADER
+#define VF_DB_STATEMENT_CACHE_VFHEADER
+
+namespace db {
+
+/*============================================================================*/
+/**
+  A cache of prepared statements for a session.
+
+  Preparing a statement parses and plans the SQL, which costs far more than
+  executing a simple query. Each session keeps its most recently used
+  statements prepared, keyed by their SQL with insignificant whitespace
+  removed, so preparing the same query again reuses the compiled statement.
+
+  A cached statement is taken out of the cache while it is in use, so two
+  statements with the same SQL can be active at once. When a statement is
+  released it is reset and its bindings are cleared before it goes back
+  into the cache. The least recently used statements are finalized when
+  the cache is full.
+
+  @ingroup vf_db
+*/
+class statement_cache : Uncopyable
+{
+public:
+  /** The default number of statements kept prepared. */
+  enum
+  {
+    defaultCapacity = 64
+  };
+
+  /** Counters for tuning the capacity.
+  */
+  struct stats
+  {
+    /** The number of prepares satisfied from the cache. */
+    int64 hits;
+
+    /** The number of prepares which compiled the SQL. */
+    int64 misses;
+
+    /** The number of statements finalized to make room. */
+    int64 evictions;
+
+    /** The number of statements currently in the cache. */
+    int size;
+
+    /** The maximum number of statements in the cache. */
+    int capacity;
+  };
+
+  explicit statement_cache (int capacity = defaultCapacity);
+  ~statement_cache ();
+
+  /** Change the number of statements kept prepared.
+
+      Zero disables the cache.
+  */
+  void set_capacity (int capacity);
+
+  /** Retrieve the counters.
+  */
+  stats get_stats () const;
+
+  /** Reset the counters to zero.
+  */
+  void reset_stats ();
+
+  /** Finalize every cached statement.
+
+      This must be done before the connection is closed.
+  */
+  void clear ();
+
+  /** Obtain a prepared statement for SQL.
+
+      The statement is prepared if it is not in the cache.
+
+      @param connection The connection to prepare on.
+      @param query      The SQL text.
+      @param key        Receives the cache key, for release().
+      @param stmt       Receives the statement.
+      @return The SQLite result code from preparing the statement.
+  */
+  int acquire (sqlite3* connection,
+               std::string const& query,
+               std::string& key,
+               sqlite3_stmt** stmt);
+
+  /** Return a statement obtained from acquire().
+
+      The statement is reset and kept, or finalized if the cache is
+      disabled.
+  */
+  void release (std::string const& key, sqlite3_stmt* stmt);
+
+  /** Produce the cache key for SQL.
+
+      Runs of whitespace outside of quotes and comments become a single
+      space, and leading and trailing whitespace is removed. Comments are
+      kept as written, including the newline which ends a -- comment.
+  */
+  static std::string normalize (std::string const& query);
+
+private:
+  struct entry
+  {
+    std::string key;
+    sqlite3_stmt* stmt;
+  };
+
+  typedef std::list <entry> list_t;
+  typedef std::map <std::string, list_t::iterator> index_t;
+
+  void evict_to (int size);
+
+  int m_capacity;
+  list_t m_list;   // most recently used at the front
+  index_t m_index;
+  stats m_stats;
+};
+
+}
+
+#endif
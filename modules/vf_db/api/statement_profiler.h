@@ -0,0 +1,187 @@
+/*============================================================================*/
+/*
+  VFLib: https://github.com/vinniefalco/VFLib
+
+  Copyright (C) 2008 by Vinnie Falco <vinnie.falco@gmail.com>
+
+  This library contains portions of other open source products covered by
+  separate licenses. Please see the corresponding source files for specific
+  terms.
+  
+  VFLib is provided under the terms of The MIT License (MIT):
+
+  Permission is hereby granted, free of charge, to any person obtaining a copy
+  of this software and associated documentation files (the "Software"), to deal
+  in the Software without restriction, including without limitation the rights
+  to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+  copies of the Software, and to permit persons to whom the Software is
+  furnished to do so, subject to the following conditions:
+
+  The above copyright notice and this permission notice shall be included in
+  all copies or substantial portions of the Software.
+
+  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+  FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+  IN THE SOFTWARE.
+*/
+/*============================================================================*/
+
+#ifndef VF_DB_STATEMENT_PROFILER_VFHEADER
+#define VF_DB_STATEMENT_PROFILER_VFHEADER
+
+namespace db {
+
+/*============================================================================*/
+/**
+  Measures the statements run by sessions.
+
+  A profiler is attached to one or more sessions with session::set_profiler.
+  For each run of a statement, from execute until the last row is fetched
+  or the statement is released, it records:
+
+  - The time spent preparing, which is small when the statement_cache
+    already holds the statement.
+
+  - The time spent executing and fetching, and the number of steps and rows.
+
+  - The sqlite3_stmt_status counters for full table scan steps, sorts and
+    automatic indexes, which point at missing indexes.
+
+  Runs are added up by their SQL with insignificant whitespace removed,
+  so the report has one line per distinct query:
+
+  @code
+
+  db::statement_profiler profiler;
+  profiler.set_slow_threshold (0.05);
+
+  s.set_profiler (&profiler);
+
+  ...
+
+  Logger::outputDebugString (profiler.to_string ());
+
+  @endcode
+
+  A run which takes at least the slow threshold is logged with the query
+  plan from EXPLAIN QUERY PLAN. Override on_slow_query() to send it
+  elsewhere.
+
+  One profiler may be shared by sessions on different threads. Sessions
+  without a profiler pay only for a null pointer check.
+
+  @ingroup vf_db
+*/
+class statement_profiler : Uncopyable
+{
+public:
+  /** The measurements of a single run.
+
+      Times are in seconds.
+  */
+  struct run
+  {
+    double execute_seconds;
+    int64 steps;
+    int64 rows;
+    int fullscan_steps;
+    int sorts;
+    int autoindexes;
+  };
+
+  /** The totals for one query.
+
+      Times are in seconds.
+  */
+  struct report
+  {
+    report ();
+
+    /** The normalized SQL. */
+    std::string query;
+
+    int64 prepares;
+    double prepare_seconds;
+
+    int64 executions;
+    double execute_seconds;
+    double max_execute_seconds;
+    int64 steps;
+    int64 rows;
+    int64 fullscan_steps;
+    int64 sorts;
+    int64 autoindexes;
+
+    /** The number of runs at or over the slow threshold. */
+    int64 slow;
+  };
+
+  statement_profiler ();
+  virtual ~statement_profiler ();
+
+  /** Set the time from which a run is reported as slow.
+
+      Zero or less turns the reporting off. The default is 100 milliseconds.
+  */
+  void set_slow_threshold (double seconds);
+
+  /** Retrieve the totals for every query.
+
+      Queries are sorted by their total execution time, from most to least.
+
+      @param result The vector to fill. Previous contents are discarded.
+  */
+  void get_report (std::vector <report>& result) const;
+
+  /** Format the report as text, one line per query.
+  */
+  String to_string () const;
+
+  /** Discard everything recorded.
+  */
+  void reset ();
+
+  /** Record a prepare. Called by the library.
+  */
+  void add_prepare (std::string const& query, double seconds);
+
+  /** Record a run. Called by the library.
+
+      @param s    The session which ran the statement.
+      @param stmt The statement, still prepared.
+  */
+  void add_run (session& s, sqlite3_stmt* stmt, run const& r);
+
+  /** Produce the plan for a query with EXPLAIN QUERY PLAN.
+
+      @return One line for each step of the plan.
+  */
+  static std::string explain (session& s, std::string const& query);
+
+protected:
+  /** Called when a run takes at least the slow threshold.
+
+      The default writes the query and its plan to the debug output.
+  */
+  virtual void on_slow_query (std::string const& query,
+                              double seconds,
+                              std::string const& plan);
+
+private:
+  report& get_entry (std::string const& query);
+  static bool takes_longer (report const& lhs, report const& rhs);
+
+  typedef std::map <std::string, report> entries_t;
+
+  CriticalSection mutable m_mutex;
+  entries_t m_entries;
+  double m_slowThreshold;
+};
+
+}
+
+#endif
@@ -101,6 +101,26 @@ detail::use_type_ptr use(T& t, indicator& ind)
                         typename detail::exchange_traits<T>::type_family());
 }
 
+// Bulk input. The statement is executed once for each element, inside
+// a transaction unless the session is already in one.
+template <typename T>
+detail::use_type_ptr use (std::vector <T>& v)
+{
+  return detail::do_use (static_cast <std::vector <T> const&> (v));
+}
+
+template <typename T>
+detail::use_type_ptr use (std::vector <T> const& v)
+{
+  return detail::do_use (v);
+}
+
+template <typename T>
+detail::use_type_ptr use (std::vector <T> const& v, std::vector <indicator> const& ind)
+{
+  return detail::do_use (v, ind);
+}
+
 }
 
 #endif
\ No newline at end of file
@@ -0,0 +1,89 @@
+/*============================================================================*/
+/*
+  VFLib: https://github.com/vinniefalco/VFLib
+
+  Copyright (C) 2008 by Vinnie Falco <vinnie.falco@gmail.com>
+
+  This library contains portions of other open source products covered by
+  separate licenses. Please see the corresponding source files for specific
+  terms.
+  
+  VFLib is provided under the terms of The MIT License (MIT):
+
+  Permission is hereby granted, free of charge, to any person obtaining a copy
+  of this software and associated documentation files (the "Software"), to deal
+  in the Software without restriction, including without limitation the rights
+  to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+  copies of the Software, and to permit persons to whom the Software is
+  furnished to do so, subject to the following conditions:
+
+  The above copyright notice and this permission notice shall be included in
+  all copies or substantial portions of the Software.
+
+  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+  FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+  IN THE SOFTWARE.
+*/
+/*============================================================================*/
+
+#ifndef VF_DB_DETAIL_COLUMN_ACCESS_VFHEADER
+#define VF_DB_DETAIL_COLUMN_ACCESS_VFHEADER
+
+namespace db {
+
+namespace detail {
+
+// Typed access to result columns and parameters. The overload
+// is chosen at compile time, so there is no switch on the type.
+
+// Each get_column returns false if the column is NULL,
+// leaving the value unchanged.
+extern bool get_column (sqlite3_stmt* stmt, int iCol, bool& value);
+extern bool get_column (sqlite3_stmt* stmt, int iCol, char& value);
+extern bool get_column (sqlite3_stmt* stmt, int iCol, short& value);
+extern bool get_column (sqlite3_stmt* stmt, int iCol, int& value);
+extern bool get_column (sqlite3_stmt* stmt, int iCol, long& value);
+extern bool get_column (sqlite3_stmt* stmt, int iCol, int64& value);
+extern bool get_column (sqlite3_stmt* stmt, int iCol, unsigned char& value);
+extern bool get_column (sqlite3_stmt* stmt, int iCol, unsigned short& value);
+extern bool get_column (sqlite3_stmt* stmt, int iCol, unsigned int& value);
+extern bool get_column (sqlite3_stmt* stmt, int iCol, unsigned long& value);
+extern bool get_column (sqlite3_stmt* stmt, int iCol, uint64& value);
+extern bool get_column (sqlite3_stmt* stmt, int iCol, float& value);
+extern bool get_column (sqlite3_stmt* stmt, int iCol, double& value);
+extern bool get_column (sqlite3_stmt* stmt, int iCol, std::string& value);
+extern bool get_column (sqlite3_stmt* stmt, int iCol, String& value);
+
+// Each bind_param returns the SQLite result code. Text
+// is bound without a copy, and must outlive the step.
+extern int bind_param (sqlite3_stmt* stmt, int iParam, bool value);
+extern int bind_param (sqlite3_stmt* stmt, int iParam, char value);
+extern int bind_param (sqlite3_stmt* stmt, int iParam, short value);
+extern int bind_param (sqlite3_stmt* stmt, int iParam, int value);
+extern int bind_param (sqlite3_stmt* stmt, int iParam, long value);
+extern int bind_param (sqlite3_stmt* stmt, int iParam, int64 value);
+extern int bind_param (sqlite3_stmt* stmt, int iParam, unsigned char value);
+extern int bind_param (sqlite3_stmt* stmt, int iParam, unsigned short value);
+extern int bind_param (sqlite3_stmt* stmt, int iParam, unsigned int value);
+extern int bind_param (sqlite3_stmt* stmt, int iParam, unsigned long value);
+extern int bind_param (sqlite3_stmt* stmt, int iParam, uint64 value);
+extern int bind_param (sqlite3_stmt* stmt, int iParam, float value);
+extern int bind_param (sqlite3_stmt* stmt, int iParam, double value);
+extern int bind_param (sqlite3_stmt* stmt, int iParam, std::string const& value);
+extern int bind_param (sqlite3_stmt* stmt, int iParam, String const& value);
+extern int bind_null (sqlite3_stmt* stmt, int iParam);
+
+// As bind_param, but text is copied so that the value
+// may be destroyed before the step.
+extern int bind_param_copy (sqlite3_stmt* stmt, int iParam, std::string const& value);
+extern int bind_param_copy (sqlite3_stmt* stmt, int iParam, String const& value);
+
+}
+
+}
+
+#endif
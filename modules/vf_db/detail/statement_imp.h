@@ -105,14 +105,32 @@ public:
   void release_resources ();
   rowid last_insert_rowid ();
 
+  bool has_vector_uses (std::size_t& rows);
+  std::size_t get_vector_into_size ();
+  Error do_vector_uses (std::size_t rows);
+  bool fetch_row (Error& error);
+  bool fetch_rows (Error& error);
+
+  int step ();
+  void begin_run ();
+  void end_run ();
+
 public:
   session& m_session;
   sqlite3_stmt* m_stmt;
   std::string m_query;
+  std::string m_cache_key;
   bool m_bReady;
   bool m_bGotData;
   bool m_bFirstTime;
   rowid m_last_insert_rowid;
+  std::size_t m_fetch_size; // rows per fetch for vector intos, else 0
+
+  // the run being profiled, if any
+  bool m_bProfiling;
+  int64 m_executeTicks;
+  int64 m_steps;
+  int64 m_rows;
 
   typedef std::vector <detail::into_type_base*> intos_t;
   typedef std::vector <detail::use_type_base*> uses_t;
@@ -0,0 +1,133 @@
+/*============================================================================*/
+/*
+  VFLib: https://github.com/vinniefalco/VFLib
+
+  Copyright (C) 2008 by Vinnie Falco <vinnie.falco@gmail.com>
+
+  This library contains portions of other open source products covered by
+  separate licenses. Please see the corresponding source files for specific
+  terms.
+  
+  VFLib is provided under the terms of The MIT License (MIT):
+
+  Permission is hereby granted, free of charge, to any person obtaining a copy
+  of this software and associated documentation files (the "Software"), to deal
+  in the Software without restriction, including without limitation the rights
+  to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+  copies of the Software, and to permit persons to whom the Software is
+  furnished to do so, subject to the following conditions:
+
+  The above copyright notice and this permission notice shall be included in
+  all copies or substantial portions of the Software.
+
+  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+  FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+  IN THE SOFTWARE.
+*/
+/*============================================================================*/
+
+#ifndef VF_DB_DETAIL_VECTOR_INTO_TYPE_VFHEADER
+#define VF_DB_DETAIL_VECTOR_INTO_TYPE_VFHEADER
+
+namespace db {
+
+namespace detail {
+
+// base class for output data filling many rows per fetch
+class vector_into_type_base : public into_type_base
+{
+public:
+  vector_into_type_base () : m_stmt (0), m_iCol (0) {}
+  virtual void bind (statement_imp& st, int& iCol);
+  virtual void do_into ();
+
+  virtual std::size_t size () const = 0;
+  virtual void resize (std::size_t rows) = 0;
+  virtual void do_into (std::size_t row) = 0;
+
+protected:
+  sqlite3_stmt* m_stmt;
+  int m_iCol;
+};
+
+// columnar output into a std::vector
+template <typename T>
+class vector_into_type : public vector_into_type_base
+{
+public:
+  typedef typename type_conversion <T>::base_type base_type;
+  typedef typename exchange_traits <T>::type_family type_family;
+
+  explicit vector_into_type (std::vector <T>& v)
+    : m_vec (v), m_ind (0) {}
+
+  vector_into_type (std::vector <T>& v, std::vector <indicator>& ind)
+    : m_vec (v), m_ind (&ind) {}
+
+  std::size_t size () const
+  {
+    return m_vec.size ();
+  }
+
+  void resize (std::size_t rows)
+  {
+    m_vec.resize (rows);
+
+    if (m_ind != 0)
+      m_ind->resize (rows);
+  }
+
+  void do_into (std::size_t row)
+  {
+    do_into (row, type_family ());
+  }
+
+private:
+  // built-in types are read directly into the vector
+  void do_into (std::size_t row, basic_type_tag)
+  {
+    bool const gotValue = get_column (m_stmt, m_iCol, m_vec [row]);
+
+    if (m_ind != 0)
+      (*m_ind) [row] = gotValue ? i_ok : i_null;
+    else if (!gotValue)
+      Throw (Error().fail (__FILE__, __LINE__)); // null encountered with no indicator
+  }
+
+  // user types are converted from their base type
+  void do_into (std::size_t row, user_type_tag)
+  {
+    indicator const ind = get_column (m_stmt, m_iCol, m_base) ? i_ok : i_null;
+
+    if (m_ind != 0)
+      (*m_ind) [row] = ind;
+
+    type_conversion <T>::from_base (m_base, ind, m_vec [row]);
+  }
+
+  std::vector <T>& m_vec;
+  std::vector <indicator>* m_ind;
+  base_type m_base;
+};
+
+template <typename T>
+into_type_ptr do_into (std::vector <T>& v)
+{
+  return into_type_ptr (new vector_into_type <T> (v));
+}
+
+template <typename T>
+into_type_ptr do_into (std::vector <T>& v, std::vector <indicator>& ind)
+{
+  return into_type_ptr (new vector_into_type <T> (v, ind));
+}
+
+}
+
+}
+
+#endif
@@ -0,0 +1,129 @@
+/*============================================================================*/
+/*
+  VFLib: https://github.com/vinniefalco/VFLib
+
+  Copyright (C) 2008 by Vinnie Falco <vinnie.falco@gmail.com>
+
+  This library contains portions of other open source products covered by
+  separate licenses. Please see the corresponding source files for specific
+  terms.
+  
+  VFLib is provided under the terms of The MIT License (MIT):
+
+  Permission is hereby granted, free of charge, to any person obtaining a copy
+  of this software and associated documentation files (the "Software"), to deal
+  in the Software without restriction, including without limitation the rights
+  to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+  copies of the Software, and to permit persons to whom the Software is
+  furnished to do so, subject to the following conditions:
+
+  The above copyright notice and this permission notice shall be included in
+  all copies or substantial portions of the Software.
+
+  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+  FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+  IN THE SOFTWARE.
+*/
+/*============================================================================*/
+
+#ifndef VF_DB_DETAIL_VECTOR_USE_TYPE_VFHEADER
+#define VF_DB_DETAIL_VECTOR_USE_TYPE_VFHEADER
+
+namespace db {
+
+namespace detail {
+
+// base class for input data executing once per row
+class vector_use_type_base : public use_type_base
+{
+public:
+  vector_use_type_base () : m_stmt (0), m_iParam (0) {}
+  virtual void bind (statement_imp& st, int& iParam);
+  virtual void do_use ();
+  virtual void post_use () {}
+  virtual void clean_up () {}
+
+  virtual std::size_t size () const = 0;
+  virtual void do_use (std::size_t row) = 0;
+
+protected:
+  void check (int result);
+
+  sqlite3_stmt* m_stmt;
+  int m_iParam;
+};
+
+// columnar input from a std::vector
+template <typename T>
+class vector_use_type : public vector_use_type_base
+{
+public:
+  typedef typename type_conversion <T>::base_type base_type;
+  typedef typename exchange_traits <T>::type_family type_family;
+
+  explicit vector_use_type (std::vector <T> const& v)
+    : m_vec (v), m_ind (0) {}
+
+  vector_use_type (std::vector <T> const& v, std::vector <indicator> const& ind)
+    : m_vec (v), m_ind (&ind) {}
+
+  std::size_t size () const
+  {
+    return m_vec.size ();
+  }
+
+  void do_use (std::size_t row)
+  {
+    if (m_ind != 0 && (*m_ind) [row] == i_null)
+      check (bind_null (m_stmt, m_iParam));
+    else
+      do_use (row, type_family ());
+  }
+
+private:
+  // built-in types are bound directly from the vector
+  void do_use (std::size_t row, basic_type_tag)
+  {
+    check (bind_param (m_stmt, m_iParam, m_vec [row]));
+  }
+
+  // user types are converted to their base type, which
+  // stays alive until the next row is bound
+  void do_use (std::size_t row, user_type_tag)
+  {
+    indicator ind;
+
+    type_conversion <T>::to_base (m_vec [row], m_base, ind);
+
+    if (ind == i_null)
+      check (bind_null (m_stmt, m_iParam));
+    else
+      check (bind_param (m_stmt, m_iParam, m_base));
+  }
+
+  std::vector <T> const& m_vec;
+  std::vector <indicator> const* m_ind;
+  base_type m_base;
+};
+
+template <typename T>
+use_type_ptr do_use (std::vector <T> const& v)
+{
+  return use_type_ptr (new vector_use_type <T> (v));
+}
+
+template <typename T>
+use_type_ptr do_use (std::vector <T> const& v, std::vector <indicator> const& ind)
+{
+  return use_type_ptr (new vector_use_type <T> (v, ind));
+}
+
+}
+
+}
+
+#endif
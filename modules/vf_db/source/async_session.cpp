@@ -0,0 +1,312 @@
+/*============================================================================*/
+/*
+  VFLib: https://github.com/vinniefalco/VFLib
+
+  Copyright (C) 2008 by Vinnie Falco <vinnie.falco@gmail.com>
+
+  This library contains portions of other open source products covered by
+  separate licenses. Please see the corresponding source files for specific
+  terms.
+  
+  VFLib is provided under the terms of The MIT License (MIT):
+
+  Permission is hereby granted, free of charge, to any person obtaining a copy
+  of this software and associated documentation files (the "Software"), to deal
+  in the Software without restriction, including without limitation the rights
+  to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+  copies of the Software, and to permit persons to whom the Software is
+  furnished to do so, subject to the following conditions:
+
+  The above copyright notice and this permission notice shall be included in
+  all copies or substantial portions of the Software.
+
+  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+  FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+  IN THE SOFTWARE.
+*/
+/*============================================================================*/
+
+namespace db {
+
+async_session::async_session (String threadName)
+  : m_thread (threadName)
+  , m_commitTimer (m_thread)
+  , m_commitLatency (defaultCommitLatency)
+  , m_batchSize (defaultBatchSize)
+  , m_writesInTransaction (0)
+{
+  zerostruct (m_stats);
+
+  m_thread.start ();
+}
+
+async_session::~async_session ()
+{
+  close ();
+}
+
+Error async_session::open (String fileName, std::string options)
+{
+  Error error;
+
+  // can't open twice
+  if (m_session != nullptr)
+    Throw (error.fail (__FILE__, __LINE__, Error::fileInUse));
+
+  if (options.empty ())
+    options = "timeout=infinite|mode=create|threads=multi";
+
+  WaitableEvent done;
+
+  m_thread.call (&async_session::do_open, this, fileName, options, &error, &done);
+
+  done.wait ();
+
+  return error;
+}
+
+void async_session::close ()
+{
+  if (m_session != nullptr)
+  {
+    WaitableEvent done;
+
+    m_thread.call (&async_session::do_close, this, &done);
+
+    done.wait ();
+  }
+}
+
+void async_session::set_commit_latency (int milliseconds)
+{
+  jassert (milliseconds >= 0);
+
+  m_thread.call (&async_session::set_latency_on_thread, this, milliseconds);
+}
+
+void async_session::set_batch_size (int writes)
+{
+  jassert (writes > 0);
+
+  m_thread.call (&async_session::set_batch_size_on_thread, this, writes);
+}
+
+void async_session::read (query_t const& query)
+{
+  m_thread.call (&async_session::do_read, this, query, (CallQueue*)nullptr, reply_t ());
+}
+
+void async_session::read (query_t const& query, CallQueue& replyQueue, reply_t const& reply)
+{
+  m_thread.call (&async_session::do_read, this, query, &replyQueue, reply);
+}
+
+void async_session::write (query_t const& query)
+{
+  m_thread.call (&async_session::do_write, this, query, (CallQueue*)nullptr, reply_t ());
+}
+
+void async_session::write (query_t const& query, CallQueue& replyQueue, reply_t const& reply)
+{
+  m_thread.call (&async_session::do_write, this, query, &replyQueue, reply);
+}
+
+void async_session::flush ()
+{
+  m_thread.call (&async_session::do_commit, this, false);
+}
+
+async_session::stats async_session::get_stats () const
+{
+  CriticalSection::ScopedLockType lock (m_mutex);
+
+  return m_stats;
+}
+
+//------------------------------------------------------------------------------
+
+void async_session::do_open (String fileName, std::string options, Error* error, WaitableEvent* done)
+{
+  ScopedPointer <session> s (new session);
+
+  *error = s->open (fileName, options);
+
+  if (!*error)
+    m_session = s.release ();
+
+  done->signal ();
+}
+
+void async_session::do_close (WaitableEvent* done)
+{
+  do_commit (false);
+
+  m_commitTimer.stop ();
+
+  m_session = nullptr;
+
+  done->signal ();
+}
+
+// An exception escaping a query would end the database
+// thread, so it becomes the error reported for the query.
+//
+Error async_session::run_query (query_t& query)
+{
+  Error error;
+
+  try
+  {
+    error = query (*m_session);
+  }
+  catch (Error& e)
+  {
+    error = e;
+  }
+  catch (std::exception& e)
+  {
+    error.fail (__FILE__, __LINE__, String (e.what ()), Error::exception);
+  }
+  catch (...)
+  {
+    error.fail (__FILE__, __LINE__, Error::exception);
+  }
+
+  return error;
+}
+
+void async_session::do_read (query_t query, CallQueue* replyQueue, reply_t reply)
+{
+  Error error = run_query (query);
+
+  {
+    CriticalSection::ScopedLockType lock (m_mutex);
+
+    ++m_stats.reads;
+  }
+
+  if (replyQueue != nullptr)
+    replyQueue->call (reply, error);
+  else
+    error.willBeReported ();
+}
+
+void async_session::do_write (query_t query, CallQueue* replyQueue, reply_t reply)
+{
+  if (m_writesInTransaction == 0)
+  {
+    m_session->begin ();
+
+    m_commitTimer.startOneShot (m_commitLatency,
+      vf::bind (&async_session::do_commit, this, false));
+  }
+
+  ++m_writesInTransaction;
+
+  // The savepoint lets a failed write be undone without
+  // losing the other writes in the same transaction.
+  Error error;
+
+  m_session->once (error) << "SAVEPOINT vf_async_write";
+
+  if (!error)
+  {
+    error = run_query (query);
+
+    Error release;
+
+    if (error)
+      m_session->once (release) << "ROLLBACK TO vf_async_write";
+
+    if (!release)
+      m_session->once (release) << "RELEASE vf_async_write";
+
+    if (release && !error)
+      error = release;
+  }
+
+  {
+    CriticalSection::ScopedLockType lock (m_mutex);
+
+    ++m_stats.writes;
+
+    if (error)
+      ++m_stats.failed_writes;
+  }
+
+  pending_reply r;
+  r.queue = replyQueue;
+  r.reply = reply;
+  r.error = error;
+
+  m_replies.push_back (r);
+
+  if (m_writesInTransaction >= m_batchSize)
+    do_commit (true);
+}
+
+void async_session::do_commit (bool full)
+{
+  if (m_writesInTransaction > 0)
+  {
+    m_commitTimer.stop ();
+
+    Error error = m_session->commit ();
+
+    if (error && !sqlite3_get_autocommit (m_session->get_connection ()))
+    {
+      // the transaction is still open when the commit fails
+      Error rollback;
+      m_session->once (rollback) << "ROLLBACK";
+      rollback.willBeReported ();
+    }
+
+    m_writesInTransaction = 0;
+
+    {
+      CriticalSection::ScopedLockType lock (m_mutex);
+
+      ++m_stats.transactions;
+
+      if (full)
+        ++m_stats.full_transactions;
+    }
+
+    for (std::size_t i = 0; i < m_replies.size (); ++i)
+    {
+      pending_reply& r = m_replies [i];
+
+      // nothing was committed, so every write failed
+      if (error && !r.error)
+        r.error = error;
+
+      if (r.queue != nullptr)
+        r.queue->call (r.reply, r.error);
+      else
+        r.error.willBeReported ();
+    }
+
+    m_replies.clear ();
+
+    error.willBeReported ();
+  }
+}
+
+void async_session::set_latency_on_thread (int milliseconds)
+{
+  m_commitLatency = milliseconds;
+}
+
+void async_session::set_batch_size_on_thread (int writes)
+{
+  m_batchSize = writes;
+
+  if (m_writesInTransaction >= m_batchSize)
+    do_commit (true);
+}
+
+}
@@ -103,6 +103,14 @@ Error blob::select (session& s,
   return detail::sqliteError (__FILE__, __LINE__, result);
 }
 
+Error blob::reopen (rowid id)
+{
+  jassert (m_blob != 0);
+
+  return detail::sqliteError (__FILE__, __LINE__,
+    sqlite3_blob_reopen (m_blob, id));
+}
+
 std::size_t blob::get_len()
 {
   return sqlite3_blob_bytes (m_blob);
@@ -0,0 +1,251 @@
+/*============================================================================*/
+/*
+  VFLib: https://github.com/vinniefalco/VFLib
+
+  Copyright (C) 2008 by Vinnie Falco <vinnie.falco@gmail.com>
+
+  This library contains portions of other open source products covered by
+  separate licenses. Please see the corresponding source files for specific
+  terms.
+  
+  VFLib is provided under the terms of The MIT License (MIT):
+
+  Permission is hereby granted, free of charge, to any person obtaining a copy
+  of this software and associated documentation files (the "Software"), to deal
+  in the Software without restriction, including without limitation the rights
+  to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+  copies of the Software, and to permit persons to whom the Software is
+  furnished to do so, subject to the following conditions:
+
+  The above copyright notice and this permission notice shall be included in
+  all copies or substantial portions of the Software.
+
+  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+  FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+  IN THE SOFTWARE.
+*/
+/*============================================================================*/
+
+namespace db {
+
+blob_input_stream::blob_input_stream (blob& source, int bufferSize)
+  : m_blob (source)
+  , m_buffer (jmax (bufferSize, 1))
+  , m_bufferSize (jmax (bufferSize, 1))
+  , m_bufferStart (0)
+  , m_bufferBytes (0)
+  , m_position (0)
+  , m_length (int64 (source.get_len ()))
+{
+}
+
+blob_input_stream::~blob_input_stream ()
+{
+}
+
+Error blob_input_stream::reopen (rowid id)
+{
+  Error error = m_blob.reopen (id);
+
+  m_bufferStart = 0;
+  m_bufferBytes = 0;
+  m_position = 0;
+  m_length = error ? 0 : int64 (m_blob.get_len ());
+
+  return error;
+}
+
+int64 blob_input_stream::getTotalLength ()
+{
+  return m_length;
+}
+
+bool blob_input_stream::isExhausted ()
+{
+  return m_position >= m_length;
+}
+
+int blob_input_stream::read (void* destBuffer, int maxBytesToRead)
+{
+  char* dest = static_cast <char*> (destBuffer);
+  int bytesRead = 0;
+
+  while (bytesRead < maxBytesToRead && m_position < m_length)
+  {
+    int const wanted = int (jmin (int64 (maxBytesToRead - bytesRead), m_length - m_position));
+
+    if (m_position >= m_bufferStart && m_position < m_bufferStart + m_bufferBytes)
+    {
+      int const offset = int (m_position - m_bufferStart);
+      int const bytes = jmin (wanted, m_bufferBytes - offset);
+
+      memcpy (dest + bytesRead, m_buffer + offset, bytes);
+
+      bytesRead += bytes;
+      m_position += bytes;
+    }
+    else if (wanted >= m_bufferSize)
+    {
+      // too big to be worth buffering
+      if (!read_blob (m_position, dest + bytesRead, wanted))
+        break;
+
+      bytesRead += wanted;
+      m_position += wanted;
+    }
+    else
+    {
+      int const bytes = int (jmin (int64 (m_bufferSize), m_length - m_position));
+
+      m_bufferStart = m_position;
+      m_bufferBytes = 0;
+
+      if (!read_blob (m_position, m_buffer, bytes))
+        break;
+
+      m_bufferBytes = bytes;
+    }
+  }
+
+  return bytesRead;
+}
+
+int64 blob_input_stream::getPosition ()
+{
+  return m_position;
+}
+
+bool blob_input_stream::setPosition (int64 newPosition)
+{
+  m_position = jlimit (int64 (0), m_length, newPosition);
+
+  return true;
+}
+
+bool blob_input_stream::read_blob (int64 offset, void* dest, int bytes)
+{
+  Error error = m_blob.read (std::size_t (offset), dest, std::size_t (bytes));
+
+  if (error)
+  {
+    // the row changed underneath us
+    m_length = m_position;
+    m_bufferBytes = 0;
+  }
+
+  return !error;
+}
+
+//------------------------------------------------------------------------------
+
+blob_output_stream::blob_output_stream (blob& dest, int bufferSize)
+  : m_blob (dest)
+  , m_buffer (jmax (bufferSize, 1))
+  , m_bufferSize (jmax (bufferSize, 1))
+  , m_bufferBytes (0)
+  , m_position (0)
+  , m_length (int64 (dest.get_len ()))
+{
+}
+
+blob_output_stream::~blob_output_stream ()
+{
+  write_buffer ();
+}
+
+Error blob_output_stream::reopen (rowid id)
+{
+  Error error;
+
+  if (!write_buffer ())
+    error.fail (__FILE__, __LINE__, Error::fileIOError);
+
+  if (!error)
+    error = m_blob.reopen (id);
+
+  m_position = 0;
+  m_length = error ? 0 : int64 (m_blob.get_len ());
+
+  return error;
+}
+
+void blob_output_stream::flush ()
+{
+  write_buffer ();
+}
+
+bool blob_output_stream::setPosition (int64 newPosition)
+{
+  if (!write_buffer ())
+    return false;
+
+  if (newPosition < 0 || newPosition > m_length)
+    return false;
+
+  m_position = newPosition;
+
+  return true;
+}
+
+int64 blob_output_stream::getPosition ()
+{
+  return m_position + m_bufferBytes;
+}
+
+bool blob_output_stream::write (const void* dataToWrite, size_t numberOfBytes)
+{
+  int64 const end = getPosition () + int64 (numberOfBytes);
+
+  // a blob can't grow
+  if (end > m_length)
+    return false;
+
+  if (m_bufferBytes + numberOfBytes > size_t (m_bufferSize))
+  {
+    if (!write_buffer ())
+      return false;
+  }
+
+  if (numberOfBytes >= size_t (m_bufferSize))
+  {
+    Error error = m_blob.write (std::size_t (m_position), dataToWrite, numberOfBytes);
+
+    if (error)
+      return false;
+
+    m_position += int64 (numberOfBytes);
+  }
+  else
+  {
+    memcpy (m_buffer + m_bufferBytes, dataToWrite, numberOfBytes);
+
+    m_bufferBytes += int (numberOfBytes);
+  }
+
+  return true;
+}
+
+bool blob_output_stream::write_buffer ()
+{
+  bool success = true;
+
+  if (m_bufferBytes > 0)
+  {
+    Error error = m_blob.write (std::size_t (m_position), m_buffer, std::size_t (m_bufferBytes));
+
+    if (!error)
+      m_position += m_bufferBytes;
+
+    m_bufferBytes = 0;
+
+    success = !error;
+  }
+
+  return success;
+}
+
+}
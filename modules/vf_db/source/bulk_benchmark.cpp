@@ -0,0 +1,267 @@
+/*============================================================================*/
+/*
+  VFLib: https://github.com/vinniefalco/VFLib
+
+  Copyright (C) 2008 by Vinnie Falco <vinnie.falco@gmail.com>
+
+  This library contains portions of other open source products covered by
+  separate licenses. Please see the corresponding source files for specific
+  terms.
+  
+  VFLib is provided under the terms of The MIT License (MIT):
+
+  Permission is hereby granted, free of charge, to any person obtaining a copy
+  of this software and associated documentation files (the "Software"), to deal
+  in the Software without restriction, including without limitation the rights
+  to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+  copies of the Software, and to permit persons to whom the Software is
+  furnished to do so, subject to the following conditions:
+
+  The above copyright notice and this permission notice shall be included in
+  all copies or substantial portions of the Software.
+
+  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+  FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+  IN THE SOFTWARE.
+*/
+/*============================================================================*/
+
+namespace db {
+
+// Creates the table and the column data in a temporary database.
+class bulk_benchmark::table_case : public Benchmark::Case
+{
+public:
+  explicit table_case (String name)
+    : m_name (name)
+  {
+  }
+
+  String getName () const
+  {
+    return m_name;
+  }
+
+  bool isConcurrent () const
+  {
+    return false;
+  }
+
+  void prepare (Benchmark::Parameters const& parameters)
+  {
+    int const rows = parameters.payloadBytes;
+
+    m_ids.resize (rows);
+    m_names.resize (rows);
+    m_values.resize (rows);
+
+    for (int i = 0; i < rows; ++i)
+    {
+      m_ids [i] = i;
+      m_names [i] = String ("row " + String (i)).toUTF8 ();
+      m_values [i] = i * 0.5;
+    }
+
+    m_file = File::getSpecialLocation (File::tempDirectory)
+      .getNonexistentChildFile ("vf_db_benchmark", ".db", false);
+
+    check (m_session.open (m_file.getFullPathName ()));
+
+    Error error;
+    m_session.once (error) << "CREATE TABLE t (id INTEGER, name TEXT, value REAL)";
+    check (error);
+  }
+
+  void finish ()
+  {
+    m_session.close ();
+    m_file.deleteFile ();
+
+    m_ids.clear ();
+    m_names.clear ();
+    m_values.clear ();
+  }
+
+protected:
+  static void check (Error const& error)
+  {
+    if (error)
+      Throw (error);
+  }
+
+  // Each insert measurement starts from an empty table.
+  void empty_table ()
+  {
+    Error error;
+    m_session.once (error) << "DELETE FROM t";
+    check (error);
+  }
+
+  void fill_table ()
+  {
+    Error error;
+    m_session.once (error) << "INSERT INTO t VALUES (?, ?, ?)",
+      use (m_ids), use (m_names), use (m_values);
+    check (error);
+  }
+
+  String const m_name;
+  File m_file;
+  session m_session;
+  std::vector <int> m_ids;
+  std::vector <std::string> m_names;
+  std::vector <double> m_values;
+};
+
+//------------------------------------------------------------------------------
+
+class bulk_benchmark::insert_case : public table_case
+{
+public:
+  insert_case () : table_case ("db insert row by row")
+  {
+  }
+
+  void operation (int)
+  {
+    empty_table ();
+
+    int id;
+    std::string name;
+    double value;
+
+    statement st = (m_session.prepare << "INSERT INTO t VALUES (?, ?, ?)",
+      use (id), use (name), use (value));
+
+    transaction tr (m_session);
+
+    for (std::size_t i = 0; i < m_ids.size (); ++i)
+    {
+      id = m_ids [i];
+      name = m_names [i];
+      value = m_values [i];
+
+      Error error;
+      st.execute_and_fetch (error);
+      check (error);
+    }
+
+    check (tr.commit ());
+  }
+};
+
+//------------------------------------------------------------------------------
+
+class bulk_benchmark::insert_bulk_case : public table_case
+{
+public:
+  insert_bulk_case () : table_case ("db insert bulk")
+  {
+  }
+
+  void operation (int)
+  {
+    empty_table ();
+
+    fill_table ();
+  }
+};
+
+//------------------------------------------------------------------------------
+
+class bulk_benchmark::scan_case : public table_case
+{
+public:
+  scan_case () : table_case ("db scan row by row")
+  {
+  }
+
+  void prepare (Benchmark::Parameters const& parameters)
+  {
+    table_case::prepare (parameters);
+
+    fill_table ();
+  }
+
+  void operation (int)
+  {
+    int id;
+    std::string name;
+    double value;
+
+    statement st = (m_session.prepare << "SELECT id, name, value FROM t",
+      into (id), into (name), into (value));
+
+    Error error;
+    int64 sum = 0;
+
+    for (bool more = st.execute_and_fetch (error); more; more = st.fetch (error))
+      sum += id;
+
+    check (error);
+
+    jassert (sum == int64 (m_ids.size ()) * (int64 (m_ids.size ()) - 1) / 2);
+  }
+};
+
+//------------------------------------------------------------------------------
+
+class bulk_benchmark::scan_bulk_case : public table_case
+{
+public:
+  scan_bulk_case () : table_case ("db scan bulk")
+  {
+  }
+
+  void prepare (Benchmark::Parameters const& parameters)
+  {
+    table_case::prepare (parameters);
+
+    fill_table ();
+  }
+
+  void operation (int)
+  {
+    std::vector <int> ids (rowsPerFetch);
+    std::vector <std::string> names (rowsPerFetch);
+    std::vector <double> values (rowsPerFetch);
+
+    statement st = (m_session.prepare << "SELECT id, name, value FROM t",
+      into (ids), into (names), into (values));
+
+    Error error;
+    int64 sum = 0;
+
+    for (bool more = st.execute_and_fetch (error); more; more = st.fetch (error))
+    {
+      for (std::size_t i = 0; i < ids.size (); ++i)
+        sum += ids [i];
+    }
+
+    check (error);
+
+    jassert (sum == int64 (m_ids.size ()) * (int64 (m_ids.size ()) - 1) / 2);
+  }
+
+private:
+  enum
+  {
+    rowsPerFetch = 1024
+  };
+};
+
+//------------------------------------------------------------------------------
+
+void bulk_benchmark::add_all_cases (Benchmark& benchmark)
+{
+  benchmark.add (new insert_case);
+  benchmark.add (new insert_bulk_case);
+  benchmark.add (new scan_case);
+  benchmark.add (new scan_bulk_case);
+}
+
+}
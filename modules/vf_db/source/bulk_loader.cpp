@@ -0,0 +1,389 @@
+/*============================================================================*/
+/*
+  VFLib: https://github.com/vinniefalco/VFLib
+
+  Copyright (C) 2008 by Vinnie Falco <vinnie.falco@gmail.com>
+
+  This library contains portions of other open source products covered by
+  separate licenses. Please see the corresponding source files for specific
+  terms.
+  
+  VFLib is provided under the terms of The MIT License (MIT):
+
+  Permission is hereby granted, free of charge, to any person obtaining a copy
+  of this software and associated documentation files (the "Software"), to deal
+  in the Software without restriction, including without limitation the rights
+  to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+  copies of the Software, and to permit persons to whom the Software is
+  furnished to do so, subject to the following conditions:
+
+  The above copyright notice and this permission notice shall be included in
+  all copies or substantial portions of the Software.
+
+  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+  FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+  IN THE SOFTWARE.
+*/
+/*============================================================================*/
+
+namespace db {
+
+namespace {
+
+std::string pragma_value (int64 value)
+{
+  std::ostringstream ss;
+  ss << value;
+  return ss.str ();
+}
+
+}
+
+bulk_loader::options::options ()
+  : journal_mode ("OFF")
+  , synchronous ("OFF")
+  , cache_size (-262144)
+  , mmap_size (268435456)
+  , temp_store ("MEMORY")
+  , batch_size (100000)
+  , drop_indexes (true)
+{
+}
+
+bulk_loader::bulk_loader (session& s, options const& opts)
+  : m_session (s)
+  , m_options (opts)
+  , m_loading (false)
+  , m_startTicks (0)
+  , m_totalChanges (0)
+  , m_rowsInTransaction (0)
+{
+  zerostruct (m_stats);
+}
+
+bulk_loader::~bulk_loader ()
+{
+  if (m_loading)
+  {
+    Error error = finish ();
+
+    error.willBeReported ();
+  }
+}
+
+Error bulk_loader::begin (std::string const& table)
+{
+  Error error;
+
+  jassert (!m_loading);
+
+  // the journal mode can't change inside a transaction
+  jassert (!m_session.in_transaction ());
+
+  zerostruct (m_stats);
+  m_startTicks = Time::getHighResolutionTicks ();
+  m_savedPragmas.clear ();
+  m_indexes.clear ();
+  m_failedIndexes.clear ();
+
+  if (!error)
+    error = set_pragma ("journal_mode", m_options.journal_mode);
+
+  if (!error)
+    error = set_pragma ("synchronous", m_options.synchronous);
+
+  if (!error)
+    error = set_pragma ("cache_size", pragma_value (m_options.cache_size));
+
+  if (!error)
+    error = set_pragma ("mmap_size", pragma_value (m_options.mmap_size));
+
+  if (!error)
+    error = set_pragma ("temp_store", m_options.temp_store);
+
+  if (!error && m_options.drop_indexes && !table.empty ())
+    error = drop_indexes (table);
+
+  if (!error)
+  {
+    m_totalChanges = sqlite3_total_changes (m_session.get_connection ());
+    m_rowsInTransaction = 0;
+
+    m_session.begin ();
+
+    m_loading = true;
+  }
+  else
+  {
+    // put back what was changed before the failure
+    Error restoreError = restore ();
+
+    restoreError.willBeReported ();
+  }
+
+  return error;
+}
+
+Error bulk_loader::execute (statement& st)
+{
+  Error error;
+
+  st.execute_and_fetch (error);
+
+  if (!error)
+    error = update ();
+
+  return error;
+}
+
+Error bulk_loader::update ()
+{
+  Error error;
+
+  jassert (m_loading);
+
+  int const totalChanges = sqlite3_total_changes (m_session.get_connection ());
+
+  m_rowsInTransaction += totalChanges - m_totalChanges;
+  m_stats.rows += totalChanges - m_totalChanges;
+  m_totalChanges = totalChanges;
+
+  if (m_rowsInTransaction >= m_options.batch_size)
+  {
+    error = m_session.commit ();
+
+    if (!error)
+    {
+      ++m_stats.transactions;
+      m_rowsInTransaction = 0;
+
+      m_session.begin ();
+    }
+  }
+
+  m_stats.seconds = Time::highResolutionTicksToSeconds (
+    Time::getHighResolutionTicks () - m_startTicks);
+
+  if (m_stats.seconds > 0)
+    m_stats.rows_per_second = m_stats.rows / m_stats.seconds;
+
+  return error;
+}
+
+Error bulk_loader::finish ()
+{
+  Error error;
+
+  if (m_loading)
+  {
+    error = update ();
+
+    if (!error && m_session.in_transaction ())
+    {
+      error = m_session.commit ();
+
+      ++m_stats.transactions;
+    }
+
+    // A failed commit leaves the transaction open. ROLLBACK is undefined
+    // without a journal, and the journal can't be turned back on inside
+    // the transaction, so then the commit is tried once more first.
+    if (error && !sqlite3_get_autocommit (m_session.get_connection ()))
+    {
+      if (String (m_options.journal_mode.c_str ()).equalsIgnoreCase ("OFF"))
+      {
+        Error commitError;
+        m_session.once (commitError) << "COMMIT";
+        commitError.willBeReported ();
+      }
+
+      if (!sqlite3_get_autocommit (m_session.get_connection ()))
+      {
+        Error rollbackError;
+        m_session.once (rollbackError) << "ROLLBACK";
+        rollbackError.willBeReported ();
+      }
+    }
+
+    m_loading = false;
+
+    // done even if the load failed
+    Error restoreError = restore ();
+
+    if (!error)
+      error = restoreError;
+
+    m_stats.seconds = Time::highResolutionTicksToSeconds (
+      Time::getHighResolutionTicks () - m_startTicks);
+
+    if (m_stats.seconds > 0)
+      m_stats.rows_per_second = m_stats.rows / m_stats.seconds;
+  }
+
+  return error;
+}
+
+// The settings are put back first, so that
+// the indexes are rebuilt with the journal on.
+//
+Error bulk_loader::restore ()
+{
+  Error error;
+
+  // set_pragma saves the value it replaces, so work from a copy
+  std::vector <saved_pragma> saved;
+  saved.swap (m_savedPragmas);
+
+  for (std::size_t i = saved.size (); i-- > 0;)
+  {
+    Error restoreError = set_pragma (saved [i].name, saved [i].value);
+
+    if (!error)
+      error = restoreError;
+  }
+
+  m_savedPragmas.clear ();
+
+  Error indexError = rebuild_indexes ();
+
+  if (!error)
+    error = indexError;
+
+  return error;
+}
+
+bulk_loader::stats bulk_loader::get_stats () const
+{
+  return m_stats;
+}
+
+Error bulk_loader::set_pragma (std::string const& name, std::string const& value)
+{
+  Error error;
+
+  cursor c (m_session);
+
+  error = c.prepare ("PRAGMA " + name);
+
+  // pragmas unknown to this version of SQLite return nothing
+  if (!error && c.next (error))
+  {
+    text_view const current = c.get_text (0);
+
+    saved_pragma saved;
+    saved.name = name;
+    saved.value.assign (current.begin (), current.end ());
+
+    m_savedPragmas.push_back (saved);
+  }
+
+  if (!error)
+  {
+    error = c.prepare ("PRAGMA " + name + "=" + value);
+
+    // some pragmas return their new value
+    if (!error)
+      c.next (error);
+  }
+
+  return error;
+}
+
+Error bulk_loader::drop_indexes (std::string const& table)
+{
+  Error error;
+
+  std::vector <std::string> names;
+  std::vector <std::string> sqls;
+
+  {
+    cursor c (m_session);
+
+    // indexes made by UNIQUE and PRIMARY KEY constraints have no SQL
+    // and can't be dropped
+    error = c.prepare ("SELECT name, sql FROM sqlite_master "
+                       "WHERE type = 'index' AND tbl_name = ? AND sql IS NOT NULL");
+
+    if (!error)
+    {
+      c.bind (table);
+
+      while (c.next (error))
+      {
+        text_view name;
+        text_view sql;
+        c.fetch (name, sql);
+
+        names.push_back (std::string (name.begin (), name.end ()));
+        sqls.push_back (std::string (sql.begin (), sql.end ()));
+      }
+    }
+  }
+
+  for (std::size_t i = 0; !error && i < names.size (); ++i)
+  {
+    std::string quoted;
+
+    for (std::size_t j = 0; j < names [i].size (); ++j)
+    {
+      if (names [i][j] == '"')
+        quoted += '"';
+
+      quoted += names [i][j];
+    }
+
+    m_session.once (error) << "DROP INDEX \"" << quoted << "\"";
+
+    // only what was dropped is rebuilt
+    if (!error)
+      m_indexes.push_back (sqls [i]);
+  }
+
+  m_stats.indexes = int (m_indexes.size ());
+
+  return error;
+}
+
+// Each index is created in its own transaction, so one which
+// fails does not take the others with it. The SQL of a failed
+// index is kept for the caller.
+//
+Error bulk_loader::rebuild_indexes ()
+{
+  Error error;
+
+  if (!m_indexes.empty ())
+  {
+    int64 const startTicks = Time::getHighResolutionTicks ();
+
+    for (std::size_t i = 0; i < m_indexes.size (); ++i)
+    {
+      Error indexError;
+
+      m_session.once (indexError) << m_indexes [i];
+
+      if (indexError)
+      {
+        m_failedIndexes.push_back (m_indexes [i]);
+
+        if (!error)
+          error = indexError;
+      }
+    }
+
+    m_indexes.clear ();
+
+    m_stats.failed_indexes = int (m_failedIndexes.size ());
+
+    m_stats.index_seconds = Time::highResolutionTicksToSeconds (
+      Time::getHighResolutionTicks () - startTicks);
+  }
+
+  return error;
+}
+
+}
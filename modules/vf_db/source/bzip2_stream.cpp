@@ -0,0 +1,276 @@
+/*============================================================================*/
+/*
+  VFLib: https://github.com/vinniefalco/VFLib
+
+  Copyright (C) 2008 by Vinnie Falco <vinnie.falco@gmail.com>
+
+  This library contains portions of other open source products covered by
+  separate licenses. Please see the corresponding source files for specific
+  terms.
+  
+  VFLib is provided under the terms of The MIT License (MIT):
+
+  Permission is hereby granted, free of charge, to any person obtaining a copy
+  of this software and associated documentation files (the "Software"), to deal
+  in the Software without restriction, including without limitation the rights
+  to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+  copies of the Software, and to permit persons to whom the Software is
+  furnished to do so, subject to the following conditions:
+
+  The above copyright notice and this permission notice shall be included in
+  all copies or substantial portions of the Software.
+
+  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+  FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+  IN THE SOFTWARE.
+*/
+/*============================================================================*/
+
+namespace db {
+
+class bzip2_input_stream::Decompressor
+{
+public:
+  Decompressor ()
+    : m_finished (false)
+  {
+    zerostruct (m_stream);
+
+    m_finished = BZ2_bzDecompressInit (&m_stream, 0, 0) != BZ_OK;
+  }
+
+  ~Decompressor ()
+  {
+    BZ2_bzDecompressEnd (&m_stream);
+  }
+
+  bool isFinished () const
+  {
+    return m_finished;
+  }
+
+  // Returns the number of bytes produced, which is
+  // less than requested only at the end of the data.
+  int read (InputStream& source, char* dest, int bytes)
+  {
+    m_stream.next_out = dest;
+    m_stream.avail_out = (unsigned int) bytes;
+
+    while (m_stream.avail_out > 0 && !m_finished)
+    {
+      if (m_stream.avail_in == 0)
+      {
+        int const bytesRead = source.read (m_input, sizeof (m_input));
+
+        if (bytesRead <= 0)
+        {
+          // truncated
+          m_finished = true;
+          break;
+        }
+
+        m_stream.next_in = m_input;
+        m_stream.avail_in = (unsigned int) bytesRead;
+      }
+
+      int const result = BZ2_bzDecompress (&m_stream);
+
+      // anything but BZ_OK is the end or corrupt data
+      if (result != BZ_OK)
+        m_finished = true;
+    }
+
+    return bytes - int (m_stream.avail_out);
+  }
+
+private:
+  bz_stream m_stream;
+  bool m_finished;
+  char m_input [16384];
+};
+
+bzip2_input_stream::bzip2_input_stream (InputStream* source, bool deleteSourceWhenDestroyed)
+  : m_source (source, deleteSourceWhenDestroyed)
+  , m_sourceStart (source->getPosition ())
+  , m_decompressor (new Decompressor)
+  , m_position (0)
+{
+}
+
+bzip2_input_stream::~bzip2_input_stream ()
+{
+}
+
+int64 bzip2_input_stream::getTotalLength ()
+{
+  return -1;
+}
+
+bool bzip2_input_stream::isExhausted ()
+{
+  return m_decompressor->isFinished ();
+}
+
+int bzip2_input_stream::read (void* destBuffer, int maxBytesToRead)
+{
+  int const bytesRead = m_decompressor->read (
+    *m_source, static_cast <char*> (destBuffer), maxBytesToRead);
+
+  m_position += bytesRead;
+
+  return bytesRead;
+}
+
+int64 bzip2_input_stream::getPosition ()
+{
+  return m_position;
+}
+
+bool bzip2_input_stream::setPosition (int64 newPosition)
+{
+  if (newPosition < m_position)
+  {
+    // start over
+    if (!m_source->setPosition (m_sourceStart))
+      return false;
+
+    m_decompressor = new Decompressor;
+    m_position = 0;
+  }
+
+  char buffer [4096];
+
+  while (m_position < newPosition)
+  {
+    int const bytes = int (jmin (int64 (sizeof (buffer)), newPosition - m_position));
+
+    if (read (buffer, bytes) < bytes)
+      return false;
+  }
+
+  return true;
+}
+
+//------------------------------------------------------------------------------
+
+class bzip2_output_stream::Compressor
+{
+public:
+  explicit Compressor (int blockSize100k)
+    : m_finished (false)
+  {
+    zerostruct (m_stream);
+
+    m_finished = BZ2_bzCompressInit (&m_stream, jlimit (1, 9, blockSize100k), 0, 0) != BZ_OK;
+  }
+
+  ~Compressor ()
+  {
+    BZ2_bzCompressEnd (&m_stream);
+  }
+
+  // action is BZ_RUN, BZ_FLUSH or BZ_FINISH
+  bool compress (OutputStream& dest, char const* data, unsigned int bytes, int action)
+  {
+    if (m_finished)
+      return false;
+
+    m_stream.next_in = const_cast <char*> (data);
+    m_stream.avail_in = bytes;
+
+    for (;;)
+    {
+      m_stream.next_out = m_output;
+      m_stream.avail_out = sizeof (m_output);
+
+      int const result = BZ2_bzCompress (&m_stream, action);
+
+      if (result < 0)
+        return false;
+
+      size_t const produced = sizeof (m_output) - m_stream.avail_out;
+
+      if (produced > 0 && !dest.write (m_output, produced))
+        return false;
+
+      if (action == BZ_RUN && m_stream.avail_in == 0)
+        break;
+
+      // a flush is complete when the library goes back to running
+      if (action == BZ_FLUSH && result == BZ_RUN_OK)
+        break;
+
+      if (action == BZ_FINISH && result == BZ_STREAM_END)
+      {
+        m_finished = true;
+        break;
+      }
+    }
+
+    return true;
+  }
+
+private:
+  bz_stream m_stream;
+  bool m_finished;
+  char m_output [16384];
+};
+
+bzip2_output_stream::bzip2_output_stream (OutputStream* dest,
+                                          bool deleteDestWhenDestroyed,
+                                          int blockSize100k)
+  : m_dest (dest, deleteDestWhenDestroyed)
+  , m_compressor (new Compressor (blockSize100k))
+  , m_position (0)
+{
+}
+
+bzip2_output_stream::~bzip2_output_stream ()
+{
+  m_compressor->compress (*m_dest, 0, 0, BZ_FINISH);
+
+  m_dest->flush ();
+}
+
+void bzip2_output_stream::flush ()
+{
+  m_compressor->compress (*m_dest, 0, 0, BZ_FLUSH);
+
+  m_dest->flush ();
+}
+
+bool bzip2_output_stream::setPosition (int64)
+{
+  return false;
+}
+
+int64 bzip2_output_stream::getPosition ()
+{
+  return m_position;
+}
+
+bool bzip2_output_stream::write (const void* dataToWrite, size_t numberOfBytes)
+{
+  char const* data = static_cast <char const*> (dataToWrite);
+
+  while (numberOfBytes > 0)
+  {
+    // the library counts bytes with an unsigned int
+    unsigned int const bytes = (unsigned int) jmin (numberOfBytes, size_t (1 << 30));
+
+    if (!m_compressor->compress (*m_dest, data, bytes, BZ_RUN))
+      return false;
+
+    data += bytes;
+    numberOfBytes -= bytes;
+    m_position += bytes;
+  }
+
+  return true;
+}
+
+}
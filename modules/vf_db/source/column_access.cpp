@@ -0,0 +1,195 @@
+/*============================================================================*/
+/*
+  VFLib: https://github.com/vinniefalco/VFLib
+
+  Copyright (C) 2008 by Vinnie Falco <vinnie.falco@gmail.com>
+
+  This library contains portions of other open source products covered by
+  separate licenses. Please see the corresponding source files for specific
+  terms.
+  
+  VFLib is provided under the terms of The MIT License (MIT):
+
+  Permission is hereby granted, free of charge, to any person obtaining a copy
+  of this software and associated documentation files (the "Software"), to deal
+  in the Software without restriction, including without limitation the rights
+  to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+  copies of the Software, and to permit persons to whom the Software is
+  furnished to do so, subject to the following conditions:
+
+  The above copyright notice and this permission notice shall be included in
+  all copies or substantial portions of the Software.
+
+  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+  FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+  IN THE SOFTWARE.
+*/
+/*============================================================================*/
+
+namespace db {
+
+namespace detail {
+
+namespace {
+
+template <typename T>
+inline bool get_integer_column (sqlite3_stmt* stmt, int iCol, T& value)
+{
+  bool const isNull = sqlite3_column_type (stmt, iCol) == SQLITE_NULL;
+
+  if (!isNull)
+    value = T (sqlite3_column_int64 (stmt, iCol));
+
+  return !isNull;
+}
+
+}
+
+bool get_column (sqlite3_stmt* stmt, int iCol, bool& value)
+{
+  bool const isNull = sqlite3_column_type (stmt, iCol) == SQLITE_NULL;
+
+  if (!isNull)
+    value = sqlite3_column_int64 (stmt, iCol) != 0;
+
+  return !isNull;
+}
+
+bool get_column (sqlite3_stmt* stmt, int iCol, char& value)           { return get_integer_column (stmt, iCol, value); }
+bool get_column (sqlite3_stmt* stmt, int iCol, short& value)          { return get_integer_column (stmt, iCol, value); }
+bool get_column (sqlite3_stmt* stmt, int iCol, int& value)            { return get_integer_column (stmt, iCol, value); }
+bool get_column (sqlite3_stmt* stmt, int iCol, long& value)           { return get_integer_column (stmt, iCol, value); }
+bool get_column (sqlite3_stmt* stmt, int iCol, int64& value)          { return get_integer_column (stmt, iCol, value); }
+bool get_column (sqlite3_stmt* stmt, int iCol, unsigned char& value)  { return get_integer_column (stmt, iCol, value); }
+bool get_column (sqlite3_stmt* stmt, int iCol, unsigned short& value) { return get_integer_column (stmt, iCol, value); }
+bool get_column (sqlite3_stmt* stmt, int iCol, unsigned int& value)   { return get_integer_column (stmt, iCol, value); }
+bool get_column (sqlite3_stmt* stmt, int iCol, unsigned long& value)  { return get_integer_column (stmt, iCol, value); }
+bool get_column (sqlite3_stmt* stmt, int iCol, uint64& value)         { return get_integer_column (stmt, iCol, value); }
+
+bool get_column (sqlite3_stmt* stmt, int iCol, float& value)
+{
+  bool const isNull = sqlite3_column_type (stmt, iCol) == SQLITE_NULL;
+
+  if (!isNull)
+    value = static_cast <float> (sqlite3_column_double (stmt, iCol));
+
+  return !isNull;
+}
+
+bool get_column (sqlite3_stmt* stmt, int iCol, double& value)
+{
+  bool const isNull = sqlite3_column_type (stmt, iCol) == SQLITE_NULL;
+
+  if (!isNull)
+    value = sqlite3_column_double (stmt, iCol);
+
+  return !isNull;
+}
+
+bool get_column (sqlite3_stmt* stmt, int iCol, std::string& value)
+{
+  bool const isNull = sqlite3_column_type (stmt, iCol) == SQLITE_NULL;
+
+  if (!isNull)
+  {
+    // excludes terminator
+    char const* text = reinterpret_cast <char const*> (sqlite3_column_text (stmt, iCol));
+    int const bytes = sqlite3_column_bytes (stmt, iCol);
+
+    value.assign (text, bytes);
+  }
+
+  return !isNull;
+}
+
+bool get_column (sqlite3_stmt* stmt, int iCol, String& value)
+{
+  bool const isNull = sqlite3_column_type (stmt, iCol) == SQLITE_NULL;
+
+  if (!isNull)
+  {
+    // excludes terminator
+    CharPointer_UTF8::CharType const* c = reinterpret_cast
+      <CharPointer_UTF8::CharType const*> (sqlite3_column_text (stmt, iCol));
+    int const bytes = sqlite3_column_bytes (stmt, iCol);
+
+    value = String (CharPointer_UTF8 (c), CharPointer_UTF8 (c + bytes));
+  }
+
+  return !isNull;
+}
+
+//------------------------------------------------------------------------------
+
+int bind_param (sqlite3_stmt* stmt, int iParam, bool value)
+{
+  return sqlite3_bind_int (stmt, iParam, value ? 1 : 0);
+}
+
+int bind_param (sqlite3_stmt* stmt, int iParam, char value)           { return sqlite3_bind_int (stmt, iParam, value); }
+int bind_param (sqlite3_stmt* stmt, int iParam, short value)          { return sqlite3_bind_int (stmt, iParam, value); }
+int bind_param (sqlite3_stmt* stmt, int iParam, int value)            { return sqlite3_bind_int (stmt, iParam, value); }
+int bind_param (sqlite3_stmt* stmt, int iParam, long value)           { return sqlite3_bind_int64 (stmt, iParam, value); }
+int bind_param (sqlite3_stmt* stmt, int iParam, int64 value)          { return sqlite3_bind_int64 (stmt, iParam, value); }
+int bind_param (sqlite3_stmt* stmt, int iParam, unsigned char value)  { return sqlite3_bind_int (stmt, iParam, value); }
+int bind_param (sqlite3_stmt* stmt, int iParam, unsigned short value) { return sqlite3_bind_int (stmt, iParam, value); }
+int bind_param (sqlite3_stmt* stmt, int iParam, unsigned int value)   { return sqlite3_bind_int64 (stmt, iParam, value); }
+
+int bind_param (sqlite3_stmt* stmt, int iParam, unsigned long value)
+{
+  if (sqlite3_uint64 (value) > sqlite3_uint64 (std::numeric_limits <sqlite3_int64>::max ()))
+    Throw (Error().fail (__FILE__, __LINE__));
+
+  return sqlite3_bind_int64 (stmt, iParam, sqlite3_int64 (value));
+}
+
+int bind_param (sqlite3_stmt* stmt, int iParam, uint64 value)
+{
+  if (value > uint64 (std::numeric_limits <sqlite3_int64>::max ()))
+    Throw (Error().fail (__FILE__, __LINE__));
+
+  return sqlite3_bind_int64 (stmt, iParam, sqlite3_int64 (value));
+}
+
+int bind_param (sqlite3_stmt* stmt, int iParam, float value)
+{
+  return sqlite3_bind_double (stmt, iParam, value);
+}
+
+int bind_param (sqlite3_stmt* stmt, int iParam, double value)
+{
+  return sqlite3_bind_double (stmt, iParam, value);
+}
+
+int bind_param (sqlite3_stmt* stmt, int iParam, std::string const& value)
+{
+  return sqlite3_bind_text (stmt, iParam, value.c_str (), int (value.size ()), SQLITE_STATIC);
+}
+
+int bind_param (sqlite3_stmt* stmt, int iParam, String const& value)
+{
+  return sqlite3_bind_text (stmt, iParam, value.toUTF8 (), -1, SQLITE_STATIC);
+}
+
+int bind_param_copy (sqlite3_stmt* stmt, int iParam, std::string const& value)
+{
+  return sqlite3_bind_text (stmt, iParam, value.c_str (), int (value.size ()), SQLITE_TRANSIENT);
+}
+
+int bind_param_copy (sqlite3_stmt* stmt, int iParam, String const& value)
+{
+  return sqlite3_bind_text (stmt, iParam, value.toUTF8 (), -1, SQLITE_TRANSIENT);
+}
+
+int bind_null (sqlite3_stmt* stmt, int iParam)
+{
+  return sqlite3_bind_null (stmt, iParam);
+}
+
+}
+
+}
@@ -0,0 +1,200 @@
+/*============================================================================*/
+/*
+  VFLib: https://github.com/vinniefalco/VFLib
+
+  Copyright (C) 2008 by Vinnie Falco <vinnie.falco@gmail.com>
+
+  This library contains portions of other open source products covered by
+  separate licenses. Please see the corresponding source files for specific
+  terms.
+  
+  VFLib is provided under the terms of The MIT License (MIT):
+
+  Permission is hereby granted, free of charge, to any person obtaining a copy
+  of this software and associated documentation files (the "Software"), to deal
+  in the Software without restriction, including without limitation the rights
+  to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+  copies of the Software, and to permit persons to whom the Software is
+  furnished to do so, subject to the following conditions:
+
+  The above copyright notice and this permission notice shall be included in
+  all copies or substantial portions of the Software.
+
+  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+  FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+  IN THE SOFTWARE.
+*/
+/*============================================================================*/
+
+namespace db {
+
+namespace detail {
+
+bool get_column (sqlite3_stmt* stmt, int iCol, text_view& value)
+{
+  bool const isNull = sqlite3_column_type (stmt, iCol) == SQLITE_NULL;
+
+  if (!isNull)
+  {
+    // the text must be fetched before its size
+    value.data = reinterpret_cast <char const*> (sqlite3_column_text (stmt, iCol));
+    value.size = sqlite3_column_bytes (stmt, iCol);
+  }
+  else
+  {
+    value = text_view ();
+  }
+
+  return !isNull;
+}
+
+bool get_column (sqlite3_stmt* stmt, int iCol, blob_view& value)
+{
+  bool const isNull = sqlite3_column_type (stmt, iCol) == SQLITE_NULL;
+
+  if (!isNull)
+  {
+    value.data = sqlite3_column_blob (stmt, iCol);
+    value.size = sqlite3_column_bytes (stmt, iCol);
+  }
+  else
+  {
+    value = blob_view ();
+  }
+
+  return !isNull;
+}
+
+}
+
+//------------------------------------------------------------------------------
+
+cursor::cursor (session& s)
+  : m_session (s)
+  , m_stmt (0)
+  , m_iParam (0)
+{
+}
+
+cursor::~cursor ()
+{
+  release ();
+}
+
+Error cursor::prepare (std::string const& query)
+{
+  Error error;
+
+  release ();
+
+  int const result = m_session.get_statement_cache ().acquire (
+    m_session.get_connection (), query, m_key, &m_stmt);
+
+  if (result != SQLITE_OK)
+  {
+    m_stmt = 0;
+
+    error = detail::sqliteError (__FILE__, __LINE__, result);
+  }
+
+  return error;
+}
+
+cursor& cursor::bind_null ()
+{
+  check_bind (detail::bind_null (m_stmt, ++m_iParam));
+
+  return *this;
+}
+
+bool cursor::next (Error& error)
+{
+  jassert (m_stmt != 0);
+
+  int const result = sqlite3_step (m_stmt);
+
+  if (result == SQLITE_ROW)
+    return true;
+
+  if (result != SQLITE_DONE)
+    error = detail::sqliteError (__FILE__, __LINE__, result);
+
+  return false;
+}
+
+void cursor::reset (bool rebind)
+{
+  jassert (m_stmt != 0);
+
+  sqlite3_reset (m_stmt);
+
+  if (rebind)
+  {
+    sqlite3_clear_bindings (m_stmt);
+
+    m_iParam = 0;
+  }
+}
+
+int cursor::get_column_count () const
+{
+  return sqlite3_data_count (m_stmt);
+}
+
+bool cursor::is_null (int iCol) const
+{
+  return sqlite3_column_type (m_stmt, iCol) == SQLITE_NULL;
+}
+
+int cursor::get_int (int iCol) const
+{
+  return sqlite3_column_int (m_stmt, iCol);
+}
+
+int64 cursor::get_int64 (int iCol) const
+{
+  return sqlite3_column_int64 (m_stmt, iCol);
+}
+
+double cursor::get_double (int iCol) const
+{
+  return sqlite3_column_double (m_stmt, iCol);
+}
+
+text_view cursor::get_text (int iCol) const
+{
+  text_view value;
+  detail::get_column (m_stmt, iCol, value);
+  return value;
+}
+
+blob_view cursor::get_blob (int iCol) const
+{
+  blob_view value;
+  detail::get_column (m_stmt, iCol, value);
+  return value;
+}
+
+void cursor::check_bind (int result)
+{
+  if (result != SQLITE_OK)
+    Throw (detail::sqliteError (__FILE__, __LINE__, result));
+}
+
+void cursor::release ()
+{
+  if (m_stmt != 0)
+  {
+    m_session.get_statement_cache ().release (m_key, m_stmt);
+
+    m_stmt = 0;
+  }
+
+  m_iParam = 0;
+}
+
+}
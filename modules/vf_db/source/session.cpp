@@ -110,6 +110,7 @@ session::session ()
   , m_instance (Sqlite3::getInstance ())
   , m_bInTransaction (false)
   , m_connection (0)
+  , m_profiler (nullptr)
 {
 }
 
@@ -119,6 +120,7 @@ session::session (const session& deferredClone)
   , m_connection (0)
   , m_fileName (deferredClone.m_fileName)
   , m_connectString (deferredClone.m_connectString)
+  , m_profiler (deferredClone.m_profiler)
 {
   // shouldn't be needed since deferredClone did it
   //Sqlite::initialize();
@@ -156,6 +158,13 @@ Error session::open (String fileName, std::string options)
   int mode = 0;
   int flags = 0;
   int timeout = 0;
+
+  // Pragmas applied after opening, in this order. The page size
+  // must be set before the database is switched to WAL.
+  enum { numPragmas = 5 };
+  static char const* const pragmaNames [numPragmas] =
+    { "page_size", "journal_mode", "cache_size", "mmap_size", "wal_autocheckpoint" };
+  std::string pragmaValues [numPragmas];
   
   std::stringstream ssconn (options);
 
@@ -258,10 +267,46 @@ Error session::open (String fileName, std::string options)
         Throw (err.fail (__FILE__, __LINE__, Error::badParameter));
       }
     }
+    else if( "journal_mode" == key )
+    {
+      if( "delete" != val && "truncate" != val && "persist" != val &&
+          "memory" != val && "wal" != val && "off" != val )
+      {
+        Throw (err.fail (__FILE__, __LINE__, Error::badParameter));
+      }
+
+      if( ! pragmaValues [1].empty () )
+      {
+        // duplicate
+        Throw (err.fail (__FILE__, __LINE__, Error::badParameter));
+      }
+
+      pragmaValues [1] = val;
+    }
     else
     {
-      // unknown option
-      Throw (err.fail (__FILE__, __LINE__, Error::badParameter));
+      int i = 0;
+      while (i < numPragmas && key != pragmaNames [i])
+        ++i;
+
+      if (i == numPragmas)
+      {
+        // unknown option
+        Throw (err.fail (__FILE__, __LINE__, Error::badParameter));
+      }
+
+      // the rest are numbers
+      int64 value;
+      std::istringstream converter (val);
+      converter >> value;
+
+      if( converter.fail () || ! converter.eof () || ! pragmaValues [i].empty () )
+      {
+        // malformed or duplicate
+        Throw (err.fail (__FILE__, __LINE__, Error::badParameter));
+      }
+
+      pragmaValues [i] = val;
     }
   }
 
@@ -291,6 +336,14 @@ Error session::open (String fileName, std::string options)
       */
     }
 
+    // SQLite ignores pragmas it doesn't know, such as
+    // mmap_size in versions before 3.7.17.
+    for (int i = 0; !err && i < numPragmas; ++i)
+    {
+      if (! pragmaValues [i].empty ())
+        err = hard_exec (std::string ("PRAGMA ") + pragmaNames [i] + "=" + pragmaValues [i]);
+    }
+
     if (!err)
     {
       m_fileName = fileName;
@@ -310,6 +363,8 @@ void session::close()
 {
   if (m_connection)
   {
+    m_statement_cache.clear ();
+
     sqlite3_close (m_connection);
     m_connection = 0;
     m_fileName = String::empty;
@@ -317,6 +372,41 @@ void session::close()
   }
 }
 
+session::stats session::get_stats (bool reset)
+{
+  stats result;
+
+  zerostruct (result);
+
+  if (m_connection)
+  {
+    struct counter
+    {
+      int op;
+      int* value;
+    };
+
+    counter const counters [] =
+    {
+      { SQLITE_DBSTATUS_CACHE_HIT,     &result.cache_hits },
+      { SQLITE_DBSTATUS_CACHE_MISS,    &result.cache_misses },
+      { SQLITE_DBSTATUS_CACHE_WRITE,   &result.cache_writes },
+      { SQLITE_DBSTATUS_CACHE_USED,    &result.cache_used },
+      { SQLITE_DBSTATUS_SCHEMA_USED,   &result.schema_used },
+      { SQLITE_DBSTATUS_STMT_USED,     &result.statement_used },
+      { SQLITE_DBSTATUS_LOOKASIDE_USED, &result.lookaside_used }
+    };
+
+    for (std::size_t i = 0; i < sizeof (counters) / sizeof (counters [0]); ++i)
+    {
+      int highwater;
+      sqlite3_db_status (m_connection, counters [i].op, counters [i].value, &highwater, reset ? 1 : 0);
+    }
+  }
+
+  return result;
+}
+
 void session::begin()
 {
   jassert( !m_bInTransaction );
@@ -378,20 +468,15 @@ Error session::hard_exec (std::string const& query)
 {
   Error error;
   sqlite3_stmt* stmt;
-  char const* tail=0;
+  std::string key;
 
-  int result = sqlite3_prepare_v2(
-    m_connection,
-    query.c_str(),
-    static_cast<int>(query.size()),
-    &stmt,
-    &tail );
+  int result = m_statement_cache.acquire (m_connection, query, key, &stmt);
 
   if (result == SQLITE_OK)
   {
     result = sqlite3_step (stmt);
 
-    sqlite3_finalize (stmt);
+    m_statement_cache.release (key, stmt);
   }
 
   if (result != SQLITE_DONE)
@@ -0,0 +1,277 @@
+/*============================================================================*/
+/*
+  VFLib: https://github.com/vinniefalco/VFLib
+
+  Copyright (C) 2008 by Vinnie Falco <vinnie.falco@gmail.com>
+
+  This library contains portions of other open source products covered by
+  separate licenses. Please see the corresponding source files for specific
+  terms.
+  
+  VFLib is provided under the terms of The MIT License (MIT):
+
+  Permission is hereby granted, free of charge, to any person obtaining a copy
+  of this software and associated documentation files (the "Software"), to deal
+  in the Software without restriction, including without limitation the rights
+  to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+  copies of the Software, and to permit persons to whom the Software is
+  furnished to do so, subject to the following conditions:
+
+  The above copyright notice and this permission notice shall be included in
+  all copies or substantial portions of the Software.
+
+  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+  FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+  IN THE SOFTWARE.
+*/
+/*============================================================================*/
+
+namespace db {
+
+namespace {
+
+ContentionProfiler::Site readerSlotsSite ("db::session_pool::acquire_reader");
+
+}
+
+session_pool::read_lease::read_lease (session_pool& pool)
+  : m_pool (pool)
+  , m_session (pool.acquire_reader ())
+{
+}
+
+session_pool::read_lease::~read_lease ()
+{
+  m_pool.release_reader (m_session);
+}
+
+session_pool::write_lease::write_lease (session_pool& pool)
+  : m_pool (pool)
+  , m_session (pool.acquire_writer ())
+{
+}
+
+session_pool::write_lease::~write_lease ()
+{
+  m_pool.release_writer ();
+}
+
+//------------------------------------------------------------------------------
+
+session_pool::session_pool ()
+  : m_maxReaders (0)
+  , m_readerSlots (0, readerSlotsSite)
+{
+  zerostruct (m_stats);
+}
+
+session_pool::~session_pool ()
+{
+  close ();
+}
+
+Error session_pool::open (String fileName, int max_readers, bool shared_cache)
+{
+  Error error;
+
+  jassert (max_readers > 0);
+
+  // can't open twice
+  if (m_writer != nullptr)
+    Throw (error.fail (__FILE__, __LINE__, Error::fileInUse));
+
+  m_writer = new session;
+
+  error = m_writer->open (fileName, "timeout=infinite|mode=create|threads=multi");
+
+  if (!error)
+  {
+    std::string journalMode;
+
+    m_writer->once (error) << "PRAGMA journal_mode=WAL", into (journalMode);
+
+    if (!error && journalMode != "wal")
+      error.fail (__FILE__, __LINE__, Error::badParameter);
+  }
+
+  if (!error)
+  {
+    m_fileName = fileName;
+
+    m_readerOptions = "timeout=infinite|mode=read|threads=multi";
+
+    if (shared_cache)
+      m_readerOptions += "|cache=shared";
+
+    m_maxReaders = max_readers;
+    m_freeReaderSlots.set (max_readers);
+    m_readerSlots.signal (max_readers);
+
+    zerostruct (m_stats);
+  }
+  else
+  {
+    m_writer = nullptr;
+  }
+
+  return error;
+}
+
+void session_pool::close ()
+{
+  if (m_writer != nullptr)
+  {
+    // take back every slot, there must be no leases
+    jassert (m_freeReaderSlots.get () == m_maxReaders);
+
+    for (int i = 0; i < m_maxReaders; ++i)
+      m_readerSlots.wait ();
+
+    m_idle.clear ();
+    m_readers.clear ();
+    m_writer = nullptr;
+    m_maxReaders = 0;
+  }
+}
+
+session_pool::stats session_pool::get_stats () const
+{
+  CriticalSection::ScopedLockType lock (m_mutex);
+
+  stats result = m_stats;
+  result.readers = m_readers.size ();
+
+  return result;
+}
+
+session* session_pool::acquire_reader ()
+{
+  jassert (m_writer != nullptr);
+
+  // a slot is reserved before one is free only if this will wait
+  if (--m_freeReaderSlots < 0)
+  {
+    int64 const startTicks = Time::getHighResolutionTicks ();
+
+    m_readerSlots.wait ();
+
+    CriticalSection::ScopedLockType lock (m_mutex);
+
+    record_wait (startTicks, m_stats.read_waits, m_stats.read_wait_seconds, m_stats.read_wait_max_seconds);
+  }
+  else
+  {
+    m_readerSlots.wait ();
+  }
+
+  session* s = nullptr;
+
+  {
+    CriticalSection::ScopedLockType lock (m_mutex);
+
+    ++m_stats.read_leases;
+
+    if (!m_idle.empty ())
+    {
+      // prefer the connection this thread used last
+      Thread::ThreadID const thisThread = Thread::getCurrentThreadId ();
+
+      std::size_t index = m_idle.size () - 1;
+
+      for (std::size_t i = 0; i < m_idle.size (); ++i)
+      {
+        if (m_idle [i].last_thread == thisThread)
+        {
+          index = i;
+          break;
+        }
+      }
+
+      s = m_idle [index].s;
+      m_idle.erase (m_idle.begin () + index);
+    }
+  }
+
+  if (s == nullptr)
+  {
+    ScopedPointer <session> newSession (new session);
+
+    Error error = newSession->open (m_fileName, m_readerOptions);
+
+    if (error)
+    {
+      ++m_freeReaderSlots;
+      m_readerSlots.signal ();
+
+      Throw (error);
+    }
+
+    CriticalSection::ScopedLockType lock (m_mutex);
+
+    s = newSession.release ();
+    m_readers.add (s);
+  }
+
+  return s;
+}
+
+void session_pool::release_reader (session* s)
+{
+  {
+    CriticalSection::ScopedLockType lock (m_mutex);
+
+    reader r;
+    r.s = s;
+    r.last_thread = Thread::getCurrentThreadId ();
+
+    m_idle.push_back (r);
+  }
+
+  ++m_freeReaderSlots;
+  m_readerSlots.signal ();
+}
+
+session* session_pool::acquire_writer ()
+{
+  jassert (m_writer != nullptr);
+
+  if (!m_writeMutex.tryEnter ())
+  {
+    int64 const startTicks = Time::getHighResolutionTicks ();
+
+    m_writeMutex.enter ();
+
+    CriticalSection::ScopedLockType lock (m_mutex);
+
+    record_wait (startTicks, m_stats.write_waits, m_stats.write_wait_seconds, m_stats.write_wait_max_seconds);
+  }
+
+  {
+    CriticalSection::ScopedLockType lock (m_mutex);
+
+    ++m_stats.write_leases;
+  }
+
+  return m_writer;
+}
+
+void session_pool::release_writer ()
+{
+  m_writeMutex.exit ();
+}
+
+void session_pool::record_wait (int64 startTicks, int64& waits, double& total, double& longest)
+{
+  double const seconds = Time::highResolutionTicksToSeconds (
+    Time::getHighResolutionTicks () - startTicks);
+
+  ++waits;
+  total += seconds;
+  longest = jmax (longest, seconds);
+}
+
+}
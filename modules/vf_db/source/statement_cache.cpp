@@ -0,0 +1,235 @@
+/*============================================================================*/
+/*
+  VFLib: https://github.com/vinniefalco/VFLib
+
+  Copyright (C) 2008 by Vinnie Falco <vinnie.falco@gmail.com>
+
+  This library contains portions of other open source products covered by
+  separate licenses. Please see the corresponding source files for specific
+  terms.
+  
+  VFLib is provided under the terms of The MIT License (MIT):
+
+  Permission is hereby granted, free of charge, to any person obtaining a copy
+  of this software and associated documentation files (the "Software"), to deal
+  in the Software without restriction, including without limitation the rights
+  to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+  copies of the Software, and to permit persons to whom the Software is
+  furnished to do so, subject to the following conditions:
+
+  The above copyright notice and this permission notice shall be included in
+  all copies or substantial portions of the Software.
+
+  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+  FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+  IN THE SOFTWARE.
+*/
+/*============================================================================*/
+
+namespace db {
+
+statement_cache::statement_cache (int capacity)
+  : m_capacity (capacity)
+{
+  reset_stats ();
+}
+
+statement_cache::~statement_cache ()
+{
+  clear ();
+}
+
+void statement_cache::set_capacity (int capacity)
+{
+  jassert (capacity >= 0);
+
+  m_capacity = capacity;
+
+  evict_to (m_capacity);
+}
+
+statement_cache::stats statement_cache::get_stats () const
+{
+  stats result = m_stats;
+
+  result.size = int (m_list.size ());
+  result.capacity = m_capacity;
+
+  return result;
+}
+
+void statement_cache::reset_stats ()
+{
+  m_stats.hits = 0;
+  m_stats.misses = 0;
+  m_stats.evictions = 0;
+  m_stats.size = 0;
+  m_stats.capacity = 0;
+}
+
+void statement_cache::clear ()
+{
+  for (list_t::iterator iter = m_list.begin (); iter != m_list.end (); ++iter)
+    sqlite3_finalize (iter->stmt);
+
+  m_list.clear ();
+  m_index.clear ();
+}
+
+int statement_cache::acquire (sqlite3* connection,
+                              std::string const& query,
+                              std::string& key,
+                              sqlite3_stmt** stmt)
+{
+  int result;
+
+  key = normalize (query);
+
+  index_t::iterator found = m_index.find (key);
+
+  if (found != m_index.end ())
+  {
+    *stmt = found->second->stmt;
+
+    m_list.erase (found->second);
+    m_index.erase (found);
+
+    ++m_stats.hits;
+
+    result = SQLITE_OK;
+  }
+  else
+  {
+    ++m_stats.misses;
+
+    char const* tail = 0;
+
+    result = sqlite3_prepare_v2 (
+      connection,
+      query.c_str (),
+      static_cast <int> (query.size ()),
+      stmt,
+      &tail);
+  }
+
+  return result;
+}
+
+void statement_cache::release (std::string const& key, sqlite3_stmt* stmt)
+{
+  // The result of the last step is reported again
+  // by reset, and was already seen by the caller.
+  sqlite3_reset (stmt);
+  sqlite3_clear_bindings (stmt);
+
+  if (m_capacity > 0 && m_index.find (key) == m_index.end ())
+  {
+    entry e;
+    e.key = key;
+    e.stmt = stmt;
+
+    m_list.push_front (e);
+    m_index [key] = m_list.begin ();
+
+    evict_to (m_capacity);
+  }
+  else
+  {
+    // The cache is disabled, or an identical statement was returned first
+    sqlite3_finalize (stmt);
+  }
+}
+
+void statement_cache::evict_to (int size)
+{
+  while (int (m_list.size ()) > size)
+  {
+    entry& e = m_list.back ();
+
+    sqlite3_finalize (e.stmt);
+    m_index.erase (e.key);
+    m_list.pop_back ();
+
+    ++m_stats.evictions;
+  }
+}
+
+std::string statement_cache::normalize (std::string const& query)
+{
+  std::string key;
+  key.reserve (query.size ());
+
+  // The character which ends the quoted text or comment being copied.
+  // A -- comment ends at its newline, which is kept so that the text
+  // after it is not mistaken for part of the comment, and a block
+  // comment ends at the '*' of its closing "*/".
+  char quote = 0;
+  bool space = false;
+
+  std::string::size_type const size = query.size ();
+
+  for (std::string::size_type i = 0; i < size; ++i)
+  {
+    char const c = query [i];
+
+    if (quote == '*')
+    {
+      key += c;
+
+      if (c == '*' && i + 1 < size && query [i + 1] == '/')
+      {
+        key += query [++i];
+        quote = 0;
+      }
+    }
+    else if (quote != 0)
+    {
+      // A doubled quote is an escape, which this handles
+      // as leaving and re-entering the quoted text.
+      if (c == quote)
+        quote = 0;
+
+      key += c;
+    }
+    else if (c == ' ' || c == '\t' || c == '\r' || c == '\n')
+    {
+      space = true;
+    }
+    else
+    {
+      if (space && !key.empty ())
+        key += ' ';
+
+      space = false;
+
+      key += c;
+
+      if (c == '\'' || c == '"' || c == '`')
+      {
+        quote = c;
+      }
+      else if (c == '[')
+      {
+        quote = ']';
+      }
+      else if (c == '-' && i + 1 < size && query [i + 1] == '-')
+      {
+        key += query [++i];
+        quote = '\n';
+      }
+      else if (c == '/' && i + 1 < size && query [i + 1] == '*')
+      {
+        key += query [++i];
+        quote = '*';
+      }
+    }
+  }
+
+  return key;
+}
+
+}
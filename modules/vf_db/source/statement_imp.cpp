@@ -101,6 +101,11 @@ statement_imp::statement_imp (session& s)
   , m_bReady (false)
   , m_bGotData (false)
   , m_last_insert_rowid (0)
+  , m_fetch_size (0)
+  , m_bProfiling (false)
+  , m_executeTicks (0)
+  , m_steps (0)
+  , m_rows (0)
 {
 }
 
@@ -109,6 +114,12 @@ statement_imp::statement_imp (prepare_temp_type const& prep)
   , m_stmt (0)
   , m_bReady (false)
   , m_bGotData (false)
+  , m_last_insert_rowid (0)
+  , m_fetch_size (0)
+  , m_bProfiling (false)
+  , m_executeTicks (0)
+  , m_steps (0)
+  , m_rows (0)
 {
   ref_counted_prepare_info& rcpi = prep.get_prepare_info();
 
@@ -169,13 +180,19 @@ void statement_imp::prepare (std::string const& query, bool bRepeatable)
 
   release_resources();
 
-  char const* tail = 0;
-  int result = sqlite3_prepare_v2(
+  int64 const startTicks = Time::getHighResolutionTicks ();
+
+  int result = m_session.get_statement_cache().acquire (
     m_session.get_connection(),
-    query.c_str(),
-    static_cast<int>(query.size()),
-    &m_stmt,
-    &tail );
+    query,
+    m_cache_key,
+    &m_stmt);
+
+  if (m_session.get_profiler () != nullptr)
+  {
+    m_session.get_profiler ()->add_prepare (query, Time::highResolutionTicksToSeconds (
+      Time::getHighResolutionTicks () - startTicks));
+  }
 
   if (result == SQLITE_OK)
   {
@@ -194,6 +211,13 @@ Error statement_imp::execute()
   if (!m_stmt)
     Throw (Error().fail (__FILE__, __LINE__, Error::badParameter));
 
+  // a previous run which wasn't fetched to the end
+  end_run ();
+
+  begin_run ();
+
+  int64 const startTicks = m_bProfiling ? Time::getHighResolutionTicks () : 0;
+
   // ???
   m_bGotData = false;
   m_session.set_got_data (m_bGotData);
@@ -211,13 +235,34 @@ Error statement_imp::execute()
   // reset
   error = detail::sqliteError (__FILE__, __LINE__, sqlite3_reset (m_stmt));
 
+  m_fetch_size = get_vector_into_size ();
+
+  std::size_t rows = 0;
+  bool const vectorUses = has_vector_uses (rows);
+
   if (!error)
   {
-    // set input variables
-    do_uses();
+    if (vectorUses)
+    {
+      error = do_vector_uses (rows);
+    }
+    else
+    {
+      // set input variables
+      do_uses();
 
-    m_bReady = true;
-    m_bFirstTime = true;
+      m_bReady = true;
+      m_bFirstTime = true;
+    }
+  }
+
+  if (m_bProfiling)
+  {
+    m_executeTicks += Time::getHighResolutionTicks () - startTicks;
+
+    // executed in bulk
+    if (!m_bReady)
+      end_run ();
   }
 
   return error;
@@ -225,7 +270,28 @@ Error statement_imp::execute()
 
 bool statement_imp::fetch (Error& error)
 {
-  int result = sqlite3_step (m_stmt);
+  int64 const startTicks = m_bProfiling ? Time::getHighResolutionTicks () : 0;
+
+  bool const gotData = (m_fetch_size > 0) ? fetch_rows (error) : fetch_row (error);
+
+  if (m_bProfiling)
+  {
+    m_executeTicks += Time::getHighResolutionTicks () - startTicks;
+
+    if (!gotData || !m_bReady)
+      end_run ();
+  }
+
+  return gotData;
+}
+
+bool statement_imp::fetch_row (Error& error)
+{
+  // done, or executed in bulk
+  if (!m_bReady)
+    return false;
+
+  int result = step ();
 
   if (result == SQLITE_ROW ||
       result == SQLITE_DONE)
@@ -300,9 +366,12 @@ void statement_imp::post_use()
 
 void statement_imp::release_resources()
 {
+  end_run ();
+
   if( m_stmt )
   {
-    sqlite3_finalize( m_stmt );
+    // reset, and kept prepared for the next use of the same query
+    m_session.get_statement_cache().release (m_cache_key, m_stmt);
     m_stmt = 0;
   }
 
@@ -315,6 +384,195 @@ rowid statement_imp::last_insert_rowid()
   return m_last_insert_rowid;
 }
 
+// Determines if the uses are vectors, and the number of rows in them.
+bool statement_imp::has_vector_uses (std::size_t& rows)
+{
+  std::size_t vectors = 0;
+
+  for (uses_t::iterator iter = m_uses.begin (); iter != m_uses.end (); ++iter)
+  {
+    vector_use_type_base* const u = dynamic_cast <vector_use_type_base*> (*iter);
+
+    if (u != 0)
+    {
+      // vectors must be the same size
+      if (vectors > 0 && u->size () != rows)
+        Throw (Error().fail (__FILE__, __LINE__, Error::badParameter));
+
+      rows = u->size ();
+      ++vectors;
+    }
+  }
+
+  // can't mix vectors with single values, or with intos
+  if (vectors > 0 && (vectors != m_uses.size () || !m_intos.empty ()))
+    Throw (Error().fail (__FILE__, __LINE__, Error::badParameter));
+
+  return vectors > 0;
+}
+
+// Returns the number of rows to fetch at a time for vector intos, or zero.
+std::size_t statement_imp::get_vector_into_size ()
+{
+  std::size_t rows = 0;
+  std::size_t vectors = 0;
+
+  for (intos_t::iterator iter = m_intos.begin (); iter != m_intos.end (); ++iter)
+  {
+    vector_into_type_base* const i = dynamic_cast <vector_into_type_base*> (*iter);
+
+    if (i != 0)
+    {
+      // the vectors set the number of rows per fetch
+      if (i->size () == 0 || (vectors > 0 && i->size () != rows))
+        Throw (Error().fail (__FILE__, __LINE__, Error::badParameter));
+
+      rows = i->size ();
+      ++vectors;
+    }
+  }
+
+  // can't mix vectors with single values
+  if (vectors > 0 && vectors != m_intos.size ())
+    Throw (Error().fail (__FILE__, __LINE__, Error::badParameter));
+
+  return rows;
+}
+
+// Executes the statement once per row of the vector uses.
+Error statement_imp::do_vector_uses (std::size_t rows)
+{
+  Error error;
+
+  // If a row fails to bind and throws, the
+  // transaction rolls back when it is destroyed.
+  ScopedPointer <transaction> tr (
+    m_session.in_transaction () ? nullptr : new transaction (m_session));
+
+  for (std::size_t row = 0; row < rows && !error; ++row)
+  {
+    for (uses_t::iterator iter = m_uses.begin (); iter != m_uses.end (); ++iter)
+      static_cast <vector_use_type_base*> (*iter)->do_use (row);
+
+    int const result = step ();
+
+    if (result != SQLITE_ROW && result != SQLITE_DONE)
+      error = detail::sqliteError (__FILE__, __LINE__, result);
+
+    sqlite3_reset (m_stmt);
+  }
+
+  m_last_insert_rowid = m_session.last_insert_rowid ();
+
+  if (tr != nullptr)
+  {
+    if (error)
+      tr->rollback ();
+    else
+      error = tr->commit ();
+  }
+
+  m_bReady = false;
+  m_bGotData = false;
+  m_session.set_got_data (m_bGotData);
+
+  return error;
+}
+
+// Fills the vector intos with up to m_fetch_size rows.
+bool statement_imp::fetch_rows (Error& error)
+{
+  for (intos_t::iterator iter = m_intos.begin (); iter != m_intos.end (); ++iter)
+    static_cast <vector_into_type_base*> (*iter)->resize (m_fetch_size);
+
+  std::size_t rows = 0;
+
+  while (m_bReady && rows < m_fetch_size)
+  {
+    int const result = step ();
+
+    if (result == SQLITE_ROW)
+    {
+      for (intos_t::iterator iter = m_intos.begin (); iter != m_intos.end (); ++iter)
+        static_cast <vector_into_type_base*> (*iter)->do_into (rows);
+
+      ++rows;
+    }
+    else
+    {
+      if (result != SQLITE_DONE)
+        error = detail::sqliteError (__FILE__, __LINE__, result);
+
+      m_bReady = false;
+    }
+  }
+
+  for (intos_t::iterator iter = m_intos.begin (); iter != m_intos.end (); ++iter)
+    static_cast <vector_into_type_base*> (*iter)->resize (rows);
+
+  m_bGotData = rows > 0;
+  m_session.set_got_data (m_bGotData);
+
+  return m_bGotData;
+}
+
+// Steps the statement, counting for the profiler.
+int statement_imp::step ()
+{
+  int const result = sqlite3_step (m_stmt);
+
+  if (m_bProfiling)
+  {
+    ++m_steps;
+
+    if (result == SQLITE_ROW)
+      ++m_rows;
+  }
+
+  return result;
+}
+
+void statement_imp::begin_run ()
+{
+  m_bProfiling = m_stmt != 0 && m_session.get_profiler () != nullptr;
+
+  if (m_bProfiling)
+  {
+    m_executeTicks = 0;
+    m_steps = 0;
+    m_rows = 0;
+
+    // cached statements keep their counters between uses
+    sqlite3_stmt_status (m_stmt, SQLITE_STMTSTATUS_FULLSCAN_STEP, 1);
+    sqlite3_stmt_status (m_stmt, SQLITE_STMTSTATUS_SORT, 1);
+    sqlite3_stmt_status (m_stmt, SQLITE_STMTSTATUS_AUTOINDEX, 1);
+  }
+}
+
+// Reports the run to the profiler.
+void statement_imp::end_run ()
+{
+  if (m_bProfiling)
+  {
+    m_bProfiling = false;
+
+    statement_profiler* const profiler = m_session.get_profiler ();
+
+    if (profiler != nullptr)
+    {
+      statement_profiler::run r;
+      r.execute_seconds = Time::highResolutionTicksToSeconds (m_executeTicks);
+      r.steps = m_steps;
+      r.rows = m_rows;
+      r.fullscan_steps = sqlite3_stmt_status (m_stmt, SQLITE_STMTSTATUS_FULLSCAN_STEP, 0);
+      r.sorts = sqlite3_stmt_status (m_stmt, SQLITE_STMTSTATUS_SORT, 0);
+      r.autoindexes = sqlite3_stmt_status (m_stmt, SQLITE_STMTSTATUS_AUTOINDEX, 0);
+
+      profiler->add_run (m_session, m_stmt, r);
+    }
+  }
+}
+
 }
 
 }
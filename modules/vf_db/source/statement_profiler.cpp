@@ -0,0 +1,224 @@
+/*============================================================================*/
+/*
+  VFLib: https://github.com/vinniefalco/VFLib
+
+  Copyright (C) 2008 by Vinnie Falco <vinnie.falco@gmail.com>
+
+  This library contains portions of other open source products covered by
+  separate licenses. Please see the corresponding source files for specific
+  terms.
+  
+  VFLib is provided under the terms of The MIT License (MIT):
+
+  Permission is hereby granted, free of charge, to any person obtaining a copy
+  of this software and associated documentation files (the "Software"), to deal
+  in the Software without restriction, including without limitation the rights
+  to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+  copies of the Software, and to permit persons to whom the Software is
+  furnished to do so, subject to the following conditions:
+
+  The above copyright notice and this permission notice shall be included in
+  all copies or substantial portions of the Software.
+
+  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+  FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+  IN THE SOFTWARE.
+*/
+/*============================================================================*/
+
+namespace db {
+
+statement_profiler::report::report ()
+  : prepares (0)
+  , prepare_seconds (0)
+  , executions (0)
+  , execute_seconds (0)
+  , max_execute_seconds (0)
+  , steps (0)
+  , rows (0)
+  , fullscan_steps (0)
+  , sorts (0)
+  , autoindexes (0)
+  , slow (0)
+{
+}
+
+statement_profiler::statement_profiler ()
+  : m_slowThreshold (0.1)
+{
+}
+
+statement_profiler::~statement_profiler ()
+{
+}
+
+void statement_profiler::set_slow_threshold (double seconds)
+{
+  CriticalSection::ScopedLockType lock (m_mutex);
+
+  m_slowThreshold = seconds;
+}
+
+void statement_profiler::get_report (std::vector <report>& result) const
+{
+  result.clear ();
+
+  {
+    CriticalSection::ScopedLockType lock (m_mutex);
+
+    result.reserve (m_entries.size ());
+
+    for (entries_t::const_iterator iter = m_entries.begin (); iter != m_entries.end (); ++iter)
+      result.push_back (iter->second);
+  }
+
+  std::sort (result.begin (), result.end (), takes_longer);
+}
+
+String statement_profiler::to_string () const
+{
+  std::vector <report> result;
+
+  get_report (result);
+
+  String s;
+
+  for (std::size_t i = 0; i < result.size (); ++i)
+  {
+    report const& r = result [i];
+
+    s << String (r.executions) << " runs, "
+      << String (r.execute_seconds * 1000, 3) << " ms ("
+      << String (r.max_execute_seconds * 1000, 3) << " max), "
+      << String (r.prepares) << " prepares ("
+      << String (r.prepare_seconds * 1000, 3) << " ms), "
+      << String (r.steps) << " steps, "
+      << String (r.rows) << " rows, "
+      << String (r.fullscan_steps) << " scan steps, "
+      << String (r.sorts) << " sorts, "
+      << String (r.autoindexes) << " autoindexes, "
+      << String (r.slow) << " slow: "
+      << String (r.query.c_str ()) << "\n";
+  }
+
+  return s;
+}
+
+void statement_profiler::reset ()
+{
+  CriticalSection::ScopedLockType lock (m_mutex);
+
+  m_entries.clear ();
+}
+
+void statement_profiler::add_prepare (std::string const& query, double seconds)
+{
+  CriticalSection::ScopedLockType lock (m_mutex);
+
+  report& entry = get_entry (query);
+
+  ++entry.prepares;
+  entry.prepare_seconds += seconds;
+}
+
+void statement_profiler::add_run (session& s, sqlite3_stmt* stmt, run const& r)
+{
+  bool slow;
+
+  {
+    CriticalSection::ScopedLockType lock (m_mutex);
+
+    report& entry = get_entry (sqlite3_sql (stmt));
+
+    ++entry.executions;
+    entry.execute_seconds += r.execute_seconds;
+    entry.max_execute_seconds = jmax (entry.max_execute_seconds, r.execute_seconds);
+    entry.steps += r.steps;
+    entry.rows += r.rows;
+    entry.fullscan_steps += r.fullscan_steps;
+    entry.sorts += r.sorts;
+    entry.autoindexes += r.autoindexes;
+
+    slow = m_slowThreshold > 0 && r.execute_seconds >= m_slowThreshold;
+
+    if (slow)
+      ++entry.slow;
+  }
+
+  // outside the lock, since this runs another statement
+  if (slow)
+  {
+    std::string const query = sqlite3_sql (stmt);
+
+    on_slow_query (query, r.execute_seconds, explain (s, query));
+  }
+}
+
+std::string statement_profiler::explain (session& s, std::string const& query)
+{
+  std::string plan;
+
+  // prepared directly, so that it isn't profiled or cached
+  sqlite3_stmt* stmt = 0;
+
+  int result = sqlite3_prepare_v2 (s.get_connection (),
+    ("EXPLAIN QUERY PLAN " + query).c_str (), -1, &stmt, 0);
+
+  if (result == SQLITE_OK)
+  {
+    // the detail is the last column in every version
+    int const detailColumn = sqlite3_column_count (stmt) - 1;
+
+    while (sqlite3_step (stmt) == SQLITE_ROW)
+    {
+      char const* detail = reinterpret_cast <char const*> (
+        sqlite3_column_text (stmt, detailColumn));
+
+      if (detail != 0)
+      {
+        plan += detail;
+        plan += '\n';
+      }
+    }
+  }
+
+  sqlite3_finalize (stmt);
+
+  return plan;
+}
+
+void statement_profiler::on_slow_query (std::string const& query,
+                                        double seconds,
+                                        std::string const& plan)
+{
+  Logger::outputDebugString ("[SLOW QUERY] " + String (seconds * 1000, 3) + " ms: " +
+    String (query.c_str ()) + "\n" + String (plan.c_str ()));
+}
+
+statement_profiler::report& statement_profiler::get_entry (std::string const& query)
+{
+  std::string const key = statement_cache::normalize (query);
+
+  entries_t::iterator iter = m_entries.find (key);
+
+  if (iter == m_entries.end ())
+  {
+    report r;
+    r.query = key;
+
+    iter = m_entries.insert (std::make_pair (key, r)).first;
+  }
+
+  return iter->second;
+}
+
+bool statement_profiler::takes_longer (report const& lhs, report const& rhs)
+{
+  return lhs.execute_seconds > rhs.execute_seconds;
+}
+
+}
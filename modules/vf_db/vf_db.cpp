@@ -42,6 +42,10 @@
 
 #include "../vf_sqlite/vf_sqlite.h"
 
+#if VF_USE_BZIP2
+#include "../vf_bzip2/vf_bzip2.h"
+#endif
+
 #if JUCE_MSVC
 #pragma warning (push)
 #pragma warning (disable: 4100) // unreferenced formal parmaeter
@@ -57,7 +61,16 @@ namespace vf
 
 namespace vf
 {
+#include "source/async_session.cpp"
 #include "source/blob.cpp"
+#include "source/blob_stream.cpp"
+#include "source/bulk_benchmark.cpp"
+#include "source/bulk_loader.cpp"
+#if VF_USE_BZIP2
+#include "source/bzip2_stream.cpp"
+#endif
+#include "source/column_access.cpp"
+#include "source/cursor.cpp"
 #include "source/error_codes.cpp"
 #include "source/into_type.cpp"
 #include "source/once_temp_type.cpp"
@@ -65,10 +78,15 @@ namespace vf
 #include "source/ref_counted_prepare_info.cpp"
 #include "source/ref_counted_statement.cpp"
 #include "source/session.cpp"
+#include "source/session_pool.cpp"
 #include "source/statement.cpp"
+#include "source/statement_cache.cpp"
 #include "source/statement_imp.cpp"
+#include "source/statement_profiler.cpp"
 #include "source/transaction.cpp"
 #include "source/use_type.cpp"
+#include "source/vector_into_type.cpp"
+#include "source/vector_use_type.cpp"
 }
 
 #if JUCE_MSVC
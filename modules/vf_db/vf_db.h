@@ -86,12 +86,15 @@
   This collection of classes let's you access embedded SQLite databases
   using C++ syntax that is very similar to regular SQL.
 
-  This module requires the @ref vf_sqlite external module.
+  This module requires the @ref vf_sqlite external module, and the
+  @ref vf_concurrent module for db::async_session. When VF_USE_BZIP2 is
+  set, the @ref vf_bzip2 external module is used for compressed blobs.
 
   @defgroup vf_db vf_db
 */
 
 #include "../vf_core/vf_core.h"
+#include "../vf_concurrent/vf_concurrent.h"
 
 // forward declares
 struct sqlite3;
@@ -122,6 +125,10 @@ namespace vf
 #include "detail/type_ptr.h"
 
 #include "api/blob.h"
+#include "api/blob_stream.h"
+#if VF_USE_BZIP2
+#include "api/bzip2_stream.h"
+#endif
 #include "api/type_conversion_traits.h"
 
 #include "detail/exchange_traits.h"
@@ -131,6 +138,9 @@ namespace vf
 
 #include "api/statement.h"
 #include "detail/type_conversion.h"
+#include "detail/column_access.h"
+#include "detail/vector_into_type.h"
+#include "detail/vector_use_type.h"
 
 #include "detail/ref_counted_statement.h"
 
@@ -142,7 +152,16 @@ namespace vf
 
 #include "detail/once_temp_type.h"
 
+#include "api/statement_cache.h"
+#include "api/statement_profiler.h"
 #include "api/session.h"
+#include "api/row_fields.h"
+#include "api/cursor.h"
+#include "api/session_pool.h"
+#include "api/async_session.h"
+#include "api/bulk_loader.h"
+
+#include "api/bulk_benchmark.h"
 
 }
 
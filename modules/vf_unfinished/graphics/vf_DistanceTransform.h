@@ -196,30 +196,42 @@ struct DistanceTransform
     template <class Functor, class BoolImage, class Metric>
     static void calculate (Functor f, BoolImage test, int const m, int const n, Metric metric)
     {
-      std::vector <int> g (m * n);
+      Map2D <int> g (m, n);
 
       int const inf = m + n;
 
       // phase 1
+      //
+      // Every column is scanned down and then up. The scans advance a row
+      // at a time across all of the columns, so memory is accessed in order.
       {
-        for (int x = 0; x < m; ++x)
         {
-          g [x] = test (x, 0) ? 0 : inf;
+          int* const row = g.getRow (0);
 
-          // scan 1
-          for (int y = 1; y < n; ++y)
-          {
-            int const ym = y*m;
-            g [x+ym] = test (x, y) ? 0 : 1 + g [x+ym-m];
-          }
+          for (int x = 0; x < m; ++x)
+            row [x] = test (x, 0) ? 0 : inf;
+        }
 
-          // scan 2
-          for (int y = n-2; y >=0; --y)
-          {
-            int const ym = y*m;
+        // scan 1
+        for (int y = 1; y < n; ++y)
+        {
+          int const* const above = g.getRow (y-1);
+          int* const row = g.getRow (y);
+
+          for (int x = 0; x < m; ++x)
+            row [x] = test (x, y) ? 0 : 1 + above [x];
+        }
+
+        // scan 2
+        for (int y = n-2; y >=0; --y)
+        {
+          int const* const below = g.getRow (y+1);
+          int* const row = g.getRow (y);
 
-            if (g [x+ym+m] < g [x+ym])
-              g [x+ym] = 1 + g[x+ym+m];
+          for (int x = 0; x < m; ++x)
+          {
+            if (below [x] < row [x])
+              row [x] = 1 + below [x];
           }
         }
       }
@@ -235,12 +247,12 @@ struct DistanceTransform
           s [0] = 0;
           t [0] = 0;
 
-          int const ym = y*m;
+          int const* const gy = g.getRow (y);
 
           // scan 3
           for (int u = 1; u < m; ++u)
           {
-            while (q >= 0 && metric.f (t[q]-s[q], g[s[q]+ym]) > metric.f (t[q]-u, g[u+ym]))
+            while (q >= 0 && metric.f (t[q]-s[q], gy[s[q]]) > metric.f (t[q]-u, gy[u]))
               q--;
 
             if (q < 0)
@@ -250,7 +262,7 @@ struct DistanceTransform
             }
             else
             {
-              int const w = 1 + metric.sep (s[q], u, g[s[q]+ym], g[u+ym], inf);
+              int const w = 1 + metric.sep (s[q], u, gy[s[q]], gy[u], inf);
 
               if (w < m)
               {
@@ -264,7 +276,7 @@ struct DistanceTransform
           // scan 4
           for (int u = m-1; u >= 0; --u)
           {
-            int const d = metric.f (u-s[q], g[s[q]+ym]);
+            int const d = metric.f (u-s[q], gy[s[q]]);
             f (u, y, d);
             if (u == t[q])
               --q;
@@ -288,49 +300,12 @@ struct DistanceTransform
     {
       int64 const scale = 256;
 
-      std::vector <int64> g (m * n);
+      Map2D <int64> g (m, n);
 
       int64 const inf = scale * (m + n);
 
       // phase 1
-      {
-        for (int x = 0; x < m; ++x)
-        {
-          int a;
-
-          a = mask (x, 0);
-
-          if (a == 0)
-            g [x] = 0;
-          else if (a == 255)
-            g [x] = inf;
-          else
-            g [x] = a;
-
-          // scan 1
-          for (int y = 1; y < n; ++y)
-          {
-            int const idx = x+y*m;
-
-            a = mask (x, y);
-            if (a == 0)
-              g [idx] = 0;
-            else if (a == 255)
-              g [idx] = scale + g [idx-m];
-            else
-              g [idx] = a;
-          }
-
-          // scan 2
-          for (int y = n-2; y >=0; --y)
-          {
-            int const idx = x+y*m;
-            int64 const d = scale + g [idx+m];
-            if (g [idx] > d)
-              g [idx] = d;
-          }
-        }
-      }
+      Phase1 <Mask> (m, n, g, mask) (0, m);
 
       // phase 2
       {
@@ -343,13 +318,13 @@ struct DistanceTransform
           s [0] = 0;
           t [0] = 0;
 
-          int const ym = y*m;
+          int64 const* const gy = g.getRow (y);
 
           // scan 3
           for (int u = 1; u < m; ++u)
           {
-            while (q >= 0 && metric.f (floor_fixed8(t[q]) - scale*s[q], g[s[q]+ym]) >
-                             metric.f (floor_fixed8(t[q]) - scale*u, g[u+ym]))
+            while (q >= 0 && metric.f (floor_fixed8(t[q]) - scale*s[q], gy[s[q]]) >
+                             metric.f (floor_fixed8(t[q]) - scale*u, gy[u]))
             {
               q--;
             }
@@ -361,7 +336,7 @@ struct DistanceTransform
             }
             else
             {
-              int64 const w = scale + metric.sep (scale*s[q], scale*u, g[s[q]+ym], g[u+ym], inf);
+              int64 const w = scale + metric.sep (scale*s[q], scale*u, gy[s[q]], gy[u], inf);
 
               if (w < scale * m)
               {
@@ -375,7 +350,7 @@ struct DistanceTransform
           // scan 4
           for (int u = m-1; u >= 0; --u)
           {
-            int64 const d = metric.f (scale*(u-s[q]), g[s[q]+ym]);
+            int64 const d = metric.f (scale*(u-s[q]), gy[s[q]]);
             f (u, y, d);
             if (u == t[q]/scale)
               --q;
@@ -386,57 +361,75 @@ struct DistanceTransform
 
     //--------------------------------------------------------------------------
     
+    // Computes phase 1 for a range of columns. The columns are scanned down
+    // and then up a row at a time, so that memory is accessed in order.
+    //
     template <class Mask>
     struct Phase1
     {
-      Phase1 (int m_, int n_, int64* g_, Mask mask_)
+      Phase1 (int m_, int n_, Map2D <int64> const& g_, Mask mask_)
         : m (m_), n (n_), g (g_), mask (mask_)
       {
       }
 
-      inline void operator() (int x) noexcept
+      void operator() (int x0, int x1) noexcept
       {
         int64 const inf = 256 * (m + n);
-  
-        int a;
 
-        a = mask (x, 0);
+        {
+          int64* const row = g.getRow (0);
 
-        if (a == 0)
-          g [x] = 0;
-        else if (a == 255)
-          g [x] = inf;
-        else
-          g [x] = a;
+          for (int x = x0; x < x1; ++x)
+          {
+            int const a = mask (x, 0);
+
+            if (a == 0)
+              row [x] = 0;
+            else if (a == 255)
+              row [x] = inf;
+            else
+              row [x] = a;
+          }
+        }
 
         // scan 1
         for (int y = 1; y < n; ++y)
         {
-          int const idx = x+y*m;
+          int64 const* const above = g.getRow (y-1);
+          int64* const row = g.getRow (y);
 
-          a = mask (x, y);
-          if (a == 0)
-            g [idx] = 0;
-          else if (a == 255)
-            g [idx] = 256 + g [idx-m];
-          else
-            g [idx] = a;
+          for (int x = x0; x < x1; ++x)
+          {
+            int const a = mask (x, y);
+
+            if (a == 0)
+              row [x] = 0;
+            else if (a == 255)
+              row [x] = 256 + above [x];
+            else
+              row [x] = a;
+          }
         }
 
         // scan 2
         for (int y = n-2; y >=0; --y)
         {
-          int const idx = x+y*m;
-          int64 const d = 256 + g [idx+m];
-          if (g [idx] > d)
-            g [idx] = d;
+          int64 const* const below = g.getRow (y+1);
+          int64* const row = g.getRow (y);
+
+          for (int x = x0; x < x1; ++x)
+          {
+            int64 const d = 256 + below [x];
+            if (row [x] > d)
+              row [x] = d;
+          }
         }
       }
     
     private:
       int m;
       int n;
-      int64* g;
+      Map2D <int64> g;
       Mask mask;
     };
 
@@ -446,55 +439,19 @@ struct DistanceTransform
     {
       int64 const scale = 256;
 
-      std::vector <int64> g (m * n);
+      Map2D <int64> g (m, n);
 
       int64 const inf = scale * (m + n);
 
       // phase 1
+      //
+      // Strips of columns are independent, and may be done in parallel.
       {
-        Phase1 <Mask> p (m, n, &g[0], mask);
-        for (int x = 0; x < m; ++x)
-          p (x);
-        //loop.operator() <Phase1 <Mask> > (m, m, n, &g[0], mask);
-
-#if 0
-        for (int x = 0; x < m; ++x)
-        {
-          int a;
-
-          a = mask (x, 0);
-
-          if (a == 0)
-            g [x] = 0;
-          else if (a == 255)
-            g [x] = inf;
-          else
-            g [x] = a;
-
-          // scan 1
-          for (int y = 1; y < n; ++y)
-          {
-            int const idx = x+y*m;
-
-            a = mask (x, y);
-            if (a == 0)
-              g [idx] = 0;
-            else if (a == 255)
-              g [idx] = scale + g [idx-m];
-            else
-              g [idx] = a;
-          }
+        int const columnsPerStrip = 64;
 
-          // scan 2
-          for (int y = n-2; y >=0; --y)
-          {
-            int const idx = x+y*m;
-            int64 const d = scale + g [idx+m];
-            if (g [idx] > d)
-              g [idx] = d;
-          }
-        }
-#endif
+        Phase1 <Mask> p (m, n, g, mask);
+        for (int x = 0; x < m; x += columnsPerStrip)
+          p (x, jmin (x + columnsPerStrip, m));
       }
 
       // phase 2
@@ -508,13 +465,13 @@ struct DistanceTransform
           s [0] = 0;
           t [0] = 0;
 
-          int const ym = y*m;
+          int64 const* const gy = g.getRow (y);
 
           // scan 3
           for (int u = 1; u < m; ++u)
           {
-            while (q >= 0 && metric.f (floor_fixed8(t[q]) - scale*s[q], g[s[q]+ym]) >
-                             metric.f (floor_fixed8(t[q]) - scale*u, g[u+ym]))
+            while (q >= 0 && metric.f (floor_fixed8(t[q]) - scale*s[q], gy[s[q]]) >
+                             metric.f (floor_fixed8(t[q]) - scale*u, gy[u]))
             {
               q--;
             }
@@ -526,7 +483,7 @@ struct DistanceTransform
             }
             else
             {
-              int64 const w = scale + metric.sep (scale*s[q], scale*u, g[s[q]+ym], g[u+ym], inf);
+              int64 const w = scale + metric.sep (scale*s[q], scale*u, gy[s[q]], gy[u], inf);
 
               if (w < scale * m)
               {
@@ -540,7 +497,7 @@ struct DistanceTransform
           // scan 4
           for (int u = m-1; u >= 0; --u)
           {
-            int64 const d = metric.f (scale*(u-s[q]), g[s[q]+ym]);
+            int64 const d = metric.f (scale*(u-s[q]), gy[s[q]]);
             f (u, y, d);
             if (u == t[q]/scale)
               --q;
@@ -576,14 +533,8 @@ struct DistanceTransform
       Map2D <T> d (X, Y);
       Map2D <P> p (X, Y);
 
-      for (int y = 0; y < Y; ++y)
-      {
-        for (int x = 0; x < X; ++x)
-        {
-          d (x, y) = inf;
-          p (x, y) = P (0, 0);
-        }
-      }
+      d.fill (inf);
+      p.fill (P (0, 0));
 
       for (int y = 1; y < Y-1; ++y)
       {
@@ -696,27 +647,45 @@ struct DistanceTransform
       Map2D <int> I (n, m);
 
       // stage 1
-      for (int c = 0; c < n; ++c)
+      //
+      // Find the nearest point in each column by scanning down and then up,
+      // a row at a time across all of the columns, so that memory is
+      // accessed in order. Each scan remembers the last point seen in every
+      // column.
       {
-        int mid = -1;
-        int const cc = c*c;
+        std::vector <int> last (n);
+
+        std::fill (last.begin (), last.end (), -1);
 
         for (int r = 0; r < m; ++r)
         {
-          if (test (c,r))
+          int* const row = I.getRow (r);
+
+          for (int c = 0; c < n; ++c)
           {
-            if (mid > -1)
-              mid = (r + mid) /2;
-            for (int r_ = mid + 1; r_ <= r; ++r_)
-              I (c, r_) = (r_-r)*(r_-r) + cc;
-            mid = r;
+            if (test (c, r))
+              last [c] = r;
+
+            if (last [c] == -1)
+              row [c] = inf;
+            else
+              row [c] = (r-last[c])*(r-last[c]) + c*c;
           }
-          else
+        }
+
+        std::fill (last.begin (), last.end (), -1);
+
+        for (int r = m-1; r >= 0; --r)
+        {
+          int* const row = I.getRow (r);
+
+          for (int c = 0; c < n; ++c)
           {
-            if (mid == -1)
-              I (c, r) = inf;
-            else
-              I (c, r) = (r-mid)*(r-mid) + cc;
+            if (test (c, r))
+              last [c] = r;
+
+            if (last [c] != -1)
+              row [c] = jmin (row [c], (last[c]-r)*(last[c]-r) + c*c);
           }
         }
       }
@@ -803,29 +772,46 @@ struct DistanceTransform
       Map2D <int64> I (n, m);
 
       // stage 1
-      for (int c = 0; c < n; ++c)
+      //
+      // As in calculate(), scanning down and then up a row at a time.
       {
-        int mid = -1;
-        int64 const cc = 65536L*c*c;
+        std::vector <int> last (n);
+
+        std::fill (last.begin (), last.end (), -1);
 
         for (int r = 0; r < m; ++r)
         {
-          int const a = map (c, r);
+          int64* const row = I.getRow (r);
 
-          if (a == 0)
+          for (int c = 0; c < n; ++c)
           {
-            if (mid > -1)
-              mid = (r + mid) /2;
-            for (int r_ = mid + 1; r_ <= r; ++r_)
-              I (c, r_) = 65536L*(r_-r)*(r_-r) + cc;
-            mid = r;
+            if (map (c, r) == 0)
+              last [c] = r;
+
+            int64 const dr = r - last [c];
+
+            if (last [c] == -1)
+              row [c] = inf;
+            else
+              row [c] = 65536 * (dr*dr + int64 (c)*c);
           }
-          else
+        }
+
+        std::fill (last.begin (), last.end (), -1);
+
+        for (int r = m-1; r >= 0; --r)
+        {
+          int64* const row = I.getRow (r);
+
+          for (int c = 0; c < n; ++c)
           {
-            if (mid == -1)
-              I (c, r) = inf;
-            else
-              I (c, r) = 65536L*(r-mid)*(r-mid) + cc;
+            if (map (c, r) == 0)
+              last [c] = r;
+
+            int64 const dr = last [c] - r;
+
+            if (last [c] != -1)
+              row [c] = jmin (row [c], 65536 * (dr*dr + int64 (c)*c));
           }
         }
       }